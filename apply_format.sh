@@ -4,7 +4,7 @@ GREEN='\033[0;32m'
 BLUE='\033[0;34m'
 YELLOW='\033[1;33m'
 NC='\033[0m'
-DIRS=("src" "include" "test")
+DIRS=("src" "include" "test" "bench")
 
 if [ ! -f ".clang-format" ]; then
     echo "Error: .clang-format file not found in current directory"
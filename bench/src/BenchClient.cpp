@@ -0,0 +1,226 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "BenchClient.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <InterProcessCourier/SyncClient.hpp>
+
+#include "CourierBench.pb.h"
+
+namespace ipcourier::bench {
+using Clock = std::chrono::steady_clock;
+
+// The server process is started together with the clients, connecting is retried until it listens
+constexpr auto k_connect_timeout = std::chrono::seconds(5);
+constexpr auto k_connect_retry_interval = std::chrono::milliseconds(10);
+
+void ClientReport::merge(const ClientReport& other) {
+    latency.merge(other.latency);
+    requests += other.requests;
+    errors += other.errors;
+    late_sends += other.late_sends;
+}
+
+std::string ClientReport::encode() const {
+    const std::uint64_t counters[] = {requests, errors, late_sends};
+
+    std::string encoded(sizeof(counters), '\0');
+    std::memcpy(encoded.data(), counters, sizeof(counters));
+    return encoded + latency.encode();
+}
+
+std::optional<ClientReport> ClientReport::decode(const std::string_view encoded) {
+    std::uint64_t counters[3] = {};
+    if (encoded.size() < sizeof(counters)) {
+        return std::nullopt;
+    }
+    std::memcpy(counters, encoded.data(), sizeof(counters));
+
+    auto latency = HdrHistogram::decode(encoded.substr(sizeof(counters)));
+    if (!latency.has_value()) {
+        return std::nullopt;
+    }
+
+    return ClientReport{.latency = std::move(latency.value()),
+                        .requests = counters[0],
+                        .errors = counters[1],
+                        .late_sends = counters[2]};
+}
+
+namespace {
+struct StreamSchedule {
+    Clock::time_point start_at;
+    Clock::time_point measure_from;
+    Clock::time_point stop_at;
+
+    // Open loop only, time between two sends of the same stream
+    std::optional<Clock::duration> interval = std::nullopt;
+};
+
+// Requests are built once per payload size, so the loop only measures the courier
+struct PreparedRequests {
+    std::vector<bench_proto::EchoRequest> echo;
+    std::vector<bench_proto::ComputeRequest> compute;
+};
+
+PreparedRequests prepareRequests(const BenchOptions& options) {
+    PreparedRequests prepared;
+    for (const auto size : options.payload_sizes) {
+        const std::string payload(size, 'p');
+
+        prepared.echo.emplace_back().set_payload(payload);
+
+        auto& compute = prepared.compute.emplace_back();
+        compute.set_payload(payload);
+        compute.set_rounds(options.compute_rounds);
+    }
+
+    return prepared;
+}
+
+bool connectWithRetry(SyncClient& client) {
+    const auto give_up_at = Clock::now() + k_connect_timeout;
+    while (!client.connect().has_value()) {
+        if (Clock::now() >= give_up_at) {
+            return false;
+        }
+        std::this_thread::sleep_for(k_connect_retry_interval);
+    }
+
+    return true;
+}
+
+bool sendRequest(SyncClient& client,
+                 const RequestKind kind,
+                 const PreparedRequests& prepared,
+                 const std::size_t size_index) {
+    using bench_proto::ComputeRequest;
+    using bench_proto::ComputeResponse;
+    using bench_proto::EchoRequest;
+    using bench_proto::EchoResponse;
+
+    if (kind == RequestKind::Compute) {
+        return client.sendRequest<ComputeRequest, ComputeResponse>(prepared.compute[size_index]).has_value();
+    }
+
+    return client.sendRequest<EchoRequest, EchoResponse>(prepared.echo[size_index]).has_value();
+}
+
+ClientReport runStream(const BenchOptions& options,
+                       const PreparedRequests& prepared,
+                       const StreamSchedule& schedule,
+                       const std::uint64_t seed) {
+    ClientReport report;
+
+    SyncClient client(options.socket_path,
+                      SyncClientOptions{.transport = options.transport, .busy_poll_budget = options.busy_poll_budget});
+    if (!connectWithRetry(client)) {
+        ++report.errors;
+        return report;
+    }
+
+    std::mt19937_64 random(seed);
+    std::vector<unsigned> weights;
+    for (const auto& entry : options.mix) {
+        weights.push_back(entry.weight);
+    }
+    std::discrete_distribution<std::size_t> pick_kind(weights.begin(), weights.end());
+    std::uniform_int_distribution<std::size_t> pick_size(0, options.payload_sizes.size() - 1);
+
+    std::this_thread::sleep_until(schedule.start_at);
+
+    auto next_send = schedule.start_at;
+    while (true) {
+        auto now = Clock::now();
+        if (now >= schedule.stop_at) {
+            break;
+        }
+
+        // Open loop latency counts from the scheduled send time, so a stalled server is not hidden by
+        // requests that were sent late (coordinated omission)
+        auto intended = now;
+        if (schedule.interval.has_value()) {
+            intended = next_send;
+            next_send += schedule.interval.value();
+            if (intended > now) {
+                std::this_thread::sleep_until(intended);
+            } else if (now - intended > schedule.interval.value() && intended >= schedule.measure_from) {
+                ++report.late_sends;
+            }
+        }
+
+        const auto kind = options.mix[pick_kind(random)].kind;
+        const auto succeeded = sendRequest(client, kind, prepared, pick_size(random));
+        now = Clock::now();
+
+        if (intended < schedule.measure_from) {
+            continue;
+        }
+
+        if (!succeeded) {
+            ++report.errors;
+            continue;
+        }
+
+        ++report.requests;
+        report.latency.record(
+            static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - intended).count()));
+    }
+
+    return report;
+}
+}  // namespace
+
+ClientReport runClientProcess(const BenchOptions& options,
+                              const std::size_t process_index,
+                              const Clock::time_point start_at) {
+    StreamSchedule schedule{.start_at = start_at,
+                            .measure_from = start_at + options.warmup,
+                            .stop_at = start_at + options.warmup + options.duration};
+    if (options.mode == LoadMode::OpenLoop) {
+        const auto streams = static_cast<double>(options.processes * options.streams_per_process);
+        schedule.interval =
+            std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(streams / options.rate));
+    }
+
+    const auto prepared = prepareRequests(options);
+
+    std::vector<ClientReport> stream_reports(options.streams_per_process);
+    std::vector<std::thread> streams;
+    for (std::size_t i = 0; i < options.streams_per_process; ++i) {
+        streams.emplace_back([&, i] {
+            const auto seed = process_index * options.streams_per_process + i;
+            stream_reports[i] = runStream(options, prepared, schedule, seed);
+        });
+    }
+
+    ClientReport report;
+    for (std::size_t i = 0; i < streams.size(); ++i) {
+        streams[i].join();
+        report.merge(stream_reports[i]);
+    }
+
+    return report;
+}
+}  // namespace ipcourier::bench
@@ -0,0 +1,54 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef INTER_PROCESS_COURIER_BENCH_BENCHCLIENT_HPP
+#define INTER_PROCESS_COURIER_BENCH_BENCHCLIENT_HPP
+
+#include "BenchOptions.hpp"
+#include "HdrHistogram.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace ipcourier::bench {
+// Outcome of the measured phase of one or more streams, merged across all client processes
+struct ClientReport {
+    HdrHistogram latency;
+    std::uint64_t requests = 0;
+    std::uint64_t errors = 0;
+
+    // Open loop only, sends that were already late by more than the interval when they were made
+    std::uint64_t late_sends = 0;
+
+    void merge(const ClientReport& other);
+
+    std::string encode() const;
+
+    static std::optional<ClientReport> decode(std::string_view encoded);
+};
+
+// Runs the streams of one client process, the warmup starts at start_at in all processes alike
+ClientReport runClientProcess(const BenchOptions& options,
+                              std::size_t process_index,
+                              std::chrono::steady_clock::time_point start_at);
+}  // namespace ipcourier::bench
+
+#endif  // INTER_PROCESS_COURIER_BENCH_BENCHCLIENT_HPP
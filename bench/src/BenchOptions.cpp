@@ -0,0 +1,252 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "BenchOptions.hpp"
+
+#include <charconv>
+#include <format>
+#include <string_view>
+
+#include <unistd.h>
+
+namespace ipcourier::bench {
+template <typename Number>
+static std::expected<Number, std::string> parseNumber(const std::string_view name, const std::string_view text) {
+    Number number{};
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), number);
+    if (error != std::errc() || end != text.data() + text.size()) {
+        return std::unexpected(std::format("--{}: '{}' is not a valid number", name, text));
+    }
+
+    return number;
+}
+
+static std::vector<std::string_view> splitList(const std::string_view text) {
+    std::vector<std::string_view> items;
+    std::size_t begin = 0;
+    while (begin <= text.size()) {
+        const auto end = std::min(text.find(',', begin), text.size());
+        items.push_back(text.substr(begin, end - begin));
+        begin = end + 1;
+    }
+
+    return items;
+}
+
+static std::expected<std::vector<RequestMixEntry>, std::string> parseMix(const std::string_view text) {
+    std::vector<RequestMixEntry> mix;
+    for (const auto item : splitList(text)) {
+        const auto separator = item.find('=');
+        const auto name = item.substr(0, separator);
+        const auto weight_text =
+            separator == std::string_view::npos ? std::string_view("1") : item.substr(separator + 1);
+
+        const auto weight = parseNumber<unsigned>("mix", weight_text);
+        if (!weight.has_value()) {
+            return std::unexpected(weight.error());
+        }
+
+        if (name == "echo") {
+            mix.push_back({RequestKind::Echo, weight.value()});
+        } else if (name == "compute") {
+            mix.push_back({RequestKind::Compute, weight.value()});
+        } else {
+            return std::unexpected(std::format("--mix: unknown request kind '{}'", name));
+        }
+    }
+
+    return mix;
+}
+
+std::string getBenchUsage() {
+    return "Usage: courier-bench [options]\n"
+           "\n"
+           "Starts a SyncServer with echo and compute handlers in its own process, forks the client processes and\n"
+           "reports throughput and latency percentiles.\n"
+           "\n"
+           "Load:\n"
+           "  --processes N           Client processes (1)\n"
+           "  --streams M             Connections per client process, each driven by its own thread (1)\n"
+           "  --mode closed|open      Closed loop sends back to back, open loop on a fixed schedule (closed)\n"
+           "  --rate R                Total requests per second in open loop\n"
+           "  --duration S            Measured seconds (5)\n"
+           "  --warmup S              Seconds before measuring starts (1)\n"
+           "  --mix K=W,...           Weighted request kinds, echo and compute (echo=1)\n"
+           "  --payload-sizes B,...   Payload sizes in bytes, picked uniformly per request (64)\n"
+           "  --compute-rounds N      Hash rounds over the payload per compute request (1000)\n"
+           "\n"
+           "Server and client:\n"
+           "  --socket PATH           Socket to serve on (/tmp/courier-bench-<pid>.sock)\n"
+           "  --backend asio|io_uring Server backend (asio)\n"
+           "  --transport stream|seqpacket\n"
+           "  --handler-threads N     Server handler threads (0)\n"
+           "  --busy-poll-us U        Busy poll budget of server and clients in microseconds (0)\n"
+           "\n"
+           "Output:\n"
+           "  --json PATH             Also write the report as JSON, - for stdout\n"
+           "  --help\n";
+}
+
+std::expected<std::optional<BenchOptions>, std::string> parseBenchOptions(
+    const std::span<const char* const> arguments) {
+    BenchOptions options;
+    options.socket_path = std::format("/tmp/courier-bench-{}.sock", getpid());
+
+    for (std::size_t i = 0; i < arguments.size(); ++i) {
+        std::string_view argument = arguments[i];
+        if (argument == "--help" || argument == "-h") {
+            return std::nullopt;
+        }
+
+        if (!argument.starts_with("--")) {
+            return std::unexpected(std::format("Unexpected argument '{}'", argument));
+        }
+        argument.remove_prefix(2);
+
+        // Both --name=value and --name value are accepted
+        std::string_view name = argument;
+        std::string_view value;
+        if (const auto separator = argument.find('='); separator != std::string_view::npos) {
+            name = argument.substr(0, separator);
+            value = argument.substr(separator + 1);
+        } else if (i + 1 < arguments.size()) {
+            value = arguments[++i];
+        } else {
+            return std::unexpected(std::format("--{} needs a value", name));
+        }
+
+        std::optional<std::string> error;
+        const auto assign = [&error](auto& target, auto parsed) {
+            if (parsed.has_value()) {
+                target = parsed.value();
+            } else {
+                error = parsed.error();
+            }
+        };
+        const auto assign_seconds = [&](std::chrono::milliseconds& target) {
+            const auto seconds = parseNumber<double>(name, value);
+            if (seconds.has_value()) {
+                target = std::chrono::milliseconds(static_cast<std::int64_t>(seconds.value() * 1000));
+            } else {
+                error = seconds.error();
+            }
+        };
+
+        if (name == "processes") {
+            assign(options.processes, parseNumber<std::size_t>(name, value));
+        } else if (name == "streams") {
+            assign(options.streams_per_process, parseNumber<std::size_t>(name, value));
+        } else if (name == "mode") {
+            if (value == "closed") {
+                options.mode = LoadMode::ClosedLoop;
+            } else if (value == "open") {
+                options.mode = LoadMode::OpenLoop;
+            } else {
+                error = std::format("--mode: expected closed or open, got '{}'", value);
+            }
+        } else if (name == "rate") {
+            assign(options.rate, parseNumber<double>(name, value));
+        } else if (name == "duration") {
+            assign_seconds(options.duration);
+        } else if (name == "warmup") {
+            assign_seconds(options.warmup);
+        } else if (name == "mix") {
+            assign(options.mix, parseMix(value));
+        } else if (name == "payload-sizes") {
+            options.payload_sizes.clear();
+            for (const auto item : splitList(value)) {
+                std::size_t size = 0;
+                assign(size, parseNumber<std::size_t>(name, item));
+                options.payload_sizes.push_back(size);
+            }
+        } else if (name == "compute-rounds") {
+            assign(options.compute_rounds, parseNumber<std::uint32_t>(name, value));
+        } else if (name == "socket") {
+            options.socket_path = value;
+        } else if (name == "backend") {
+            if (value == "asio") {
+                options.backend = ServerBackend::Asio;
+            } else if (value == "io_uring") {
+                options.backend = ServerBackend::IoUring;
+            } else {
+                error = std::format("--backend: expected asio or io_uring, got '{}'", value);
+            }
+        } else if (name == "transport") {
+            if (value == "stream") {
+                options.transport = Transport::Stream;
+            } else if (value == "seqpacket") {
+                options.transport = Transport::SeqPacket;
+            } else {
+                error = std::format("--transport: expected stream or seqpacket, got '{}'", value);
+            }
+        } else if (name == "handler-threads") {
+            assign(options.handler_threads, parseNumber<std::size_t>(name, value));
+        } else if (name == "busy-poll-us") {
+            std::int64_t budget = 0;
+            assign(budget, parseNumber<std::int64_t>(name, value));
+            options.busy_poll_budget = std::chrono::microseconds(budget);
+        } else if (name == "json") {
+            options.json_output = std::string(value);
+        } else {
+            error = std::format("Unknown option --{}", name);
+        }
+
+        if (error.has_value()) {
+            return std::unexpected(error.value());
+        }
+    }
+
+    if (options.processes == 0 || options.streams_per_process == 0) {
+        return std::unexpected("--processes and --streams have to be at least 1");
+    }
+
+    if (options.mode == LoadMode::OpenLoop && options.rate <= 0) {
+        return std::unexpected("--mode open needs a --rate above 0");
+    }
+
+    if (options.payload_sizes.empty()) {
+        return std::unexpected("--payload-sizes needs at least one entry");
+    }
+
+    unsigned total_weight = 0;
+    for (const auto& entry : options.mix) {
+        total_weight += entry.weight;
+    }
+    if (total_weight == 0) {
+        return std::unexpected("--mix needs at least one request kind with a weight above 0");
+    }
+
+    return options;
+}
+
+std::string describeLoadMode(const LoadMode mode) {
+    return mode == LoadMode::OpenLoop ? "open" : "closed";
+}
+
+std::string describeRequestKind(const RequestKind kind) {
+    return kind == RequestKind::Compute ? "compute" : "echo";
+}
+
+std::string describeBackend(const ServerBackend backend) {
+    return backend == ServerBackend::IoUring ? "io_uring" : "asio";
+}
+
+std::string describeTransport(const Transport transport) {
+    return transport == Transport::SeqPacket ? "seqpacket" : "stream";
+}
+}  // namespace ipcourier::bench
@@ -0,0 +1,88 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef INTER_PROCESS_COURIER_BENCH_BENCHOPTIONS_HPP
+#define INTER_PROCESS_COURIER_BENCH_BENCHOPTIONS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <InterProcessCourier/SyncCommons.hpp>
+#include <InterProcessCourier/SyncServer.hpp>
+
+namespace ipcourier::bench {
+enum class LoadMode {
+    ClosedLoop,  // Every stream sends its next request as soon as the previous response arrived
+    OpenLoop,    // Requests are sent on a fixed schedule, latency counts from the scheduled send time
+};
+
+enum class RequestKind {
+    Echo,
+    Compute,
+};
+
+struct RequestMixEntry {
+    RequestKind kind = RequestKind::Echo;
+    unsigned weight = 0;
+};
+
+struct BenchOptions {
+    std::string socket_path;
+    std::size_t processes = 1;
+    std::size_t streams_per_process = 1;
+    std::chrono::milliseconds duration{5000};
+    std::chrono::milliseconds warmup{1000};
+    LoadMode mode = LoadMode::ClosedLoop;
+
+    // Requests per second summed over all streams, only used in open loop
+    double rate = 0;
+
+    std::vector<RequestMixEntry> mix{{RequestKind::Echo, 1}};
+    std::vector<std::size_t> payload_sizes{64};
+    std::uint32_t compute_rounds = 1000;
+
+    ServerBackend backend = ServerBackend::Asio;
+    Transport transport = Transport::Stream;
+    std::size_t handler_threads = 0;
+    std::chrono::microseconds busy_poll_budget{0};
+
+    // Where the JSON report is written, "-" for stdout
+    std::optional<std::string> json_output;
+};
+
+std::string getBenchUsage();
+
+// Returns nothing if only the usage was requested
+std::expected<std::optional<BenchOptions>, std::string> parseBenchOptions(std::span<const char* const> arguments);
+
+std::string describeLoadMode(LoadMode mode);
+
+std::string describeRequestKind(RequestKind kind);
+
+std::string describeBackend(ServerBackend backend);
+
+std::string describeTransport(Transport transport);
+}  // namespace ipcourier::bench
+
+#endif  // INTER_PROCESS_COURIER_BENCH_BENCHOPTIONS_HPP
@@ -0,0 +1,125 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "BenchReport.hpp"
+
+#include <array>
+#include <format>
+#include <string_view>
+
+namespace ipcourier::bench {
+struct ReportedPercentile {
+    std::string_view name;
+    double percentile = 0;
+};
+
+constexpr std::array k_reported_percentiles = {ReportedPercentile{"p50", 50.0},
+                                               ReportedPercentile{"p90", 90.0},
+                                               ReportedPercentile{"p99", 99.0},
+                                               ReportedPercentile{"p99.9", 99.9},
+                                               ReportedPercentile{"p99.99", 99.99}};
+
+static double getThroughput(const BenchOptions& options, const ClientReport& report) {
+    const auto seconds = std::chrono::duration<double>(options.duration).count();
+    return seconds > 0 ? static_cast<double>(report.requests) / seconds : 0.0;
+}
+
+static std::string describeMix(const BenchOptions& options) {
+    std::string mix;
+    for (const auto& entry : options.mix) {
+        mix += std::format("{}{}={}", mix.empty() ? "" : ",", describeRequestKind(entry.kind), entry.weight);
+    }
+
+    return mix;
+}
+
+static std::string describePayloadSizes(const BenchOptions& options, const std::string_view separator) {
+    std::string sizes;
+    for (const auto size : options.payload_sizes) {
+        sizes += std::format("{}{}", sizes.empty() ? "" : separator, size);
+    }
+
+    return sizes;
+}
+
+std::string formatTextReport(const BenchOptions& options, const ClientReport& report) {
+    const auto to_us = [](const std::uint64_t nanoseconds) { return static_cast<double>(nanoseconds) / 1000.0; };
+
+    std::string text = std::format(
+        "courier-bench: {} processes x {} streams, {} loop, mix {}, payload sizes {} bytes, {:.1f} s measured\n",
+        options.processes,
+        options.streams_per_process,
+        describeLoadMode(options.mode),
+        describeMix(options),
+        describePayloadSizes(options, ","),
+        std::chrono::duration<double>(options.duration).count());
+    text += std::format("server {} over {}, {} handler threads, busy poll {} us\n",
+                        describeBackend(options.backend),
+                        describeTransport(options.transport),
+                        options.handler_threads,
+                        options.busy_poll_budget.count());
+    text += std::format("requests {}  errors {}  throughput {:.1f} req/s",
+                        report.requests,
+                        report.errors,
+                        getThroughput(options, report));
+    if (options.mode == LoadMode::OpenLoop) {
+        text += std::format("  target {:.1f} req/s  late sends {}", options.rate, report.late_sends);
+    }
+    text += "\n";
+
+    text += std::format("latency us  min {:.1f}", to_us(report.latency.getMin()));
+    for (const auto& [name, percentile] : k_reported_percentiles) {
+        text += std::format("  {} {:.1f}", name, to_us(report.latency.getValueAtPercentile(percentile)));
+    }
+    text += std::format(
+        "  max {:.1f}  mean {:.1f}\n", to_us(report.latency.getMax()), report.latency.getMean() / 1000.0);
+
+    return text;
+}
+
+std::string formatJsonReport(const BenchOptions& options, const ClientReport& report) {
+    std::string json = "{\n";
+    json += std::format("  \"processes\": {},\n", options.processes);
+    json += std::format("  \"streams_per_process\": {},\n", options.streams_per_process);
+    json += std::format("  \"backend\": \"{}\",\n", describeBackend(options.backend));
+    json += std::format("  \"transport\": \"{}\",\n", describeTransport(options.transport));
+    json += std::format("  \"handler_threads\": {},\n", options.handler_threads);
+    json += std::format("  \"busy_poll_us\": {},\n", options.busy_poll_budget.count());
+    json += std::format("  \"mode\": \"{}\",\n", describeLoadMode(options.mode));
+    json += std::format("  \"target_rate\": {},\n", options.mode == LoadMode::OpenLoop ? options.rate : 0.0);
+    json += std::format("  \"mix\": \"{}\",\n", describeMix(options));
+    json += std::format("  \"payload_sizes\": [{}],\n", describePayloadSizes(options, ", "));
+    json += std::format("  \"duration_s\": {},\n", std::chrono::duration<double>(options.duration).count());
+    json += std::format("  \"requests\": {},\n", report.requests);
+    json += std::format("  \"errors\": {},\n", report.errors);
+    json += std::format("  \"late_sends\": {},\n", report.late_sends);
+    json += std::format("  \"throughput_rps\": {:.3f},\n", getThroughput(options, report));
+
+    json += "  \"latency_ns\": {\n";
+    json += std::format("    \"min\": {},\n", report.latency.getMin());
+    for (const auto& [name, percentile] : k_reported_percentiles) {
+        json += std::format("    \"{}\": {},\n", name, report.latency.getValueAtPercentile(percentile));
+    }
+    json += std::format("    \"max\": {},\n", report.latency.getMax());
+    json += std::format("    \"mean\": {:.1f}\n", report.latency.getMean());
+    json += "  }\n";
+    json += "}\n";
+
+    return json;
+}
+}  // namespace ipcourier::bench
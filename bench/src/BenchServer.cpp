@@ -0,0 +1,74 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "BenchServer.hpp"
+
+#include <format>
+#include <iostream>
+
+#include <InterProcessCourier/SyncServer.hpp>
+
+#include "CourierBench.pb.h"
+
+namespace ipcourier::bench {
+constexpr std::uint64_t k_fnv_offset_basis = 14695981039346656037ULL;
+constexpr std::uint64_t k_fnv_prime = 1099511628211ULL;
+
+std::uint64_t computeDigest(const std::string_view payload, const std::uint32_t rounds) {
+    auto digest = k_fnv_offset_basis;
+    for (std::uint32_t round = 0; round < rounds; ++round) {
+        for (const auto byte : payload) {
+            digest = (digest ^ static_cast<std::uint8_t>(byte)) * k_fnv_prime;
+        }
+        digest = (digest ^ round) * k_fnv_prime;
+    }
+
+    return digest;
+}
+
+int runBenchServer(const BenchOptions& options) {
+    SyncServerOptions server_options;
+    server_options.backend = options.backend;
+    server_options.transport = options.transport;
+    server_options.handler_threads = options.handler_threads;
+    server_options.busy_poll_budget = options.busy_poll_budget;
+    SyncServer server(options.socket_path, server_options);
+
+    server.registerHandler<bench_proto::EchoRequest, bench_proto::EchoResponse>(
+        [](const bench_proto::EchoRequest& request) {
+            bench_proto::EchoResponse response;
+            response.set_payload(request.payload());
+            return response;
+        });
+
+    server.registerHandler<bench_proto::ComputeRequest, bench_proto::ComputeResponse>(
+        [](const bench_proto::ComputeRequest& request) {
+            bench_proto::ComputeResponse response;
+            response.set_digest(computeDigest(request.payload(), request.rounds()));
+            return response;
+        });
+
+    const auto result = server.start();
+    if (!result.has_value()) {
+        std::cerr << std::format("courier-bench: server failed: {}\n", result.error());
+        return 1;
+    }
+
+    return 0;
+}
+}  // namespace ipcourier::bench
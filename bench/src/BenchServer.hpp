@@ -0,0 +1,35 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef INTER_PROCESS_COURIER_BENCH_BENCHSERVER_HPP
+#define INTER_PROCESS_COURIER_BENCH_BENCHSERVER_HPP
+
+#include "BenchOptions.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+namespace ipcourier::bench {
+// FNV-1a over the payload, repeated rounds times and chained through the previous digest
+std::uint64_t computeDigest(std::string_view payload, std::uint32_t rounds);
+
+// Serves echo and compute requests until the process is terminated, returns only if the server failed
+int runBenchServer(const BenchOptions& options);
+}  // namespace ipcourier::bench
+
+#endif  // INTER_PROCESS_COURIER_BENCH_BENCHSERVER_HPP
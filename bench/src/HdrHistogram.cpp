@@ -0,0 +1,157 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "HdrHistogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+namespace ipcourier::bench {
+// 2048 sub-buckets per power of two keep the bucket width below 0.1 % of its values
+constexpr unsigned k_sub_bucket_bits = 11;
+constexpr std::uint64_t k_sub_bucket_count = std::uint64_t{1} << k_sub_bucket_bits;
+constexpr std::uint64_t k_sub_bucket_half_count = k_sub_bucket_count / 2;
+
+HdrHistogram::HdrHistogram(const std::uint64_t max_value) :
+    m_max_value(max_value), m_counts(getIndex(max_value) + 1, 0) {
+}
+
+std::size_t HdrHistogram::getIndex(const std::uint64_t value) {
+    // Values below k_sub_bucket_count are exact, every further power of two uses the upper half of the buckets
+    const auto magnitude = static_cast<unsigned>(std::bit_width(value));
+    if (magnitude <= k_sub_bucket_bits) {
+        return static_cast<std::size_t>(value);
+    }
+
+    const auto shift = magnitude - k_sub_bucket_bits;
+    return static_cast<std::size_t>(shift * k_sub_bucket_half_count + (value >> shift));
+}
+
+std::uint64_t HdrHistogram::getHighestValueAt(const std::size_t index) {
+    if (index < k_sub_bucket_count) {
+        return index;
+    }
+
+    const auto shift = (index - k_sub_bucket_half_count) / k_sub_bucket_half_count;
+    const auto sub_bucket = index - shift * k_sub_bucket_half_count;
+    return ((sub_bucket + 1) << shift) - 1;
+}
+
+void HdrHistogram::record(std::uint64_t value) {
+    value = std::min(value, m_max_value);
+
+    ++m_counts[getIndex(value)];
+    ++m_total_count;
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+    m_sum += static_cast<long double>(value);
+}
+
+void HdrHistogram::merge(const HdrHistogram& other) {
+    const auto count = std::min(m_counts.size(), other.m_counts.size());
+    for (std::size_t i = 0; i < count; ++i) {
+        m_counts[i] += other.m_counts[i];
+    }
+
+    m_total_count += other.m_total_count;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+    m_sum += other.m_sum;
+}
+
+std::uint64_t HdrHistogram::getValueAtPercentile(const double percentile) const {
+    if (m_total_count == 0) {
+        return 0;
+    }
+
+    const auto clamped = std::clamp(percentile, 0.0, 100.0);
+    const auto rank = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(m_total_count))));
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < m_counts.size(); ++i) {
+        seen += m_counts[i];
+        if (seen >= rank) {
+            // The bucket edge may overshoot the largest sample, which is known exactly
+            return std::min(getHighestValueAt(i), m_max);
+        }
+    }
+
+    return m_max;
+}
+
+std::uint64_t HdrHistogram::getTotalCount() const {
+    return m_total_count;
+}
+
+std::uint64_t HdrHistogram::getMin() const {
+    return m_total_count == 0 ? 0 : m_min;
+}
+
+std::uint64_t HdrHistogram::getMax() const {
+    return m_max;
+}
+
+double HdrHistogram::getMean() const {
+    return m_total_count == 0 ? 0.0 : static_cast<double>(m_sum / static_cast<long double>(m_total_count));
+}
+
+std::string HdrHistogram::encode() const {
+    // Only non-empty buckets are written, as pairs of index and count behind the fixed fields
+    std::vector<std::uint64_t> words{m_max_value, m_total_count, m_min, m_max};
+    for (std::size_t i = 0; i < m_counts.size(); ++i) {
+        if (m_counts[i] != 0) {
+            words.push_back(i);
+            words.push_back(m_counts[i]);
+        }
+    }
+
+    std::string encoded(sizeof(long double) + words.size() * sizeof(std::uint64_t), '\0');
+    std::memcpy(encoded.data(), &m_sum, sizeof(long double));
+    std::memcpy(encoded.data() + sizeof(long double), words.data(), words.size() * sizeof(std::uint64_t));
+    return encoded;
+}
+
+std::optional<HdrHistogram> HdrHistogram::decode(const std::string_view encoded) {
+    constexpr std::size_t k_fixed_words = 4;
+    if (encoded.size() < sizeof(long double) + k_fixed_words * sizeof(std::uint64_t) ||
+        (encoded.size() - sizeof(long double)) % (2 * sizeof(std::uint64_t)) != 0) {
+        return std::nullopt;
+    }
+
+    std::vector<std::uint64_t> words((encoded.size() - sizeof(long double)) / sizeof(std::uint64_t));
+    std::memcpy(words.data(), encoded.data() + sizeof(long double), words.size() * sizeof(std::uint64_t));
+
+    HdrHistogram histogram(words[0]);
+    std::memcpy(&histogram.m_sum, encoded.data(), sizeof(long double));
+    histogram.m_total_count = words[1];
+    histogram.m_min = words[2];
+    histogram.m_max = words[3];
+
+    for (std::size_t i = k_fixed_words; i < words.size(); i += 2) {
+        if (words[i] >= histogram.m_counts.size()) {
+            return std::nullopt;
+        }
+        histogram.m_counts[words[i]] = words[i + 1];
+    }
+
+    return histogram;
+}
+}  // namespace ipcourier::bench
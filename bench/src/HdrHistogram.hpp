@@ -0,0 +1,76 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef INTER_PROCESS_COURIER_BENCH_HDRHISTOGRAM_HPP
+#define INTER_PROCESS_COURIER_BENCH_HDRHISTOGRAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ipcourier::bench {
+/*
+ * High dynamic range histogram of latencies in nanoseconds. Values are kept with three significant digits
+ * across the whole range: every power of two is split into the same number of linear sub-buckets, so the
+ * relative error is the same for a 2 us and a 2 s sample and recording never allocates.
+ */
+class HdrHistogram {
+public:
+    // Larger values are recorded as max_value, the default covers an hour
+    explicit HdrHistogram(std::uint64_t max_value = 3'600'000'000'000);
+
+    void record(std::uint64_t value);
+
+    // Both histograms must have been created with the same max_value
+    void merge(const HdrHistogram& other);
+
+    // Highest value that at least percentile percent of the samples do not exceed, 0 if nothing was recorded
+    std::uint64_t getValueAtPercentile(double percentile) const;
+
+    std::uint64_t getTotalCount() const;
+
+    std::uint64_t getMin() const;
+
+    std::uint64_t getMax() const;
+
+    double getMean() const;
+
+    // Compact binary form for handing a histogram to another process of the same binary
+    std::string encode() const;
+
+    static std::optional<HdrHistogram> decode(std::string_view encoded);
+
+private:
+    std::uint64_t m_max_value;
+    std::vector<std::uint64_t> m_counts;
+    std::uint64_t m_total_count = 0;
+    std::uint64_t m_min = UINT64_MAX;
+    std::uint64_t m_max = 0;
+    long double m_sum = 0;
+
+    static std::size_t getIndex(std::uint64_t value);
+
+    // Highest value that maps to index, all samples of a bucket are reported as this value
+    static std::uint64_t getHighestValueAt(std::size_t index);
+};
+}  // namespace ipcourier::bench
+
+#endif  // INTER_PROCESS_COURIER_BENCH_HDRHISTOGRAM_HPP
@@ -0,0 +1,262 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "Replay.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <format>
+#include <map>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <InterProcessCourier/SyncClient.hpp>
+#include <InterProcessCourier/TrafficCapture.hpp>
+
+namespace ipcourier::bench {
+using Clock = std::chrono::steady_clock;
+
+// Lets every replaying client connect before the first captured request is due
+constexpr auto k_start_delay = std::chrono::milliseconds(100);
+constexpr auto k_late_send_threshold = std::chrono::milliseconds(1);
+
+// Handshake and reflection requests of the original clients
+constexpr std::string_view k_internal_type_prefix = "ipcourier.internal";
+
+constexpr std::array k_reported_percentiles = {std::pair{"p50", 50.0},
+                                               std::pair{"p90", 90.0},
+                                               std::pair{"p99", 99.0},
+                                               std::pair{"p99.9", 99.9}};
+
+std::string getReplayUsage() {
+    return "Usage: courier-replay [options] CAPTURE SOCKET\n"
+           "\n"
+           "Sends the requests of a capture written by SyncServerOptions::traffic_capture to the server listening\n"
+           "on SOCKET. Every captured connection gets its own client and thread and keeps its captured order and\n"
+           "timing, then throughput and latency percentiles are reported.\n"
+           "\n"
+           "  --speed X               Timing sped up by X, 0 sends back to back (1)\n"
+           "  --transport stream|seqpacket\n"
+           "  --help\n";
+}
+
+std::expected<std::optional<ReplayOptions>, std::string> parseReplayOptions(
+    const std::span<const char* const> arguments) {
+    ReplayOptions options;
+    std::vector<std::string_view> positional;
+
+    for (std::size_t i = 0; i < arguments.size(); ++i) {
+        std::string_view argument = arguments[i];
+        if (argument == "--help" || argument == "-h") {
+            return std::nullopt;
+        }
+
+        if (!argument.starts_with("--")) {
+            positional.push_back(argument);
+            continue;
+        }
+        argument.remove_prefix(2);
+
+        // Both --name=value and --name value are accepted
+        std::string_view name = argument;
+        std::string_view value;
+        if (const auto separator = argument.find('='); separator != std::string_view::npos) {
+            name = argument.substr(0, separator);
+            value = argument.substr(separator + 1);
+        } else if (i + 1 < arguments.size()) {
+            value = arguments[++i];
+        } else {
+            return std::unexpected(std::format("--{} needs a value", name));
+        }
+
+        if (name == "speed") {
+            const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), options.speed);
+            if (error != std::errc() || end != value.data() + value.size() || options.speed < 0) {
+                return std::unexpected(std::format("--speed: '{}' is not a valid factor", value));
+            }
+        } else if (name == "transport") {
+            if (value == "stream") {
+                options.transport = Transport::Stream;
+            } else if (value == "seqpacket") {
+                options.transport = Transport::SeqPacket;
+            } else {
+                return std::unexpected(std::format("--transport: expected stream or seqpacket, got '{}'", value));
+            }
+        } else {
+            return std::unexpected(std::format("Unknown option --{}", name));
+        }
+    }
+
+    if (positional.size() != 2) {
+        return std::unexpected("Expected the capture file and the server socket");
+    }
+    options.capture_path = positional[0];
+    options.socket_path = positional[1];
+
+    return options;
+}
+
+namespace {
+void mergeReport(ReplayReport& report, const ReplayReport& other) {
+    report.latency.merge(other.latency);
+    report.requests += other.requests;
+    report.one_way_messages += other.one_way_messages;
+    report.errors += other.errors;
+    report.skipped += other.skipped;
+    report.late_sends += other.late_sends;
+}
+
+// The payload is the type name and the body separated by the first ':', as it travelled over the socket
+std::optional<RawMessage> makeMessage(const std::string_view payload) {
+    const auto separator = payload.find(':');
+    if (separator == std::string_view::npos) {
+        return std::nullopt;
+    }
+
+    return RawMessage(payload.substr(0, separator), payload.substr(separator + 1));
+}
+
+ReplayReport replayConnection(const ReplayOptions& options,
+                              const std::vector<CapturedRequest>& requests,
+                              const Clock::time_point start_at) {
+    ReplayReport report;
+
+    // The captured types are unknown to the replay, the server still rejects requests it cannot handle
+    SyncClientOptions client_options;
+    client_options.validate_req_res_pair_strategy = ValidateRequestResponsePairStrategy::NoValidation;
+    client_options.transport = options.transport;
+
+    SyncClient client(options.socket_path, client_options);
+    if (!client.connect().has_value()) {
+        report.errors = requests.size();
+        return report;
+    }
+
+    std::this_thread::sleep_until(start_at);
+
+    for (const auto& captured : requests) {
+        const auto message = makeMessage(captured.payload);
+        if (!message.has_value() || message->getTypeName().starts_with(k_internal_type_prefix)) {
+            ++report.skipped;
+            continue;
+        }
+
+        // Latency counts from the scheduled send time, like the open loop of courier-bench
+        auto intended = Clock::now();
+        if (options.speed > 0) {
+            intended = start_at + std::chrono::duration_cast<Clock::duration>(captured.timestamp / options.speed);
+            const auto now = Clock::now();
+            if (intended > now) {
+                std::this_thread::sleep_until(intended);
+            } else if (now - intended > k_late_send_threshold) {
+                ++report.late_sends;
+            }
+        }
+
+        const RequestOptions request_options{.priority = captured.priority};
+        if (captured.one_way) {
+            if (client.postRaw(message.value(), request_options).has_value()) {
+                ++report.one_way_messages;
+            } else {
+                ++report.errors;
+            }
+            continue;
+        }
+
+        if (!client.sendRawRequest(message.value(), request_options).has_value()) {
+            ++report.errors;
+            continue;
+        }
+
+        ++report.requests;
+        report.latency.record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - intended).count()));
+    }
+
+    return report;
+}
+}  // namespace
+
+std::expected<ReplayReport, std::string> runReplay(const ReplayOptions& options) {
+    auto reader = TrafficCaptureReader::open(options.capture_path);
+    if (!reader.has_value()) {
+        return std::unexpected(std::format("unable to read {}: {}", options.capture_path, reader.error()));
+    }
+
+    ReplayReport report;
+
+    // The payloads point into the mapped capture, which stays open until every connection is replayed
+    std::map<std::uint64_t, std::vector<CapturedRequest>> connections;
+    while (auto captured = reader->next()) {
+        report.captured_duration = std::max(report.captured_duration, captured->timestamp);
+        connections[captured->connection_id].push_back(captured.value());
+    }
+    report.connections = connections.size();
+
+    const auto start_at = Clock::now() + k_start_delay;
+    std::vector<ReplayReport> connection_reports(connections.size());
+    std::vector<std::thread> threads;
+    for (const auto& [connection_id, requests] : connections) {
+        threads.emplace_back([&, index = threads.size()] {
+            connection_reports[index] = replayConnection(options, requests, start_at);
+        });
+    }
+
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        threads[i].join();
+        mergeReport(report, connection_reports[i]);
+    }
+    // Connections that failed to connect return before the start
+    const auto finished_at = std::max(Clock::now(), start_at);
+    report.replay_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(finished_at - start_at);
+
+    return report;
+}
+
+std::string formatReplayReport(const ReplayOptions& options, const ReplayReport& report) {
+    const auto to_us = [](const std::uint64_t nanoseconds) { return static_cast<double>(nanoseconds) / 1000.0; };
+    const auto to_s = [](const std::chrono::nanoseconds duration) {
+        return std::chrono::duration<double>(duration).count();
+    };
+
+    std::string text = std::format("courier-replay: {} connections from {}, speed {}, {:.3f} s captured\n",
+                                   report.connections,
+                                   options.capture_path,
+                                   options.speed,
+                                   to_s(report.captured_duration));
+    text += std::format("requests {}  one-way {}  errors {}  skipped {}  late sends {}  replayed in {:.3f} s\n",
+                        report.requests,
+                        report.one_way_messages,
+                        report.errors,
+                        report.skipped,
+                        report.late_sends,
+                        to_s(report.replay_duration));
+
+    text += std::format("latency us  min {:.1f}", to_us(report.latency.getMin()));
+    for (const auto& [name, percentile] : k_reported_percentiles) {
+        text += std::format("  {} {:.1f}", name, to_us(report.latency.getValueAtPercentile(percentile)));
+    }
+    text += std::format(
+        "  max {:.1f}  mean {:.1f}\n", to_us(report.latency.getMax()), report.latency.getMean() / 1000.0);
+
+    return text;
+}
+}  // namespace ipcourier::bench
@@ -0,0 +1,73 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef INTER_PROCESS_COURIER_BENCH_REPLAY_HPP
+#define INTER_PROCESS_COURIER_BENCH_REPLAY_HPP
+
+#include "HdrHistogram.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string>
+
+#include <InterProcessCourier/SyncCommons.hpp>
+
+namespace ipcourier::bench {
+struct ReplayOptions {
+    std::string capture_path;
+    std::string socket_path;
+
+    // Factor the captured timing is sped up by, 0 sends every request as soon as the previous one finished
+    double speed = 1.0;
+
+    Transport transport = Transport::Stream;
+};
+
+struct ReplayReport {
+    // Requests only, one-way messages have no response to measure
+    HdrHistogram latency;
+    std::uint64_t requests = 0;
+    std::uint64_t one_way_messages = 0;
+    std::uint64_t errors = 0;
+
+    // Connection setup sent by the original clients, the replaying clients make their own
+    std::uint64_t skipped = 0;
+
+    // Sends that were more than a millisecond behind the scaled capture timing
+    std::uint64_t late_sends = 0;
+
+    std::uint64_t connections = 0;
+    std::chrono::nanoseconds captured_duration{0};
+    std::chrono::nanoseconds replay_duration{0};
+};
+
+std::string getReplayUsage();
+
+// Returns nothing if only the usage was requested
+std::expected<std::optional<ReplayOptions>, std::string> parseReplayOptions(std::span<const char* const> arguments);
+
+// Replays every captured connection on its own client and thread, in the captured order within each connection
+std::expected<ReplayReport, std::string> runReplay(const ReplayOptions& options);
+
+std::string formatReplayReport(const ReplayOptions& options, const ReplayReport& report);
+}  // namespace ipcourier::bench
+
+#endif  // INTER_PROCESS_COURIER_BENCH_REPLAY_HPP
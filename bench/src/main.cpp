@@ -0,0 +1,184 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "BenchClient.hpp"
+#include "BenchOptions.hpp"
+#include "BenchReport.hpp"
+#include "BenchServer.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace ipcourier::bench;
+
+// Lets the server process bind and every client connect before the warmup starts
+constexpr auto k_start_delay = std::chrono::milliseconds(500);
+
+namespace {
+struct ClientProcess {
+    pid_t pid = -1;
+    int report_fd = -1;
+};
+
+bool writeAll(const int fd, const std::string& data) {
+    std::size_t written = 0;
+    while (written < data.size()) {
+        const auto result = write(fd, data.data() + written, data.size() - written);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            return false;
+        }
+        written += static_cast<std::size_t>(result);
+    }
+
+    return true;
+}
+
+std::string readAll(const int fd) {
+    std::string data;
+    char chunk[64 * 1024];
+    while (true) {
+        const auto result = read(fd, chunk, sizeof(chunk));
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            return data;
+        }
+        data.append(chunk, static_cast<std::size_t>(result));
+    }
+}
+
+// The report travels back through a pipe, the child never returns into main
+std::optional<ClientProcess> forkClientProcess(const BenchOptions& options,
+                                               const std::size_t process_index,
+                                               const std::chrono::steady_clock::time_point start_at) {
+    int report_pipe[2];
+    if (pipe(report_pipe) != 0) {
+        return std::nullopt;
+    }
+
+    const auto pid = fork();
+    if (pid < 0) {
+        close(report_pipe[0]);
+        close(report_pipe[1]);
+        return std::nullopt;
+    }
+
+    if (pid == 0) {
+        close(report_pipe[0]);
+        const auto report = runClientProcess(options, process_index, start_at);
+        _exit(writeAll(report_pipe[1], report.encode()) ? 0 : 1);
+    }
+
+    close(report_pipe[1]);
+    return ClientProcess{.pid = pid, .report_fd = report_pipe[0]};
+}
+
+bool writeJsonReport(const std::string& path, const std::string& json) {
+    if (path == "-") {
+        std::cout << json;
+        return true;
+    }
+
+    std::ofstream file(path);
+    file << json;
+    return file.good();
+}
+}  // namespace
+
+int main(const int argc, const char* const* argv) {
+    const auto parsed = parseBenchOptions(std::span(argv + 1, static_cast<std::size_t>(argc - 1)));
+    if (!parsed.has_value()) {
+        std::cerr << std::format("courier-bench: {}\n\n{}", parsed.error(), getBenchUsage());
+        return 2;
+    }
+    if (!parsed->has_value()) {
+        std::cout << getBenchUsage();
+        return 0;
+    }
+    const auto& options = parsed->value();
+
+    // Server and clients are forked while this process is still single threaded
+    unlink(options.socket_path.c_str());
+    const auto server_pid = fork();
+    if (server_pid < 0) {
+        std::cerr << std::format("courier-bench: unable to fork the server: {}\n", std::strerror(errno));
+        return 1;
+    }
+    if (server_pid == 0) {
+        _exit(runBenchServer(options));
+    }
+
+    const auto start_at = std::chrono::steady_clock::now() + k_start_delay;
+    std::vector<ClientProcess> clients;
+    for (std::size_t i = 0; i < options.processes; ++i) {
+        const auto client = forkClientProcess(options, i, start_at);
+        if (!client.has_value()) {
+            std::cerr << std::format("courier-bench: unable to fork client {}: {}\n", i, std::strerror(errno));
+            break;
+        }
+        clients.push_back(client.value());
+    }
+
+    ClientReport report;
+    bool complete = clients.size() == options.processes;
+    for (const auto& client : clients) {
+        const auto client_report = ClientReport::decode(readAll(client.report_fd));
+        close(client.report_fd);
+        waitpid(client.pid, nullptr, 0);
+
+        if (client_report.has_value()) {
+            report.merge(client_report.value());
+        } else {
+            complete = false;
+        }
+    }
+
+    kill(server_pid, SIGTERM);
+    waitpid(server_pid, nullptr, 0);
+    unlink(options.socket_path.c_str());
+
+    if (!complete) {
+        std::cerr << "courier-bench: not all client processes reported, the results are incomplete\n";
+    }
+
+    // JSON on stdout stays parseable, the text report moves to stderr then
+    const auto json_to_stdout = options.json_output == "-";
+    (json_to_stdout ? std::cerr : std::cout) << formatTextReport(options, report);
+
+    if (options.json_output.has_value() &&
+        !writeJsonReport(options.json_output.value(), formatJsonReport(options, report))) {
+        std::cerr << std::format("courier-bench: unable to write {}\n", options.json_output.value());
+        return 1;
+    }
+
+    return complete && report.errors == 0 ? 0 : 1;
+}
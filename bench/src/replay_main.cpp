@@ -0,0 +1,47 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "Replay.hpp"
+
+#include <format>
+#include <iostream>
+#include <span>
+
+using namespace ipcourier::bench;
+
+int main(const int argc, const char* const* argv) {
+    const auto parsed = parseReplayOptions(std::span(argv + 1, static_cast<std::size_t>(argc - 1)));
+    if (!parsed.has_value()) {
+        std::cerr << std::format("courier-replay: {}\n\n{}", parsed.error(), getReplayUsage());
+        return 2;
+    }
+    if (!parsed->has_value()) {
+        std::cout << getReplayUsage();
+        return 0;
+    }
+    const auto& options = parsed->value();
+
+    const auto report = runReplay(options);
+    if (!report.has_value()) {
+        std::cerr << std::format("courier-replay: {}\n", report.error());
+        return 1;
+    }
+
+    std::cout << formatReplayReport(options, report.value());
+    return report->errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,197 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+/**
+ * @file CoalescingSyncClient.hpp
+ * @brief Defines a thread-safe client that merges identical concurrent requests into one call to the server.
+ */
+
+#ifndef INTER_PROCESS_COURIER_COALESCING_CLIENT_HPP
+#define INTER_PROCESS_COURIER_COALESCING_CLIENT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <InterProcessCourier/SyncClient.hpp>
+
+namespace ipcourier {
+/**
+ * @brief Structure to hold various configuration options for the CoalescingSyncClient.
+ * @see CoalescingSyncClient
+ */
+struct CoalescingSyncClientOptions {
+    /**
+     * @brief Settings of every connection to the server.
+     */
+    SyncClientOptions client_options;
+
+    /**
+     * @brief Number of idle connections kept open for later requests.
+     *
+     * Connections are opened on demand when all kept ones are in use, so this only bounds how many stay open
+     * once the load drops.
+     */
+    std::size_t max_idle_connections = 8;
+};
+
+/**
+ * @brief A client that may be shared by many threads and merges identical requests that are in flight together.
+ *
+ * Every call borrows one of a pool of SyncClient connections, so threads do not wait for each other's calls.
+ * Requests of a type registered with registerCoalescible are merged: while a request is in flight, further calls
+ * with a byte-identical serialized request and the same response type do not reach the server but wait for the
+ * response of the first one. All of them get the same result, parsed once. This suits queries many threads ask
+ * at the same moment, e.g. for the current configuration generation, and must only be enabled for requests
+ * whose handler has no side effects, like SyncServer::registerCachedHandler.
+ *
+ * A call that joined an in-flight request gets its result even if the call had a later deadline, and stops
+ * waiting with SyncClientError::DeadlineExceeded once its own earlier deadline passed.
+ */
+class CoalescingSyncClient {
+public:
+    /**
+     * @brief Constructs a client, nothing is connected until connect is called.
+     *
+     * @param socket_addr The path to the Unix Domain Socket file of the server.
+     * @param options Various settings relating to the client. @see CoalescingSyncClientOptions
+     */
+    CoalescingSyncClient(std::string socket_addr, CoalescingSyncClientOptions options);
+
+    ~CoalescingSyncClient();
+
+    /**
+     * @brief Opens the first connection to the server, see SyncClient::connect.
+     *
+     * Further connections are opened on demand with the same settings.
+     */
+    SyncClientResult<void> connect();
+
+    /**
+     * @brief Merges concurrent identical `RequestType` requests into one call to the server.
+     *
+     * Has to be called before the client is used from several threads.
+     *
+     * @tparam RequestType The type of the Protocol Buffer request message.
+     * Must have a Codec, see IsCourierMessage.
+     */
+    template <IsCourierMessage RequestType>
+    void registerCoalescible() {
+        m_coalescible_types.emplace(_detail::getMessageTypeName<RequestType>());
+    }
+
+    /**
+     * @brief Sends a request over one of the pooled connections, see SyncClient::sendRequest.
+     *
+     * @retval SyncClientError::UnableToConnectToServer If all connections were in use and a new one could not be
+     * opened.
+     */
+    template <IsCourierMessage RequestType, IsCourierMessage ResponseType>
+    SyncClientResult<ResponseType> sendRequest(const RequestType& request, const RequestOptions& request_options = {}) {
+        const auto send_request = [&request, &request_options](SyncClient& client) {
+            return client.template sendRequest<RequestType, ResponseType>(request, request_options);
+        };
+
+        if (!m_coalescible_types.contains(_detail::getMessageTypeName<RequestType>())) {
+            return callWithClient<ResponseType>(send_request);
+        }
+
+        // Only calls of the same request and response type with equal bytes are shared
+        std::string key(_detail::getMessageTypeName<RequestType>());
+        key.push_back('\0');
+        key.append(_detail::makePayloadFromMessage(request));
+        key.push_back('\0');
+        key.append(_detail::getMessageTypeName<ResponseType>());
+
+        const auto result = callCoalesced(std::move(key), request_options.deadline, [this, &send_request] {
+            return std::make_shared<const SyncClientResult<ResponseType> >(callWithClient<ResponseType>(send_request));
+        });
+        if (result == nullptr) {
+            return std::unexpected(Error(SyncClientError::DeadlineExceeded, "Deadline passed awaiting the response"));
+        }
+
+        return *static_cast<const SyncClientResult<ResponseType>*>(result.get());
+    }
+
+    /**
+     * @brief Gets the number of calls that were answered by a request already in flight instead of the server.
+     */
+    std::uint64_t getCoalescedRequestCount() const;
+
+private:
+    struct TransparentStringHash {
+        using is_transparent = void;
+
+        std::size_t operator()(const std::string_view value) const {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    // Points to the SyncClientResult of the response type the key was made for
+    using CoalescedResult = std::shared_ptr<const void>;
+
+    std::string m_socket_addr;
+    CoalescingSyncClientOptions m_options;
+
+    std::mutex m_idle_clients_mutex;
+    std::vector<std::unique_ptr<SyncClient> > m_idle_clients;
+
+    std::unordered_set<std::string, TransparentStringHash, std::equal_to<> > m_coalescible_types;
+
+    std::mutex m_in_flight_calls_mutex;
+    std::unordered_map<std::string, std::shared_future<CoalescedResult> > m_in_flight_calls;
+    std::atomic<std::uint64_t> m_coalesced_request_count = 0;
+
+    template <typename ResponseType, typename Call>
+    SyncClientResult<ResponseType> callWithClient(const Call& call) {
+        auto client = acquireClient();
+        if (!client.has_value()) {
+            return std::unexpected(client.error());
+        }
+
+        auto result = call(*client.value());
+        releaseClient(std::move(client.value()),
+                      result.has_value() ? std::nullopt : std::optional(result.error().type));
+
+        return result;
+    }
+
+    SyncClientResult<std::unique_ptr<SyncClient> > acquireClient();
+
+    // Drops the connection instead if the call that failed with it may have broken it
+    void releaseClient(std::unique_ptr<SyncClient> client, std::optional<SyncClientError> failure = std::nullopt);
+
+    // Runs call unless a call with the same key is in flight, returns nothing if the deadline passed while waiting
+    CoalescedResult callCoalesced(std::string key,
+                                  std::chrono::steady_clock::time_point deadline,
+                                  const std::function<CoalescedResult()>& call);
+};
+}  // namespace ipcourier
+
+#endif  // INTER_PROCESS_COURIER_COALESCING_CLIENT_HPP
@@ -0,0 +1,462 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+/**
+ * @file Codec.hpp
+ * @brief Defines how message types are named and encoded on the wire, for Protocol Buffers and for plain
+ * trivially copyable structs.
+ */
+
+#ifndef INTER_PROCESS_COURIER_CODEC_HPP
+#define INTER_PROCESS_COURIER_CODEC_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <InterProcessCourier/ProtobufInterface.hpp>
+#include <InterProcessCourier/detail/ProtobufTools.hpp>
+
+namespace ipcourier {
+/**
+ * @brief Customization point describing how messages of `MessageType` travel between client and server.
+ *
+ * A specialization provides:
+ * - `static std::string_view getTypeName()`, the name both sides register and dispatch the type by,
+ * - `static void appendBody(const MessageType& message, std::string& payload)`, appending the encoded message,
+ * - `static bool parseBody(std::string_view body, MessageType& message)`, decoding it again.
+ *
+ * Codecs for Protocol Buffer messages and for trivially copyable structs declaring a `courier_type_name` are
+ * provided. Every handler, request, event and Responder type can use any codec, messages of different codecs
+ * may be mixed on the same connection.
+ *
+ * @tparam MessageType The C++ type of the message.
+ */
+template <typename MessageType>
+struct Codec {};
+
+/**
+ * @brief Concept to check if a type can be sent through the library, i.e. if it has a Codec.
+ * @tparam T The type to check
+ */
+template <typename T>
+concept IsCourierMessage = requires(const T& message, std::string& payload, std::string_view body, T& parsed) {
+    { Codec<T>::getTypeName() } -> std::convertible_to<std::string_view>;
+    Codec<T>::appendBody(message, payload);
+    { Codec<T>::parseBody(body, parsed) } -> std::same_as<bool>;
+};
+
+/**
+ * @brief Codec of Protocol Buffer messages, the default of the library. Types are named by their full name.
+ */
+template <IsDerivedFromProtoMessage MessageType>
+struct Codec<MessageType> {
+    static std::string_view getTypeName() {
+        return MessageType::descriptor()->full_name();
+    }
+
+    static void appendBody(const MessageType& message, std::string& payload) {
+        message.AppendToString(&payload);
+    }
+
+    static bool parseBody(const std::string_view body, MessageType& message) {
+        return message.ParseFromArray(body.data(), static_cast<int>(body.size()));
+    }
+};
+
+/**
+ * @brief Concept of structs sent as their raw bytes, without any encoding.
+ *
+ * The struct has to be trivially copyable and declare its wire name as
+ * `static constexpr std::string_view courier_type_name`. An optional `static constexpr std::uint32_t
+ * courier_layout_version` is bumped whenever the meaning of fields changes while their types stay the same.
+ * Structs that are not aggregates of up to 16 fields without base classes have to declare it, their fields cannot be
+ * enumerated and only size and alignment are checked besides it.
+ *
+ * @code
+ * struct PositionUpdate {
+ *     static constexpr std::string_view courier_type_name = "robot.PositionUpdate";
+ *     std::uint64_t timestamp_ns;
+ *     double x, y, z;
+ * };
+ * @endcode
+ *
+ * Both sides have to run on the same architecture, which a Unix Domain Socket implies, and use the same
+ * definition of the struct. The wire name carries a hash of the layout, so peers built with differing
+ * definitions do not match each other's types instead of reading garbage. Padding is sent zeroed, structs whose
+ * fields cannot be enumerated must not have any.
+ *
+ * @tparam T The type to check
+ */
+template <typename T>
+concept IsTrivialMessage = std::is_trivially_copyable_v<T> && requires {
+    { T::courier_type_name } -> std::convertible_to<std::string_view>;
+};
+}  // namespace ipcourier
+
+namespace ipcourier::_detail {
+// Converts to any field type, used to count the fields of an aggregate by brace initialization
+struct AnyField {
+    template <typename FieldType>
+    constexpr operator FieldType() const noexcept;
+};
+
+// Every field gets its own braces, so arrays and nested structs count as one field like in a structured binding
+template <typename T, typename... Fields>
+consteval std::size_t countAggregateFields() {
+    if constexpr (requires { T{{Fields{}}..., {AnyField{}}}; }) {
+        return countAggregateFields<T, Fields..., AnyField>();
+    } else {
+        return sizeof...(Fields);
+    }
+}
+
+inline constexpr std::size_t k_max_enumerated_fields = 16;
+
+// Aggregate structs, whose fields can be named by a structured binding
+template <typename T>
+consteval bool isEnumerable() {
+    if constexpr (std::is_class_v<T> && std::is_aggregate_v<T>) {
+        return countAggregateFields<T>() <= k_max_enumerated_fields;
+    } else {
+        return false;
+    }
+}
+
+// References to the fields of `value`, in declaration order
+template <typename T>
+constexpr auto tieFields(T& value) {
+    constexpr auto count = countAggregateFields<std::remove_const_t<T>>();
+    static_assert(count <= k_max_enumerated_fields);
+
+    if constexpr (count == 0) {
+        return std::tuple<>();
+    } else if constexpr (count == 1) {
+        auto& [f0] = value;
+        return std::tie(f0);
+    } else if constexpr (count == 2) {
+        auto& [f0, f1] = value;
+        return std::tie(f0, f1);
+    } else if constexpr (count == 3) {
+        auto& [f0, f1, f2] = value;
+        return std::tie(f0, f1, f2);
+    } else if constexpr (count == 4) {
+        auto& [f0, f1, f2, f3] = value;
+        return std::tie(f0, f1, f2, f3);
+    } else if constexpr (count == 5) {
+        auto& [f0, f1, f2, f3, f4] = value;
+        return std::tie(f0, f1, f2, f3, f4);
+    } else if constexpr (count == 6) {
+        auto& [f0, f1, f2, f3, f4, f5] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5);
+    } else if constexpr (count == 7) {
+        auto& [f0, f1, f2, f3, f4, f5, f6] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6);
+    } else if constexpr (count == 8) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7);
+    } else if constexpr (count == 9) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8);
+    } else if constexpr (count == 10) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9);
+    } else if constexpr (count == 11) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+    } else if constexpr (count == 12) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
+    } else if constexpr (count == 13) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12);
+    } else if constexpr (count == 14) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13);
+    } else if constexpr (count == 15) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14);
+    } else if constexpr (count == 16) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15);
+    }
+}
+
+template <typename T>
+using FieldTypes = decltype(tieFields(std::declval<const T&>()));
+
+enum class FieldKind : std::uint8_t {
+    Boolean,
+    Signed,
+    Unsigned,
+    Floating,
+    Enumeration,
+    Pointer,
+    Array,
+    Struct,
+    Opaque,
+};
+
+template <IsTrivialMessage T>
+consteval std::uint32_t getLayoutVersion() {
+    if constexpr (requires { T::courier_layout_version; }) {
+        return T::courier_layout_version;
+    } else {
+        return 0;
+    }
+}
+
+consteval std::uint64_t hashLayoutValue(std::uint64_t hash, std::uint64_t value) {
+    for (std::size_t byte = 0; byte < sizeof(value); ++byte) {
+        hash ^= value & 0xff;
+        hash *= 1099511628211ULL;
+        value >>= 8;
+    }
+
+    return hash;
+}
+
+template <typename Field>
+consteval std::uint64_t hashFieldType(std::uint64_t hash);
+
+template <typename... Fields>
+consteval std::uint64_t hashFieldTypes(std::uint64_t hash, std::type_identity<std::tuple<Fields...>>) {
+    ((hash = hashFieldType<std::remove_cvref_t<Fields>>(hash)), ...);
+    return hash;
+}
+
+// Kind and size of the field, the fields of nested structs and the elements of arrays are folded in recursively
+template <typename Field>
+consteval std::uint64_t hashFieldType(std::uint64_t hash) {
+    if constexpr (std::is_array_v<Field>) {
+        hash = hashLayoutValue(hash, static_cast<std::uint64_t>(FieldKind::Array));
+        hash = hashLayoutValue(hash, std::extent_v<Field>);
+        return hashFieldType<std::remove_extent_t<Field>>(hash);
+    } else if constexpr (std::is_enum_v<Field>) {
+        hash = hashLayoutValue(hash, static_cast<std::uint64_t>(FieldKind::Enumeration));
+        return hashFieldType<std::underlying_type_t<Field>>(hash);
+    } else if constexpr (isEnumerable<Field>()) {
+        hash = hashLayoutValue(hash, static_cast<std::uint64_t>(FieldKind::Struct));
+        hash = hashLayoutValue(hash, sizeof(Field));
+        return hashFieldTypes(hash, std::type_identity<FieldTypes<Field>>());
+    } else {
+        auto kind = FieldKind::Opaque;
+        if constexpr (std::is_same_v<Field, bool>) {
+            kind = FieldKind::Boolean;
+        } else if constexpr (std::is_floating_point_v<Field>) {
+            kind = FieldKind::Floating;
+        } else if constexpr (std::is_integral_v<Field>) {
+            kind = std::is_signed_v<Field> ? FieldKind::Signed : FieldKind::Unsigned;
+        } else if constexpr (std::is_pointer_v<Field>) {
+            kind = FieldKind::Pointer;
+        }
+
+        hash = hashLayoutValue(hash, static_cast<std::uint64_t>(kind));
+        return hashLayoutValue(hash, sizeof(Field));
+    }
+}
+
+/*
+ * Name, size, alignment and the kind and size of every field, all of which are spelled the same by every compiler.
+ * Structs whose fields cannot be enumerated are identified by their version instead.
+ */
+template <IsTrivialMessage T>
+consteval std::uint64_t getLayoutHash() {
+    static_assert(isEnumerable<T>() || requires { T::courier_layout_version; },
+                  "Trivial messages that are not aggregates of up to 16 fields must declare courier_layout_version");
+
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const auto character : std::string_view(T::courier_type_name)) {
+        hash = hashLayoutValue(hash, static_cast<unsigned char>(character));
+    }
+
+    hash = hashLayoutValue(hash, sizeof(T));
+    hash = hashLayoutValue(hash, alignof(T));
+    if constexpr (isEnumerable<T>()) {
+        hash = hashFieldTypes(hash, std::type_identity<FieldTypes<T>>());
+    }
+
+    return hashLayoutValue(hash, getLayoutVersion<T>());
+}
+
+template <typename... Fields>
+consteval std::size_t countValueBytes(std::type_identity<std::tuple<Fields...>>);
+
+// Bytes holding field values, anything else in sizeof(T) is padding
+template <typename T>
+consteval std::size_t countValueBytes() {
+    if constexpr (std::is_array_v<T>) {
+        return std::extent_v<T> * countValueBytes<std::remove_extent_t<T>>();
+    } else if constexpr (isEnumerable<T>()) {
+        return countValueBytes(std::type_identity<FieldTypes<T>>());
+    } else {
+        return sizeof(T);
+    }
+}
+
+template <typename... Fields>
+consteval std::size_t countValueBytes(std::type_identity<std::tuple<Fields...>>) {
+    return (std::size_t{0} + ... + countValueBytes<std::remove_cvref_t<Fields>>());
+}
+
+template <typename T>
+consteval bool hasPadding() {
+    return countValueBytes<T>() != sizeof(T);
+}
+
+template <typename... Fields>
+consteval bool hasDefinedBytes(std::type_identity<std::tuple<Fields...>>);
+
+// Padding that cannot be skipped field by field has to be absent, unique object representations guarantee that
+template <typename T>
+consteval bool hasDefinedBytes() {
+    if constexpr (std::is_array_v<T>) {
+        return hasDefinedBytes<std::remove_extent_t<T>>();
+    } else if constexpr (isEnumerable<T>()) {
+        return hasDefinedBytes(std::type_identity<FieldTypes<T>>());
+    } else if constexpr (std::is_class_v<T> || std::is_union_v<T>) {
+        return std::has_unique_object_representations_v<T>;
+    } else {
+        return true;
+    }
+}
+
+template <typename... Fields>
+consteval bool hasDefinedBytes(std::type_identity<std::tuple<Fields...>>) {
+    return (true && ... && hasDefinedBytes<std::remove_cvref_t<Fields>>());
+}
+
+// Copies the values of `field` to the same offsets in `body`, which starts zeroed, so padding is never sent
+template <typename T>
+void copyValueBytes(const T& field, const char* message, char* body) {
+    if constexpr (!hasPadding<T>()) {
+        const auto offset = reinterpret_cast<const char*>(std::addressof(field)) - message;
+        std::memcpy(body + offset, std::addressof(field), sizeof(T));
+    } else if constexpr (std::is_array_v<T>) {
+        for (const auto& element : field) {
+            copyValueBytes(element, message, body);
+        }
+    } else {
+        std::apply([&](const auto&... fields) { (copyValueBytes(fields, message, body), ...); }, tieFields(field));
+    }
+}
+}  // namespace ipcourier::_detail
+
+namespace ipcourier {
+/**
+ * @brief Codec of trivially copyable structs, see IsTrivialMessage. The bytes of the struct are the body.
+ *
+ * Types are named `<courier_type_name>#<layout hash>`.
+ */
+template <IsTrivialMessage MessageType>
+struct Codec<MessageType> {
+    static_assert(_detail::hasDefinedBytes<MessageType>(),
+                  "Padding of a trivial message whose fields cannot be enumerated would be sent uninitialized");
+
+    static constexpr std::uint64_t k_layout_hash = _detail::getLayoutHash<MessageType>();
+
+    static std::string_view getTypeName() {
+        static const auto type_name =
+            std::format("{}#{:016x}", std::string_view(MessageType::courier_type_name), k_layout_hash);
+        return type_name;
+    }
+
+    static void appendBody(const MessageType& message, std::string& payload) {
+        const auto* bytes = reinterpret_cast<const char*>(std::addressof(message));
+        if constexpr (_detail::hasPadding<MessageType>()) {
+            const auto offset = payload.size();
+            payload.resize(offset + sizeof(MessageType));
+            _detail::copyValueBytes(message, bytes, payload.data() + offset);
+        } else {
+            payload.append(bytes, sizeof(MessageType));
+        }
+    }
+
+    // The body is not necessarily aligned for MessageType, copying it out is the portable way to read it
+    static bool parseBody(const std::string_view body, MessageType& message) {
+        if (body.size() != sizeof(MessageType)) {
+            return false;
+        }
+
+        std::memcpy(&message, body.data(), sizeof(MessageType));
+        return true;
+    }
+};
+}  // namespace ipcourier
+
+namespace ipcourier::_detail {
+template <IsCourierMessage MessageType>
+std::string_view getMessageTypeName() {
+    return Codec<MessageType>::getTypeName();
+}
+
+template <IsCourierMessage MessageType>
+SerializedProtoPayload makePayloadFromMessage(const MessageType& message) {
+    const auto type_name = Codec<MessageType>::getTypeName();
+
+    SerializedProtoPayload payload;
+    payload.reserve(type_name.size() + 1);
+    payload.append(type_name);
+    payload.push_back(':');
+    Codec<MessageType>::appendBody(message, payload);
+    return payload;
+}
+
+template <IsCourierMessage MessageType>
+ProtobufToolResult<MessageType> makeMessageFromBody(const std::string_view body) {
+    MessageType message{};
+    if (!Codec<MessageType>::parseBody(body, message)) {
+        return std::unexpected(
+            Error(ProtoPayloadParseError::DeserializationFailed,
+                  ErrorMessage::format("Unable to deserialize as {}", getMessageTypeName<MessageType>())));
+    }
+
+    return message;
+}
+
+template <IsCourierMessage MessageType>
+ProtobufToolResult<MessageType> makeMessageFromPayload(const std::string_view payload) {
+    const auto parts = splitProtoPayload(payload);
+    if (!parts.has_value()) {
+        return std::unexpected(Error(ProtoPayloadParseError::InvalidFormat,
+                                     ErrorMessage::format("Received message: {}{}",
+                                                          payload.substr(0, 128),
+                                                          payload.size() > 128 ? "..." : "")));
+    }
+
+    const auto expected_type_name = getMessageTypeName<MessageType>();
+    if (parts->type_name != expected_type_name) {
+        return std::unexpected(
+            Error(ProtoPayloadParseError::TypeMismatch,
+                  ErrorMessage::format("Received {} but expected {}", parts->type_name, expected_type_name)));
+    }
+
+    return makeMessageFromBody<MessageType>(parts->body);
+}
+}  // namespace ipcourier::_detail
+
+#endif  // INTER_PROCESS_COURIER_CODEC_HPP
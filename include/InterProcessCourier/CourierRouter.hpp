@@ -0,0 +1,198 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+/**
+ * @file CourierRouter.hpp
+ * @brief Defines a proxy server that routes requests by their type to one of several backend servers.
+ */
+
+#ifndef INTER_PROCESS_COURIER_COURIER_ROUTER_HPP
+#define INTER_PROCESS_COURIER_COURIER_ROUTER_HPP
+
+#include <cstddef>
+#include <expected>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <InterProcessCourier/Error.hpp>
+#include <InterProcessCourier/RawMessage.hpp>
+#include <InterProcessCourier/SyncClient.hpp>
+#include <InterProcessCourier/SyncServer.hpp>
+
+namespace ipcourier {
+/**
+ * @brief Enumeration of specific error codes for the router.
+ */
+enum class CourierRouterError {
+    UnknownError,           ///< An unspecified error occurred.
+    UnableToReachBackend,   ///< A backend server could not be connected to.
+    UnableToReflectRoutes,  ///< A backend server did not report its request-response mappings.
+    RuntimeError,           ///< The server accepting client connections failed.
+};
+
+/**
+ * @brief Type alias for the result of router operations.
+ *
+ * @tparam SuccessType The type returned on successful operation.
+ */
+template <typename SuccessType>
+using CourierRouterResult = std::expected<SuccessType, Error<CourierRouterError> >;
+
+/**
+ * @brief Structure to hold various configuration options for the CourierRouter.
+ * @see CourierRouter
+ */
+struct CourierRouterOptions {
+    /**
+     * @brief Settings of the server clients connect to.
+     *
+     * Requests are forwarded by blocking calls to the backends, with SyncServerOptions::handler_threads set to 0
+     * the router forwards one request at a time. Every handler thread holds at most one backend connection at a
+     * time. If two backends serve the same request type, SyncServerOptions::duplicate_registration_strategy
+     * decides which one gets it.
+     */
+    SyncServerOptions server_options;
+
+    /**
+     * @brief Settings of the connections to the backends.
+     *
+     * SyncClientOptions::validate_req_res_pair_strategy is ignored, requests are only forwarded to backends that
+     * reported their type.
+     */
+    SyncClientOptions backend_options;
+
+    /**
+     * @brief Number of idle connections kept open per backend for later requests.
+     *
+     * Connections are opened on demand when all kept ones are in use, so this only bounds how many stay open
+     * once the load drops.
+     */
+    std::size_t max_idle_connections_per_backend = 8;
+};
+
+/**
+ * @brief A server forwarding requests to the backend server that handles their type.
+ *
+ * Each backend is asked for its request-response mappings, the same reflection SyncClient uses, and every
+ * reported request type is routed to the backend that reported it. Clients connect to the single socket of
+ * the router instead of knowing the socket of each daemon, including reflection, which reports the union of
+ * all routes. Requests and responses are forwarded as RawMessage without being parsed, over persistent
+ * connections pooled per backend.
+ *
+ * Errors of a backend, such as SyncServerError::ServerOverloaded, reach the client as if the router raised them.
+ */
+class CourierRouter {
+public:
+    /**
+     * @brief Constructs a router, nothing is connected until discoverRoutes is called.
+     *
+     * @param socket_addr The path to the Unix Domain Socket file clients connect to.
+     * @param backend_socket_addrs The sockets of the backend servers.
+     * @param router_options Various settings relating to the router. @see CourierRouterOptions
+     */
+    CourierRouter(std::string socket_addr,
+                  std::vector<std::string> backend_socket_addrs,
+                  CourierRouterOptions router_options);
+
+    ~CourierRouter();
+
+    /**
+     * @brief Connects to every backend and routes the request types it reports to it.
+     *
+     * Has to be called before start. The connections used for the reflection stay open for forwarding.
+     *
+     * @return CourierRouterResult<void> A result indicating success or the first backend that failed.
+     * @retval CourierRouterError::UnableToReachBackend If a backend could not be connected to.
+     * @retval CourierRouterError::UnableToReflectRoutes If a backend did not report its mappings.
+     */
+    CourierRouterResult<void> discoverRoutes();
+
+    /**
+     * @brief Starts serving clients, blocks like SyncServer::start.
+     *
+     * @retval CourierRouterError::RuntimeError If the server failed.
+     */
+    CourierRouterResult<void> start() const;
+
+    /**
+     * @brief Gets the socket of the backend requests of a given type are forwarded to.
+     *
+     * @param request_name Full name of the Protocol Buffer request type.
+     * @return The backend socket, nothing if the type is not routed.
+     */
+    std::optional<std::string> getRoute(std::string_view request_name) const;
+
+private:
+    struct Backend {
+        std::string socket_addr;
+        std::mutex idle_clients_mutex;
+        std::vector<std::unique_ptr<SyncClient> > idle_clients;
+    };
+
+    CourierRouterOptions m_router_options;
+    std::vector<std::unique_ptr<Backend> > m_backends;
+    std::unordered_map<std::string, Backend*> m_routes;
+    SyncServer m_server;
+
+    std::unique_ptr<SyncClient> acquireClient(Backend& backend) const;
+
+    void releaseClient(Backend& backend, std::unique_ptr<SyncClient> client) const;
+
+    RawMessage forwardRequest(Backend& backend, const RawMessage& request) const;
+
+    void forwardOneWayMessage(Backend& backend, const RawMessage& request) const;
+};
+}  // namespace ipcourier
+
+template <>
+struct std::formatter<ipcourier::CourierRouterError> {
+public:
+    static constexpr auto parse(const std::format_parse_context& ctx) {
+        return ctx.begin();
+    }
+
+    static auto format(const ipcourier::CourierRouterError error, std::format_context& ctx) {
+        return std::format_to(ctx.out(), "{}", convertCourierRouterErrorToString(error));
+    }
+
+private:
+    static constexpr std::string_view convertCourierRouterErrorToString(
+        const ipcourier::CourierRouterError error_type) {
+        switch (error_type) {
+            case ipcourier::CourierRouterError::UnknownError:
+                return "Unknown error";
+            case ipcourier::CourierRouterError::UnableToReachBackend:
+                return "Unable to reach backend";
+            case ipcourier::CourierRouterError::UnableToReflectRoutes:
+                return "Unable to reflect routes";
+            case ipcourier::CourierRouterError::RuntimeError:
+                return "Runtime error";
+
+            default:
+                return "<Unknown>";
+        }
+    }
+};
+
+#endif  // INTER_PROCESS_COURIER_COURIER_ROUTER_HPP
@@ -23,9 +23,20 @@
 #ifndef INTER_PROCESS_COURIER_ERROR_HPP
 #define INTER_PROCESS_COURIER_ERROR_HPP
 
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <format>
+#include <iosfwd>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <utility>
 
 namespace ipcourier {
 /**
@@ -41,6 +52,247 @@ namespace ipcourier {
 template <typename T>
 concept IsEnum = std::is_enum_v<T>;
 
+/**
+ * @brief Message of an Error, formatted only when it is read.
+ *
+ * Failures are cheap to report and to pass on: string literals are referenced rather than copied, messages
+ * created with ErrorMessage::format keep their format string and a few small arguments inline and are only
+ * formatted once the message is printed or compared, and any other text is shared between the copies made
+ * while an error travels up through the layers of the library.
+ */
+class ErrorMessage {
+public:
+    /**
+     * @brief Constructs an empty message.
+     */
+    ErrorMessage() = default;
+
+    /**
+     * @brief Constructs a message from a string literal, which is referenced and never copied.
+     *
+     * Only constant arrays with static storage are accepted, a `const char` array on the stack does not compile and
+     * has to be passed as a `std::string_view` to be copied.
+     *
+     * @param literal The message.
+     */
+    template <std::size_t Size>
+    consteval ErrorMessage(const char (&literal)[Size]) :  // NOLINT
+        m_kind(Kind::StaticText), m_format(literal, std::char_traits<char>::length(literal)) {
+    }
+
+    /**
+     * @brief Constructs a message from a copy of the text in a buffer, e.g. the output of `strerror_r`.
+     * @param buffer The message, up to its first null character.
+     */
+    template <std::size_t Size>
+    ErrorMessage(char (&buffer)[Size]) :  // NOLINT
+        ErrorMessage(std::string(buffer, std::find(std::begin(buffer), std::end(buffer), '\0'))) {
+    }
+
+    /**
+     * @brief Constructs a message from text, which copies of the message share.
+     * @param message The message.
+     */
+    ErrorMessage(std::string message) :  // NOLINT
+        m_kind(Kind::SharedText), m_shared_text(std::make_shared<const std::string>(std::move(message))) {
+    }
+
+    /**
+     * @brief Constructs a message from a copy of text that is not a string literal, e.g. a `std::string_view`.
+     * @param text The message.
+     */
+    template <typename Text>
+        requires(std::convertible_to<const Text&, std::string_view> && !std::is_array_v<Text> &&
+                 !std::same_as<Text, std::string>)
+    ErrorMessage(const Text& text) : ErrorMessage(std::string(std::string_view(text))) {  // NOLINT
+    }
+
+    /**
+     * @brief Creates a message that is formatted with `std::format` only when it is read.
+     *
+     * Up to two integer or string arguments are kept inline, strings are copied and may be at most
+     * ErrorMessage::k_max_inline_text_size bytes long. Messages with other arguments are formatted right away.
+     *
+     * @param format The format string.
+     * @param arguments The arguments of the format string.
+     * @return The message.
+     */
+    template <typename... Arguments>
+    static ErrorMessage format(const std::format_string<Arguments...> format, Arguments&&... arguments) {
+        if constexpr (sizeof...(Arguments) <= k_max_deferred_arguments &&
+                      (isDeferrableArgument<std::remove_cvref_t<Arguments> >() && ...)) {
+            ErrorMessage message;
+            message.m_kind = Kind::Deferred;
+            message.m_format = std::string_view(format.get().data(), format.get().size());
+
+            std::size_t index = 0;
+            if ((message.m_arguments[index++].store(arguments) && ...)) {
+                return message;
+            }
+        }
+
+        return ErrorMessage(std::format(format, std::forward<Arguments>(arguments)...));
+    }
+
+    /**
+     * @brief Longest string argument ErrorMessage::format keeps inline.
+     */
+    static constexpr std::size_t k_max_inline_text_size = 54;
+
+    /**
+     * @brief Checks whether the message has no text. Messages created with ErrorMessage::format never count as empty.
+     */
+    bool empty() const {
+        switch (m_kind) {
+            case Kind::Empty:
+                return true;
+            case Kind::StaticText:
+            case Kind::Deferred:
+                return m_format.empty();
+            case Kind::SharedText:
+                return m_shared_text->empty();
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Writes the message to `out`.
+     * @param out The output iterator.
+     * @return The iterator past the written text.
+     */
+    template <typename OutputIt>
+    OutputIt formatTo(OutputIt out) const {
+        switch (m_kind) {
+            case Kind::Empty:
+                return out;
+            case Kind::StaticText:
+                return std::ranges::copy(m_format, out).out;
+            case Kind::SharedText:
+                return std::ranges::copy(*m_shared_text, out).out;
+            case Kind::Deferred:
+                return m_arguments[0].visit([this, out](const auto& first) {
+                    return m_arguments[1].visit([this, out, &first](const auto& second) {
+                        return std::vformat_to(out, m_format, std::make_format_args(first, second));
+                    });
+                });
+        }
+
+        return out;
+    }
+
+    /**
+     * @brief Formats the message into a string.
+     */
+    std::string str() const {
+        std::string text;
+        formatTo(std::back_inserter(text));
+        return text;
+    }
+
+    friend bool operator==(const ErrorMessage& message, const std::string_view text) {
+        switch (message.m_kind) {
+            case Kind::Empty:
+                return text.empty();
+            case Kind::StaticText:
+                return message.m_format == text;
+            case Kind::SharedText:
+                return *message.m_shared_text == text;
+            case Kind::Deferred:
+                return message.str() == text;
+        }
+
+        return false;
+    }
+
+    template <typename Traits>
+    friend std::basic_ostream<char, Traits>& operator<<(std::basic_ostream<char, Traits>& stream,
+                                                        const ErrorMessage& message) {
+        return stream << message.str();
+    }
+
+private:
+    enum class Kind : std::uint8_t {
+        Empty,
+        StaticText,  // m_format is the message
+        SharedText,  // m_shared_text is the message
+        Deferred,    // m_format is a format string with m_arguments
+    };
+
+    static constexpr std::size_t k_max_deferred_arguments = 2;
+
+    template <typename Argument>
+    static constexpr bool isDeferrableArgument() {
+        return (std::integral<Argument> && !std::same_as<Argument, bool> && !std::same_as<Argument, char>) ||
+               std::convertible_to<const Argument&, std::string_view>;
+    }
+
+    class DeferredArgument {
+    public:
+        template <typename Argument>
+        bool store(const Argument& argument) {
+            if constexpr (std::signed_integral<Argument>) {
+                m_type = Type::Signed;
+                m_signed = argument;
+            } else if constexpr (std::unsigned_integral<Argument>) {
+                m_type = Type::Unsigned;
+                m_unsigned = argument;
+            } else {
+                const std::string_view text(argument);
+                if (text.size() > k_max_inline_text_size) {
+                    return false;
+                }
+
+                m_type = Type::Text;
+                m_text_size = static_cast<std::uint8_t>(text.size());
+                std::memcpy(m_text.data(), text.data(), text.size());
+            }
+
+            return true;
+        }
+
+        // Unused arguments are passed as 0, std::format ignores arguments the format string does not refer to
+        template <typename Visitor>
+        auto visit(Visitor&& visitor) const {
+            switch (m_type) {
+                case Type::Signed:
+                    return visitor(m_signed);
+                case Type::Unsigned:
+                    return visitor(m_unsigned);
+                case Type::Text:
+                    return visitor(std::string_view(m_text.data(), m_text_size));
+                case Type::Unused:
+                    break;
+            }
+
+            return visitor(std::int64_t{0});
+        }
+
+    private:
+        enum class Type : std::uint8_t {
+            Unused,
+            Signed,
+            Unsigned,
+            Text,
+        };
+
+        // Initialized so that messages referencing a string literal can be created at compile time
+        union {
+            std::int64_t m_signed = 0;
+            std::uint64_t m_unsigned;
+            std::array<char, k_max_inline_text_size> m_text;
+        };
+
+        Type m_type = Type::Unused;
+        std::uint8_t m_text_size = 0;
+    };
+
+    Kind m_kind = Kind::Empty;
+    std::string_view m_format;
+    std::shared_ptr<const std::string> m_shared_text;
+    std::array<DeferredArgument, k_max_deferred_arguments> m_arguments{};
+};
+
 /**
  * @brief Represents a generic error structure within the InterProcessCourier library.
  *
@@ -66,11 +318,12 @@ struct Error {
     /**
      * @brief A descriptive message providing more details about the error.
      *
-     * This string can contain additional context, diagnostic information,
+     * This message can contain additional context, diagnostic information,
      * or a human-readable explanation of why the error occurred.
      * It complements the `type` field by offering more specific insights.
+     * It is formatted only when read, see ErrorMessage.
      */
-    std::string message;
+    ErrorMessage message;
 
     /**
      * @brief Default constructor.
@@ -82,14 +335,25 @@ struct Error {
     /**
      * @brief Constructs an Error object with a specified error type and an optional message.
      * @param error_type The specific error type from the `ErrorType` enumeration.
-     * @param error_message An optional string providing more details about the error.
+     * @param error_message An optional message providing more details about the error.
      */
-    explicit Error(ErrorType error_type, std::string error_message = "") :
+    explicit Error(ErrorType error_type, ErrorMessage error_message = {}) :
         type(error_type), message(std::move(error_message)) {
     }
 };
 }  // namespace ipcourier
 
+template <>
+struct std::formatter<ipcourier::ErrorMessage> {
+    static constexpr auto parse(const std::format_parse_context& ctx) {
+        return ctx.begin();
+    }
+
+    static auto format(const ipcourier::ErrorMessage& message, std::format_context& ctx) {
+        return message.formatTo(ctx.out());
+    }
+};
+
 template <ipcourier::IsEnum ErrorType>
 struct std::formatter<ipcourier::Error<ErrorType> > {
     static constexpr auto parse(const std::format_parse_context& ctx) {
@@ -97,12 +361,11 @@ struct std::formatter<ipcourier::Error<ErrorType> > {
     }
 
     auto format(const ipcourier::Error<ErrorType>& error, std::format_context& ctx) const {
-        const auto error_type_name = std::format("{}", error.type);
         if (error.message.empty()) {
-            return std::format_to(ctx.out(), "Error: Type {}", error_type_name);
+            return std::format_to(ctx.out(), "Error: Type {}", error.type);
         }
 
-        return std::format_to(ctx.out(), "Error: Type {}, Message: \"{}\"", error_type_name, error.message);
+        return std::format_to(ctx.out(), "Error: Type {}, Message: \"{}\"", error.type, error.message);
     }
 };
 
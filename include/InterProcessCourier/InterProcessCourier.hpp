@@ -18,11 +18,19 @@
 #ifndef INTER_PROCESS_COURIER_MAIN_HEADER_HPP
 #define INTER_PROCESS_COURIER_MAIN_HEADER_HPP
 
+#include <InterProcessCourier/CoalescingSyncClient.hpp>
+#include <InterProcessCourier/Codec.hpp>
+#include <InterProcessCourier/CourierRouter.hpp>
 #include <InterProcessCourier/Metadata.hpp>
 #include <InterProcessCourier/ProtobufInterface.hpp>
+#include <InterProcessCourier/RawMessage.hpp>
+#include <InterProcessCourier/Responder.hpp>
+#include <InterProcessCourier/ShardedSyncClient.hpp>
+#include <InterProcessCourier/ShardedSyncServer.hpp>
 #include <InterProcessCourier/SyncClient.hpp>
 #include <InterProcessCourier/SyncCommons.hpp>
 #include <InterProcessCourier/SyncServer.hpp>
+#include <InterProcessCourier/TrafficCapture.hpp>
 
 /**
  * @file InterProcessCourier.hpp
@@ -0,0 +1,117 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+/**
+ * @file RawMessage.hpp
+ * @brief Messages kept in their serialized form, for proxies that move messages without decoding them.
+ */
+
+#ifndef INTER_PROCESS_COURIER_RAW_MESSAGE_HPP
+#define INTER_PROCESS_COURIER_RAW_MESSAGE_HPP
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <InterProcessCourier/Codec.hpp>
+#include <InterProcessCourier/ProtobufInterface.hpp>
+#include <InterProcessCourier/detail/ProtobufTools.hpp>
+
+namespace ipcourier {
+class RawMessage;
+}  // namespace ipcourier
+
+namespace ipcourier::_detail {
+// Returns nothing if the payload has no type name delimiter
+std::optional<RawMessage> makeRawMessage(SerializedProtoPayload payload);
+
+SerializedProtoPayload takeRawMessagePayload(RawMessage&& message);
+
+const SerializedProtoPayload& getRawMessagePayload(const RawMessage& message);
+}  // namespace ipcourier::_detail
+
+namespace ipcourier {
+/**
+ * @brief A message in the form it travels over the socket: its type name and its encoded body.
+ *
+ * Nothing is parsed or serialized when a RawMessage is received, handed on or sent, so a proxy forwarding
+ * requests to another server only copies bytes.
+ *
+ * @see SyncServer::registerRawHandler
+ * @see SyncClient::sendRawRequest
+ */
+class RawMessage {
+public:
+    /**
+     * @brief Creates a message from a full Protocol Buffer type name and a body serialized as that type.
+     */
+    RawMessage(std::string_view type_name, std::string_view body);
+
+    /**
+     * @brief Encodes a message with its Codec.
+     */
+    template <IsCourierMessage MessageType>
+    static RawMessage fromMessage(const MessageType& message) {
+        auto payload = _detail::makePayloadFromMessage(message);
+        const auto type_name_size = _detail::getMessageTypeName<MessageType>().size();
+        return RawMessage(std::move(payload), type_name_size);
+    }
+
+    /**
+     * @brief Full name of the type of the body, e.g. `package.Message` for Protocol Buffer messages.
+     */
+    std::string_view getTypeName() const;
+
+    /**
+     * @brief The message encoded by the Codec of its type, the Protocol Buffer wire format by default.
+     */
+    std::string_view getBody() const;
+
+    /**
+     * @brief Decodes the body as `MessageType`.
+     *
+     * @return The message, nothing if the type name differs or the body cannot be decoded.
+     */
+    template <IsCourierMessage MessageType>
+    std::optional<MessageType> parse() const {
+        if (getTypeName() != _detail::getMessageTypeName<MessageType>()) {
+            return std::nullopt;
+        }
+
+        auto message = _detail::makeMessageFromBody<MessageType>(getBody());
+        if (!message.has_value()) {
+            return std::nullopt;
+        }
+
+        return std::move(message.value());
+    }
+
+private:
+    _detail::SerializedProtoPayload m_payload;
+    std::size_t m_type_name_size;
+
+    RawMessage(_detail::SerializedProtoPayload payload, std::size_t type_name_size);
+
+    friend std::optional<RawMessage> _detail::makeRawMessage(_detail::SerializedProtoPayload payload);
+    friend _detail::SerializedProtoPayload _detail::takeRawMessagePayload(RawMessage&& message);
+    friend const _detail::SerializedProtoPayload& _detail::getRawMessagePayload(const RawMessage& message);
+};
+}  // namespace ipcourier
+
+#endif  // INTER_PROCESS_COURIER_RAW_MESSAGE_HPP
@@ -0,0 +1,189 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+/**
+ * @file Responder.hpp
+ * @brief Defines the means for SyncServer handlers to complete a request after they returned,
+ * either explicitly through a Responder or by returning a coroutine Task.
+ */
+
+#ifndef INTER_PROCESS_COURIER_RESPONDER_HPP
+#define INTER_PROCESS_COURIER_RESPONDER_HPP
+
+#include <atomic>
+#include <coroutine>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include <InterProcessCourier/Codec.hpp>
+#include <InterProcessCourier/ProtobufInterface.hpp>
+#include <InterProcessCourier/detail/ProtobufTools.hpp>
+
+namespace ipcourier {
+class SyncServer;
+}  // namespace ipcourier
+
+namespace ipcourier::_detail {
+// Hands the response of a deferred request to the server, may be called from any thread
+using DeferredResponseCallback = std::function<void(SerializedProtoPayload)>;
+
+// Implemented by the server backends for the duration of a handler call, which may take the request over
+class ResponseDeferral {
+public:
+    virtual DeferredResponseCallback defer() = 0;
+
+protected:
+    ~ResponseDeferral() = default;
+};
+
+// Completes a deferred request once, a request that is never completed is answered with an error
+class DeferredResponse {
+public:
+    explicit DeferredResponse(DeferredResponseCallback callback);
+
+    DeferredResponse(const DeferredResponse&) = delete;
+
+    DeferredResponse& operator=(const DeferredResponse&) = delete;
+
+    ~DeferredResponse();
+
+    void complete(SerializedProtoPayload payload);
+
+private:
+    DeferredResponseCallback m_callback;
+    std::atomic<bool> m_completed = false;
+};
+}  // namespace ipcourier::_detail
+
+namespace ipcourier {
+/**
+ * @brief Completes a request whose handler returned before the response was known.
+ *
+ * Handlers registered with SyncServer::registerHandler taking a Responder receive one per request. They may
+ * store or copy it and call respond later from any thread, e.g. once a disk read or a call to another service
+ * finished, while the server goes on serving other requests. Only the first respond call of all copies has an
+ * effect. If the last copy is destroyed without responding, the client receives an error.
+ *
+ * All responders have to be completed or destroyed before the SyncServer is destroyed.
+ *
+ * @tparam ResponseType The type of the Protocol Buffer response message.
+ */
+template <IsCourierMessage ResponseType>
+class Responder {
+public:
+    explicit Responder(std::shared_ptr<_detail::DeferredResponse> deferred_response) :
+        m_deferred_response(std::move(deferred_response)) {
+    }
+
+    /**
+     * @brief Sends the response to the client. Safe to call from any thread.
+     *
+     * @param response The Protocol Buffer message answering the request.
+     */
+    void respond(const ResponseType& response) const {
+        m_deferred_response->complete(_detail::makePayloadFromMessage(response));
+    }
+
+private:
+    std::shared_ptr<_detail::DeferredResponse> m_deferred_response;
+};
+
+/**
+ * @brief Coroutine type of handlers that produce their response with `co_return`.
+ *
+ * A handler returning Task runs on the server thread until its first suspension. Whatever resumes the
+ * coroutine afterwards, usually a completion callback on another thread, continues it there, and the value of
+ * `co_return` is sent to the client as the response. An exception escaping the coroutine is answered with an
+ * error. The server does not provide awaitables itself, any awaitable of the application can be used.
+ *
+ * @tparam ResponseType The type of the Protocol Buffer response message.
+ */
+template <IsCourierMessage ResponseType>
+class Task {
+public:
+    struct promise_type {
+        std::optional<Responder<ResponseType> > responder;
+
+        Task get_return_object() {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        // Suspended until the server attached the responder
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        // The frame and with it the responder are destroyed once the coroutine finished
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+
+        void return_value(const ResponseType& response) {
+            responder->respond(response);
+        }
+
+        // Destroying the responder without a response answers the request with an error
+        void unhandled_exception() noexcept {
+        }
+    };
+
+    Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {
+    }
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            m_handle = std::exchange(other.m_handle, {});
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        destroy();
+    }
+
+private:
+    friend class SyncServer;
+
+    std::coroutine_handle<promise_type> m_handle;
+
+    explicit Task(const std::coroutine_handle<promise_type> handle) : m_handle(handle) {
+    }
+
+    void start(Responder<ResponseType> responder) && {
+        auto handle = std::exchange(m_handle, {});
+        handle.promise().responder.emplace(std::move(responder));
+        handle.resume();
+    }
+
+    // Only a coroutine that was never started is still owned by the Task
+    void destroy() {
+        if (m_handle) {
+            m_handle.destroy();
+        }
+    }
+};
+}  // namespace ipcourier
+
+#endif  // INTER_PROCESS_COURIER_RESPONDER_HPP
@@ -0,0 +1,151 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+/**
+ * @file ShardedSyncClient.hpp
+ * @brief Defines a client routing every request to one shard of a ShardedSyncServer by a key of the request.
+ */
+
+#ifndef INTER_PROCESS_COURIER_SHARDED_CLIENT_HPP
+#define INTER_PROCESS_COURIER_SHARDED_CLIENT_HPP
+
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <InterProcessCourier/SyncClient.hpp>
+#include <InterProcessCourier/detail/DetailFwd.hpp>
+
+namespace ipcourier {
+/**
+ * @brief A client holding one SyncClient per shard and sending each request to the shard owning its key.
+ *
+ * The key of a request is taken by the extractor registered for its type, requests with equal keys always reach
+ * the same shard. Shards are picked by consistent hashing over the shard socket paths, so adding or removing a
+ * shard only moves the keys of that shard, and every client process maps a key to the same shard. Like
+ * SyncClient, an instance must not be used from several threads at once.
+ *
+ * @see ShardedSyncServer
+ */
+class ShardedSyncClient {
+public:
+    /**
+     * @brief Type alias for a function returning the sharding key of a request of a given type.
+     *
+     * @tparam RequestType The type of the Protocol Buffer request message.
+     */
+    template <IsCourierMessage RequestType>
+    using KeyExtractorForSpecificType = std::function<std::string(const RequestType&)>;
+
+    /**
+     * @brief Constructs a client, nothing is connected until connect is called.
+     *
+     * @param shard_socket_addrs The socket paths of the shards, the same list as given to the ShardedSyncServer.
+     * @param client_options Settings applied to the connection to every shard. @see SyncClientOptions
+     */
+    ShardedSyncClient(std::vector<std::string> shard_socket_addrs, const SyncClientOptions& client_options);
+
+    ~ShardedSyncClient();
+
+    /**
+     * @brief Connects to every shard.
+     *
+     * @return SyncClientResult<void> The error of the first shard that could not be connected to, if any.
+     */
+    SyncClientResult<void> connect();
+
+    /**
+     * @brief Registers how the sharding key of `RequestType` requests is taken from them.
+     *
+     * Registering again for the same type replaces the extractor.
+     *
+     * @tparam RequestType The type of the Protocol Buffer request message.
+     * Must have a Codec, see IsCourierMessage.
+     * @param key_extractor Returns the key deciding the shard of a request, e.g. the cache key it reads.
+     */
+    template <IsCourierMessage RequestType>
+    void registerShardKey(KeyExtractorForSpecificType<RequestType> key_extractor) {
+        m_key_extractors[std::string(_detail::getMessageTypeName<RequestType>())] =
+            [key_extractor = std::move(key_extractor)](const void* request) {
+                return key_extractor(*static_cast<const RequestType*>(request));
+            };
+    }
+
+    /**
+     * @brief Sends a request to the shard owning its key, see SyncClient::sendRequest.
+     *
+     * @retval SyncClientError::ShardKeyNotRegistered If no key extractor was registered for `RequestType`.
+     */
+    template <IsCourierMessage RequestType, IsCourierMessage ResponseType>
+    SyncClientResult<ResponseType> sendRequest(const RequestType& request, const RequestOptions& request_options = {}) {
+        const auto shard = resolveShard(_detail::getMessageTypeName<RequestType>(), &request);
+        if (!shard.has_value()) {
+            return std::unexpected(shard.error());
+        }
+
+        return shard.value()->template sendRequest<RequestType, ResponseType>(request, request_options);
+    }
+
+    /**
+     * @brief Sends a one-way message to the shard owning its key, see SyncClient::post.
+     *
+     * @retval SyncClientError::ShardKeyNotRegistered If no key extractor was registered for `RequestType`.
+     */
+    template <IsCourierMessage RequestType>
+    SyncClientResult<void> post(const RequestType& request, const RequestOptions& request_options = {}) {
+        const auto shard = resolveShard(_detail::getMessageTypeName<RequestType>(), &request);
+        if (!shard.has_value()) {
+            return std::unexpected(shard.error());
+        }
+
+        return shard.value()->post(request, request_options);
+    }
+
+    /**
+     * @brief Gets the number of shards.
+     */
+    std::size_t getShardCount() const;
+
+    /**
+     * @brief Gets the index of the shard owning a key, in the list passed on construction.
+     */
+    std::size_t getShardIndex(std::string_view key) const;
+
+    /**
+     * @brief Gets the client of a shard, e.g. to register request-response pairs or to subscribe to its events.
+     */
+    SyncClient& getShard(std::size_t shard_index);
+
+private:
+    // Called with a pointer to a request of the type it was registered for
+    using KeyExtractor = std::function<std::string(const void*)>;
+
+    std::vector<std::unique_ptr<SyncClient> > m_shards;
+    std::unique_ptr<_detail::ConsistentHashRing> m_ring;
+    std::unordered_map<std::string, KeyExtractor> m_key_extractors;
+
+    SyncClientResult<SyncClient*> resolveShard(std::string_view type_name, const void* request);
+};
+}  // namespace ipcourier
+
+#endif  // INTER_PROCESS_COURIER_SHARDED_CLIENT_HPP
@@ -0,0 +1,95 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+/**
+ * @file ShardedSyncServer.hpp
+ * @brief Defines a server listening on several sockets, each served by its own thread and handlers.
+ */
+
+#ifndef INTER_PROCESS_COURIER_SHARDED_SERVER_HPP
+#define INTER_PROCESS_COURIER_SHARDED_SERVER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <InterProcessCourier/SyncServer.hpp>
+
+namespace ipcourier {
+/**
+ * @brief A set of independent SyncServer shards within one process.
+ *
+ * Every shard listens on its own socket and is served by its own thread, with handlers registered per shard.
+ * A stateful service gives each shard its own part of the state, so no locks are shared between cores. Clients
+ * pick the shard of a request by its key with ShardedSyncClient, which has to be given the same socket list in
+ * the same order.
+ *
+ * @code
+ * ShardedSyncServer server(shard_sockets, {});
+ * server.forEachShard([](SyncServer& shard, std::size_t) {
+ *     auto cache = std::make_shared<Cache>();
+ *     shard.registerHandler<GetRequest, GetResponse>([cache](const GetRequest& request) { ... });
+ * });
+ * server.start();
+ * @endcode
+ */
+class ShardedSyncServer {
+public:
+    /**
+     * @brief Creates one shard per socket, every shard is bound to its socket right away.
+     *
+     * @param shard_socket_addrs The socket paths of the shards, in the order clients hash over.
+     * @param server_options Settings applied to every shard, each shard captures traffic to its own file with its
+     * index appended to SyncServerOptions::traffic_capture's path, e.g. `requests.cap.0`. @see SyncServerOptions
+     */
+    ShardedSyncServer(const std::vector<std::string>& shard_socket_addrs, const SyncServerOptions& server_options);
+
+    ~ShardedSyncServer();
+
+    /**
+     * @brief Gets the number of shards.
+     */
+    std::size_t getShardCount() const;
+
+    /**
+     * @brief Gets a shard to register its handlers.
+     *
+     * @param shard_index Position of the socket of the shard in the list passed on construction.
+     */
+    SyncServer& getShard(std::size_t shard_index);
+
+    /**
+     * @brief Calls `setup` once per shard, e.g. to register handlers that capture state owned by that shard.
+     */
+    void forEachShard(const std::function<void(SyncServer& shard, std::size_t shard_index)>& setup);
+
+    /**
+     * @brief Starts every shard on its own thread and blocks until all of them stopped.
+     *
+     * @return SyncServerResult<void> The error of the first shard that failed, if any did.
+     */
+    SyncServerResult<void> start() const;
+
+private:
+    std::vector<std::unique_ptr<SyncServer> > m_shards;
+};
+}  // namespace ipcourier
+
+#endif  // INTER_PROCESS_COURIER_SHARDED_SERVER_HPP
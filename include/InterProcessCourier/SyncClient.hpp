@@ -24,11 +24,20 @@
 #ifndef INTER_PROCESS_COURIER_CLIENT_HPP
 #define INTER_PROCESS_COURIER_CLIENT_HPP
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <expected>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
+#include <InterProcessCourier/Codec.hpp>
 #include <InterProcessCourier/Error.hpp>
+#include <InterProcessCourier/RawMessage.hpp>
 #include <InterProcessCourier/SyncCommons.hpp>
 #include <InterProcessCourier/detail/DetailFwd.hpp>
 #include <InterProcessCourier/detail/ProtobufTools.hpp>
@@ -46,6 +55,14 @@ enum class SyncClientError {
     UnableToSendMessage,         ///< The client failed to send a message to the server.
     UnableToReceiveMessage,      ///< The client failed to receive a message from the server.
     UnableToParseReturnedProto,  ///< The client received a message but failed to parse it into a Protocol Buffer.
+    ServerOverloaded,            ///< The server rejected the request or connection because it is overloaded.
+    DeadlineExceeded,            ///< The deadline of the request passed before its response was received.
+    SendBufferFull,              ///< A one-way message was not queued because too much unsent data is pending.
+    MessageTooLarge,             ///< The request or its response exceeded the maximum message size.
+    ShardKeyNotRegistered,       ///< A sharded client has no key extractor for the request type.
+    HandlerNotRegistered,        ///< The server has no handler registered for the request type.
+    RequestRejected,             ///< The server failed to parse the request.
+    HandlerFailed,               ///< The handler of the request failed on the server, e.g. by throwing an exception.
 };
 
 /**
@@ -99,6 +116,81 @@ struct SyncClientOptions {
      */
     DuplicateRequestResponsePairRegistrationStrategy duplicate_registration_strategy =
         DuplicateRequestResponsePairRegistrationStrategy::IndicateIgnore;
+
+    /**
+     * @brief Socket type used to connect, has to match the SyncServerOptions::transport of the server.
+     * @see Transport
+     */
+    Transport transport = Transport::Stream;
+
+    /**
+     * @brief Largest request in bytes the client sends, larger ones fail with SyncClientError::MessageTooLarge
+     * without being sent.
+     */
+    std::size_t max_request_size = 16 * 1024 * 1024;
+
+    /**
+     * @brief Largest response in bytes the client accepts.
+     *
+     * A frame announcing a longer payload is rejected from its header alone with SyncClientError::MessageTooLarge,
+     * before any of it is buffered. The connection is closed then and has to be reestablished with connect.
+     */
+    std::size_t max_response_size = 16 * 1024 * 1024;
+
+    /**
+     * @brief Time spent spinning on the socket before a call blocks in the kernel, zero disables spinning.
+     *
+     * Meant for latency-critical callers on a dedicated core exchanging small messages. A response arriving
+     * within the budget is picked up without paying for the scheduler wakeup.
+     *
+     * @see SyncClient::getBusyPollStatistics
+     */
+    std::chrono::microseconds busy_poll_budget{0};
+
+    /**
+     * @brief How long one-way messages are held back to be sent together with the following ones, zero sends each
+     * right away.
+     *
+     * Meant for clients posting bursts of small messages, which then cost one write for the whole burst instead of
+     * one per message. There is no timer: held messages go out with the first post after the window or after
+     * SyncClientOptions::cork_max_bytes were collected, with the next request, or on SyncClient::flush. A client
+     * that stops posting has to call flush for the last messages of a burst to leave.
+     */
+    std::chrono::microseconds cork_window{0};
+
+    /**
+     * @brief Held back bytes after which a post sends them right away, see SyncClientOptions::cork_window.
+     */
+    std::size_t cork_max_bytes = 64 * 1024;
+
+    /**
+     * @brief Whether connect exchanges capabilities with the server, see SyncClient::getConnectionCapabilities.
+     *
+     * With ValidateRequestResponsePairStrategy::ServerReflection the hello is always exchanged: the server's answer
+     * carries the request-response mappings in place of the reflection request, so it takes no extra round trip.
+     * Otherwise enabling it adds one round trip to every connect. Servers predating the handshake are detected and
+     * served without it.
+     */
+    bool exchange_hello = false;
+};
+
+/**
+ * @brief Per-call settings of SyncClient::sendRequest.
+ */
+struct RequestOptions {
+    /**
+     * @brief Point in time after which the response is no longer of interest.
+     *
+     * The deadline travels with the request, so the server skips the handler of a request that expired while
+     * it was queued. `std::chrono::steady_clock::time_point::max()` means no deadline.
+     */
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+
+    /**
+     * @brief Priority class of this call, overriding the priority the server registered for the request type.
+     * @see RequestPriority
+     */
+    std::optional<RequestPriority> priority = std::nullopt;
 };
 
 /**
@@ -124,9 +216,14 @@ public:
     /**
      * @brief Attempts to establish a connection with the server at the specified socket address.
      *
+     * If the request-response mappings are reflected or SyncClientOptions::exchange_hello is set, the client and
+     * the server exchange their capabilities, in the same round trip that reflects the mappings.
+     *
      * @return SyncClientResult<void> A result indicating success or an error if the connection fails.
      * @retval SyncClientError::UnableToReflectMappings If the client failed to reflect the request-response mappings
      * from the server.
+     * @retval SyncClientError::ServerOverloaded If the server rejected the connection because it has reached its
+     * connection limit.
      */
     SyncClientResult<void> connect();
 
@@ -142,16 +239,16 @@ public:
      * \warning What this function returns depends on the `SyncClientOptions::duplicate_registration_strategy` setting.
      *
      * @tparam RequestType The Protocol Buffer message type that represents the request.
-     * Must derive from `google::protobuf::Message`.
+     * Must have a Codec, see IsCourierMessage.
      * @tparam ResponseType The Protocol Buffer message type that represents the expected response for `RequestType`.
-     * Must derive from `google::protobuf::Message`.
+     * Must have a Codec, see IsCourierMessage.
      *  @returns Boolean value, what it indicated depends on the `SyncClientOptions::duplicate_registration_strategy`
      * setting.
      */
-    template <IsDerivedFromProtoMessage RequestType, IsDerivedFromProtoMessage ResponseType>
+    template <IsCourierMessage RequestType, IsCourierMessage ResponseType>
     bool registerRequestResponsePair() {
-        const auto request_name = RequestType::descriptor()->full_name();
-        const auto response_name = ResponseType::descriptor()->full_name();
+        const auto request_name = std::string(_detail::getMessageTypeName<RequestType>());
+        const auto response_name = std::string(_detail::getMessageTypeName<ResponseType>());
 
         if (m_request_response_pairs.contains(request_name) &&
             m_client_options.validate_req_res_pair_strategy != ValidateRequestResponsePairStrategy::ServerReflection) {
@@ -168,9 +265,9 @@ public:
      * This templated method serializes the `RequestType` message, sends it to the server,
      * waits for a response, and then deserializes the response into a `ResponseType` message.
      *
-     * @tparam RequestType The type of the Protocol Buffer request message (must derive from google::protobuf::Message).
-     * @tparam ResponseType The expected type of the Protocol Buffer response message (must derive from
-     * google::protobuf::Message).
+     * @tparam RequestType The type of the Protocol Buffer request message (must have a Codec, see IsCourierMessage).
+     * @tparam ResponseType The expected type of the Protocol Buffer response message (must have a Codec, see
+     * IsCourierMessage).
      * @param request The Protocol Buffer message to send as a request.
      * @return SyncClientResult<ResponseType> A result containing the deserialized response message on success,
      * or an error if sending, receiving, or parsing fails.
@@ -182,39 +279,71 @@ public:
      * reception.
      * @retval SyncClientError::UnableToParseReturnedProto If the received payload could not be parsed into
      * `ResponseType`.
+     * @retval SyncClientError::ServerOverloaded If the server rejected the request because one of its admission
+     * limits was reached. The request was not processed and may be retried after backing off.
+     * @retval SyncClientError::MessageTooLarge If the request or the response exceeded the maximum message size of
+     * the client or the server.
      */
-    template <IsDerivedFromProtoMessage RequestType, IsDerivedFromProtoMessage ResponseType>
+    template <IsCourierMessage RequestType, IsCourierMessage ResponseType>
     SyncClientResult<ResponseType> sendRequest(const RequestType& request) {
-        if (m_client_options.validate_req_res_pair_strategy != ValidateRequestResponsePairStrategy::NoValidation) {
-            const auto request_name = RequestType::descriptor()->full_name();
-            const auto response_name = ResponseType::descriptor()->full_name();
-
-            auto it = m_request_response_pairs.find(request_name);
-
-            const auto found = it != m_request_response_pairs.end();
-            if (!found || it->second != response_name) {
-                const auto expected_response_name = found ? it->second : "<Not Registered>";
-                const auto strategy = m_client_options.validate_req_res_pair_strategy;
-
-                return std::unexpected(Error(
-                    SyncClientError::BadRequestToResponsePair,
-                    std::format(
-                        "Request type '{}' expects response type '{}', but '{}' was provided. Current strategy: {}",
-                        request_name,
-                        expected_response_name,
-                        response_name,
-                        strategy)));
-            }
+        return sendRequest<RequestType, ResponseType>(request, RequestOptions{});
+    }
+
+    /**
+     * @brief Sends a Protocol Buffer request and waits for its response at most until the given deadline.
+     *
+     * Behaves like sendRequest(const RequestType&), but gives up once `deadline` passes. The deadline travels
+     * with the request, so the server skips the handler of a request that expired while it was queued.
+     * A response arriving after the call gave up is discarded by the next call on this client.
+     *
+     * @code
+     * const auto result = client.sendRequest<Request, Response>(request,
+     *     std::chrono::steady_clock::now() + std::chrono::milliseconds(50));
+     * @endcode
+     *
+     * @tparam RequestType The type of the Protocol Buffer request message (must have a Codec, see IsCourierMessage).
+     * @tparam ResponseType The expected type of the Protocol Buffer response message (must have a Codec, see
+     * IsCourierMessage).
+     * @param request The Protocol Buffer message to send as a request.
+     * @param deadline Point in time after which the response is no longer of interest.
+     * `std::chrono::steady_clock::time_point::max()` means no deadline.
+     * @return SyncClientResult<ResponseType> Same as sendRequest(const RequestType&).
+     * @retval SyncClientError::DeadlineExceeded If the deadline passed before the response was received.
+     */
+    template <IsCourierMessage RequestType, IsCourierMessage ResponseType>
+    SyncClientResult<ResponseType> sendRequest(const RequestType& request,
+                                               const std::chrono::steady_clock::time_point deadline) {
+        return sendRequest<RequestType, ResponseType>(request, RequestOptions{.deadline = deadline});
+    }
+
+    /**
+     * @brief Sends a Protocol Buffer request with per-call settings such as deadline and priority.
+     *
+     * @tparam RequestType The type of the Protocol Buffer request message (must have a Codec, see IsCourierMessage).
+     * @tparam ResponseType The expected type of the Protocol Buffer response message (must have a Codec, see
+     * IsCourierMessage).
+     * @param request The Protocol Buffer message to send as a request.
+     * @param request_options Settings of this call. @see RequestOptions
+     * @return SyncClientResult<ResponseType> Same as sendRequest(const RequestType&).
+     * @retval SyncClientError::DeadlineExceeded If the deadline passed before the response was received.
+     */
+    template <IsCourierMessage RequestType, IsCourierMessage ResponseType>
+    SyncClientResult<ResponseType> sendRequest(const RequestType& request, const RequestOptions& request_options) {
+        const auto validation_result =
+            validateRequestResponsePair(std::string(_detail::getMessageTypeName<RequestType>()),
+                                        std::string(_detail::getMessageTypeName<ResponseType>()));
+        if (!validation_result.has_value()) {
+            return std::unexpected(validation_result.error());
         }
 
-        const auto serialized_request = _detail::makePayloadFromProto(request);
-        const auto send_and_receive_result = sendAndReceiveMessage(serialized_request);
+        const auto serialized_request = _detail::makePayloadFromMessage(request);
+        const auto send_and_receive_result = sendAndReceiveMessage(serialized_request, request_options);
         if (!send_and_receive_result.has_value()) {
             return std::unexpected(send_and_receive_result.error());
         }
 
         const auto response = send_and_receive_result.value();
-        const auto proto_parse_result = _detail::makeProtoFromPayload<ResponseType>(response);
+        const auto proto_parse_result = _detail::makeMessageFromPayload<ResponseType>(response);
         if (!proto_parse_result.has_value()) {
             return std::unexpected(
                 Error(SyncClientError::UnableToParseReturnedProto, proto_parse_result.error().message));
@@ -223,7 +352,180 @@ public:
         return proto_parse_result.value();
     }
 
+    /**
+     * @brief Registers a Protocol Buffer type as a one-way message type for validation.
+     *
+     * Counterpart of registerRequestResponsePair for types sent with post. Has no impact if
+     * SyncClientOptions::validate_req_res_pair_strategy is set to
+     * ValidateRequestResponsePairStrategy::ServerReflection, the server reports its one-way message types itself.
+     *
+     * @tparam RequestType The Protocol Buffer message type. Must have a Codec, see IsCourierMessage.
+     * @returns Boolean value, what it indicated depends on the `SyncClientOptions::duplicate_registration_strategy`
+     * setting.
+     */
+    template <IsCourierMessage RequestType>
+    bool registerOneWayRequest() {
+        const auto request_name = std::string(_detail::getMessageTypeName<RequestType>());
+        const auto response_name = std::string(_detail::k_one_way_response_name);
+
+        if (m_request_response_pairs.contains(request_name) &&
+            m_client_options.validate_req_res_pair_strategy != ValidateRequestResponsePairStrategy::ServerReflection) {
+            return registerDuplicateRequestResponsePair(request_name, response_name);
+        }
+
+        registerValidatedRequestResponsePair(request_name, response_name);
+        return true;
+    }
+
+    /**
+     * @brief Sends a one-way Protocol Buffer message without waiting for the server.
+     *
+     * The message is handled by a handler registered with the one-way overload of SyncServer::registerHandler.
+     * The server never replies, so the call returns as soon as the message is handed to the socket. If the
+     * socket cannot take it right away it is buffered in the client and written ahead of later messages, the
+     * call never blocks. Consequently success means the message was queued, not that it was handled.
+     *
+     * @tparam RequestType The type of the Protocol Buffer message (must have a Codec, see IsCourierMessage).
+     * @param request The Protocol Buffer message to send.
+     * @param request_options Settings of this message, a passed deadline makes the server drop it.
+     * @return SyncClientResult<void> A result indicating whether the message was queued.
+     * @retval SyncClientError::BadRequestToResponsePair If `RequestType` is not a registered one-way message type
+     * when the validation setting is enabled.
+     * @retval SyncClientError::SendBufferFull If the server does not keep up and too much unsent data is buffered
+     * already. The message was dropped.
+     * @retval SyncClientError::MessageTooLarge If the message exceeds SyncClientOptions::max_request_size.
+     * @retval SyncClientError::UnableToSendMessage If the connection is broken.
+     */
+    template <IsCourierMessage RequestType>
+    SyncClientResult<void> post(const RequestType& request, const RequestOptions& request_options = {}) {
+        const auto validation_result = validateRequestResponsePair(
+            std::string(_detail::getMessageTypeName<RequestType>()), std::string(_detail::k_one_way_response_name));
+        if (!validation_result.has_value()) {
+            return std::unexpected(validation_result.error());
+        }
+
+        return postMessage(_detail::makePayloadFromMessage(request), request_options);
+    }
+
+    /**
+     * @brief Sends a request that is already serialized and returns the response without parsing it.
+     *
+     * Nothing is parsed or serialized on the way, which lets a proxy forward requests it received with a
+     * SyncServer::registerRawHandler handler at the cost of copying bytes. When validation is enabled the
+     * request type has to be registered with a response, whatever type the server answers with is returned.
+     *
+     * @param request The serialized request.
+     * @param request_options Settings of this call. @see RequestOptions
+     * @return SyncClientResult<RawMessage> The serialized response on success, otherwise the same errors as
+     * sendRequest.
+     * @retval SyncClientError::BadRequestToResponsePair If the request type is not registered with a response
+     * when the validation setting is enabled.
+     * @retval SyncClientError::UnableToParseReturnedProto If the response carries no type name.
+     */
+    SyncClientResult<RawMessage> sendRawRequest(const RawMessage& request, const RequestOptions& request_options = {});
+
+    /**
+     * @brief Sends a one-way message that is already serialized, see post.
+     *
+     * @param request The serialized message.
+     * @param request_options Settings of this message, a passed deadline makes the server drop it.
+     * @return SyncClientResult<void> Same as post.
+     * @retval SyncClientError::BadRequestToResponsePair If the message type is not a registered one-way message
+     * type when the validation setting is enabled.
+     */
+    SyncClientResult<void> postRaw(const RawMessage& request, const RequestOptions& request_options = {});
+
+    /**
+     * @brief Subscribes to events of a specific Protocol Buffer type published with SyncServer::publish.
+     *
+     * Returns once the server acknowledged the subscription, every event published afterwards is delivered.
+     * Events are queued by the client as they arrive, also while waiting for responses, and handed to
+     * `handler` by dispatchEvents. Subscribing again to the same type replaces the handler.
+     *
+     * @tparam EventType The type of the Protocol Buffer event message (must have a Codec, see IsCourierMessage).
+     * @param handler The function to be called by dispatchEvents for every received `EventType` event.
+     * @param deadline Point in time after which waiting for the acknowledgement is given up.
+     * @return SyncClientResult<void> A result indicating whether the subscription is active.
+     * @retval SyncClientError::DeadlineExceeded If the server did not acknowledge in time.
+     * @retval SyncClientError::UnableToSendMessage If the connection is broken.
+     */
+    template <IsCourierMessage EventType>
+    SyncClientResult<void> subscribe(std::function<void(const EventType&)> handler,
+                                     const std::chrono::steady_clock::time_point deadline =
+                                         std::chrono::steady_clock::time_point::max()) {
+        const auto topic = std::string(_detail::getMessageTypeName<EventType>());
+        m_event_handlers[topic] = [handler = std::move(handler)](const _detail::SerializedProtoPayload& payload) {
+            // Events that cannot be parsed are skipped, there is no caller to report them to
+            const auto event = _detail::makeMessageFromPayload<EventType>(payload);
+            if (event.has_value()) {
+                handler(event.value());
+            }
+        };
+
+        const auto subscribe_result = sendSubscriptionChange(topic, true, deadline);
+        if (!subscribe_result.has_value()) {
+            m_event_handlers.erase(topic);
+        }
+
+        return subscribe_result;
+    }
+
+    /**
+     * @brief Ends the subscription to events of a specific Protocol Buffer type.
+     *
+     * Events of the type that were already received are dropped by the next dispatchEvents.
+     *
+     * @tparam EventType The type of the Protocol Buffer event message (must have a Codec, see IsCourierMessage).
+     * @param deadline Point in time after which waiting for the acknowledgement is given up.
+     * @return SyncClientResult<void> A result indicating whether the server acknowledged the change.
+     */
+    template <IsCourierMessage EventType>
+    SyncClientResult<void> unsubscribe(const std::chrono::steady_clock::time_point deadline =
+                                           std::chrono::steady_clock::time_point::max()) {
+        const auto topic = std::string(_detail::getMessageTypeName<EventType>());
+        m_event_handlers.erase(topic);
+        return sendSubscriptionChange(topic, false, deadline);
+    }
+
+    /**
+     * @brief Hands received events to the handlers passed to subscribe.
+     *
+     * Dispatches all events received so far. If there are none, waits for events at most until `deadline`,
+     * pass the current time to only dispatch what already arrived.
+     *
+     * @param deadline Point in time after which waiting for events is given up.
+     * @return SyncClientResult<std::size_t> The number of dispatched events, 0 if none arrived before the deadline.
+     * @retval SyncClientError::UnableToReceiveMessage If the connection is broken.
+     */
+    SyncClientResult<std::size_t> dispatchEvents(std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Sends the one-way messages held back by SyncClientOptions::cork_window, blocking until the socket
+     * accepted all of them.
+     *
+     * @retval SyncClientError::UnableToSendMessage If the connection is broken.
+     */
+    SyncClientResult<void> flush();
+
+    /**
+     * @brief How often waiting for the socket ended while spinning, see SyncClientOptions::busy_poll_budget.
+     */
+    BusyPollStatistics getBusyPollStatistics() const;
+
+    /**
+     * @brief What the last connect agreed on with the server.
+     *
+     * Requests larger than ConnectionCapabilities::max_request_size fail with SyncClientError::MessageTooLarge
+     * without being sent, before the server would close the connection over them.
+     *
+     * @return The capabilities, nothing if not connected yet, the server predates the handshake or no hello was
+     * exchanged, see SyncClientOptions::exchange_hello.
+     */
+    const std::optional<ConnectionCapabilities>& getConnectionCapabilities() const;
+
 private:
+    using EventHandler = std::function<void(const _detail::SerializedProtoPayload&)>;
+
     SyncClientOptions m_client_options;
     std::string m_socket_addr;
     std::unique_ptr<boost::asio::io_context> m_io_context;
@@ -231,15 +533,39 @@ private:
     std::unique_ptr<_detail::SyncUnixDomainClient> m_client;
 
     std::unordered_map<std::string, std::string> m_request_response_pairs;
+    std::unordered_map<std::string, EventHandler> m_event_handlers;
+
+    std::uint64_t m_next_request_id = 1;
+
+    std::optional<ConnectionCapabilities> m_connection_capabilities;
 
     bool registerDuplicateRequestResponsePair(const std::string& request_name, const std::string& response_name);
 
     void registerValidatedRequestResponsePair(const std::string& request_name, const std::string& response_name);
 
+    SyncClientResult<void> validateRequestResponsePair(const std::string& request_name,
+                                                       const std::string& response_name) const;
+
+    // Checks only the request side, the response of a raw request is not parsed into a fixed type
+    SyncClientResult<void> validateRawRequest(std::string_view request_name, bool one_way) const;
+
+    SyncClientResult<void> postMessage(const _detail::SerializedProtoPayload& serialized,
+                                       const RequestOptions& request_options);
+
     SyncClientResult<_detail::SerializedProtoPayload> sendAndReceiveMessage(
-        const _detail::SerializedProtoPayload& serialized) const;
+        const _detail::SerializedProtoPayload& serialized, const RequestOptions& request_options);
+
+    SyncClientResult<void> sendSubscriptionChange(const std::string& topic,
+                                                  bool subscribe,
+                                                  std::chrono::steady_clock::time_point deadline);
 
     SyncClientResult<void> reflectRequestResponseMappingPairs();
+
+    // Returns whether the server's hello carried the request-response mappings
+    SyncClientResult<bool> exchangeHello();
+
+    // Checks the limit the server announced in its hello, the own limit is checked when sending
+    SyncClientResult<void> checkRequestSize(const _detail::SerializedProtoPayload& serialized) const;
 };
 }  // namespace ipcourier
 
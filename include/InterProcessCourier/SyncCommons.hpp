@@ -23,6 +23,11 @@
 #ifndef INTER_PROCESS_COURIER_SYNCCOMMONS_HPP
 #define INTER_PROCESS_COURIER_SYNCCOMMONS_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
 namespace ipcourier {
 /**
  * @brief Defines strategies for handling duplicate request/response handler registrations.
@@ -37,6 +42,84 @@ enum class DuplicateRequestResponsePairRegistrationStrategy {
     IndicateIgnore,  ///< Same as SilentIgnore but return a boolean indicating success.
     Throw            ///< Throw std::invalid_argument if a pair was already registered, otherwise return true.
 };
+
+/**
+ * @brief Priority class deciding the order in which the server serves queued requests.
+ *
+ * The server always serves the highest non-empty class first. A class that was passed over too often while
+ * it had queued requests is served once anyway, so lower classes keep making progress under sustained load.
+ * The priority is declared per request type when registering the handler and may be overridden per call
+ * by the client.
+ *
+ * @see SyncServer::registerHandler
+ * @see RequestOptions::priority
+ */
+enum class RequestPriority : std::uint8_t {
+    Low,     ///< Bulk or background work that tolerates latency.
+    Normal,  ///< Default class.
+    High,    ///< Latency-critical, e.g. interactive requests.
+};
+
+/**
+ * @brief Socket type carrying messages between SyncClient and SyncServer. Both sides have to use the same one.
+ *
+ * @see SyncServerOptions::transport
+ * @see SyncClientOptions::transport
+ */
+enum class Transport {
+    Stream,     ///< SOCK_STREAM, messages of any size are reassembled from the byte stream.
+    SeqPacket,  ///< SOCK_SEQPACKET, every message is one kernel record received at once. Limited to 1 MiB.
+};
+
+/**
+ * @brief Outcome of the waits made in busy-poll mode.
+ *
+ * Mostly hits mean the spinning hides the scheduler wakeups, mostly misses mean it burns CPU for nothing and
+ * the budget should be lowered or disabled. Spinning adapts on its own as well: after a run of misses the
+ * following waits block right away for a while before spinning is tried again.
+ *
+ * @see SyncServerOptions::busy_poll_budget
+ * @see SyncClientOptions::busy_poll_budget
+ */
+struct BusyPollStatistics {
+    std::uint64_t spin_hits = 0;      ///< Waits that ended while spinning, without blocking in the kernel.
+    std::uint64_t spin_misses = 0;    ///< Waits that used up the budget and blocked afterwards.
+    std::uint64_t spins_skipped = 0;  ///< Waits that blocked without spinning because recent spins kept missing.
+};
+
+/**
+ * @brief Optional parts of the wire protocol, announced by both ends in the handshake made by SyncClient::connect.
+ *
+ * The values are bits of ConnectionCapabilities::features.
+ */
+enum class WireFeature : std::uint64_t {
+    OneWayMessages = 1U << 0U,     ///< SyncClient::post
+    Subscriptions = 1U << 1U,      ///< SyncClient::subscribe and SyncServer::publish
+    RequestPriorities = 1U << 2U,  ///< RequestOptions::priority is honoured by the server
+    Deadlines = 1U << 3U,          ///< RequestOptions::deadline travels with the request
+};
+
+/**
+ * @brief What a connected client and its server agreed on in the connect-time handshake.
+ *
+ * @see SyncClient::getConnectionCapabilities
+ */
+struct ConnectionCapabilities {
+    std::string server_library_version;
+    std::uint16_t protocol_version = 0;  ///< Highest wire protocol version both ends speak.
+    std::uint64_t features = 0;          ///< WireFeature bits both ends support.
+    std::size_t max_request_size = 0;    ///< Largest request the server accepts.
+    std::size_t max_response_size = 0;   ///< Largest response the server sends.
+
+    bool supports(const WireFeature feature) const {
+        return (features & static_cast<std::uint64_t>(feature)) != 0;
+    }
+};
 }  // namespace ipcourier
 
+namespace ipcourier::_detail {
+// Response type name under which one-way message types are registered and reflected
+constexpr std::string_view k_one_way_response_name;
+}  // namespace ipcourier::_detail
+
 #endif  // INTER_PROCESS_COURIER_SYNCCOMMONS_HPP
@@ -24,15 +24,23 @@
 #ifndef INTER_PROCESS_COURIER_SERVER_HPP
 #define INTER_PROCESS_COURIER_SERVER_HPP
 
+#include <chrono>
+#include <cstddef>
 #include <expected>
 #include <format>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
+#include <InterProcessCourier/Codec.hpp>
 #include <InterProcessCourier/Error.hpp>
+#include <InterProcessCourier/RawMessage.hpp>
+#include <InterProcessCourier/Responder.hpp>
 #include <InterProcessCourier/SyncCommons.hpp>
+#include <InterProcessCourier/TrafficCapture.hpp>
 #include <InterProcessCourier/detail/DetailFwd.hpp>
 #include <InterProcessCourier/detail/DuplicateRegistrationHandler.hpp>
 #include <InterProcessCourier/detail/ProtobufTools.hpp>
@@ -48,6 +56,8 @@ enum class SyncServerError {
     RuntimeError,                ///< An error occurred during the execution of a message handler.
     UnableToDeserializeMessage,  ///< The server failed to deserialize an incoming message into a Protocol Buffer.
     UnableToSerializeMessage,    ///< The server failed to serialize a response Protocol Buffer message.
+    ServerOverloaded,            ///< The request or connection was rejected because an admission limit was reached.
+    MessageTooLarge,             ///< The request or its response exceeded the configured maximum message size.
 };
 
 /**
@@ -61,6 +71,92 @@ enum class SyncServerError {
 template <typename SuccessType>
 using SyncServerResult = std::expected<SuccessType, Error<SyncServerError> >;
 
+/**
+ * @brief Defines the I/O backends that the SyncServer can use to serve its Unix Domain Socket.
+ * @see SyncServerOptions::backend
+ */
+enum class ServerBackend {
+    Asio,     ///< Portable Boost.Asio based backend. Always available.
+    IoUring,  ///< Linux io_uring based backend. Falls back to ServerBackend::Asio when unavailable.
+};
+
+/**
+ * @brief Limits bounding the amount of work the SyncServer accepts at the same time.
+ *
+ * Once a limit is reached the server does not queue new work. The offending connection or request is
+ * answered immediately with SyncServerError::ServerOverloaded, which clients receive as
+ * SyncClientError::ServerOverloaded, so they can back off while latency of already admitted work stays stable.
+ * A value of 0 disables the respective limit.
+ *
+ * @see SyncServerOptions::admission_limits
+ */
+struct ServerAdmissionLimits {
+    /**
+     * @brief Maximum number of concurrently connected clients.
+     *
+     * Connections above the limit are accepted, answered with an overload error and closed.
+     */
+    std::size_t max_connections = 0;
+
+    /**
+     * @brief Maximum number of requests that were received but whose response was not fully written yet.
+     */
+    std::size_t max_in_flight_requests = 0;
+
+    /**
+     * @brief Maximum total size in bytes of requests that were received but whose response was not fully written yet.
+     */
+    std::size_t max_queued_bytes = 0;
+};
+
+/**
+ * @brief Defines what the SyncServer does with a subscriber whose event backlog is full.
+ * @see SubscriptionOptions::slow_subscriber_policy
+ */
+enum class SlowSubscriberPolicy {
+    ConflateEvents,  ///< Drop the oldest queued event of the same topic, or else the oldest queued event.
+    Disconnect,      ///< Close the connection of the subscriber.
+};
+
+/**
+ * @brief Settings for events published with SyncServer::publish.
+ * @see SyncServerOptions::subscriptions
+ */
+struct SubscriptionOptions {
+    /**
+     * @brief Maximum number of events queued for a single subscriber that were not written to its socket yet.
+     *
+     * A subscriber that reads slower than events are published reaches this limit, at which point
+     * SubscriptionOptions::slow_subscriber_policy applies. Responses to requests are never conflated.
+     * A value of 0 disables the limit.
+     */
+    std::size_t max_queued_events = 256;
+
+    /**
+     * @brief What happens to a subscriber that reached SubscriptionOptions::max_queued_events.
+     * @see SlowSubscriberPolicy
+     */
+    SlowSubscriberPolicy slow_subscriber_policy = SlowSubscriberPolicy::ConflateEvents;
+};
+
+/**
+ * @brief Bounds of the response cache of a handler registered with SyncServer::registerCachedHandler.
+ *
+ * Once a bound is exceeded the least recently used responses are evicted. A value of 0 disables the respective
+ * bound, at least one of them should be set.
+ */
+struct ResponseCacheOptions {
+    /**
+     * @brief Maximum number of cached responses.
+     */
+    std::size_t max_entries = 1024;
+
+    /**
+     * @brief Maximum size in bytes of all cached requests and responses together.
+     */
+    std::size_t max_bytes = 0;
+};
+
 /**
  * @brief Structure to hold various configuration options for the SyncServer.
  * @see SyncServer
@@ -76,6 +172,89 @@ struct SyncServerOptions {
      */
     DuplicateRequestResponsePairRegistrationStrategy duplicate_registration_strategy =
         DuplicateRequestResponsePairRegistrationStrategy::IndicateIgnore;
+
+    /**
+     * @brief I/O backend used to accept connections and exchange messages.
+     *
+     * ServerBackend::IoUring batches accepts, receives and writes of all connections into a single
+     * submission queue using multishot accept, provided buffer rings and linked writes, which amortizes
+     * the syscalls per request. If the running kernel or the platform does not support the required
+     * io_uring features the server silently falls back to ServerBackend::Asio.
+     *
+     * @see ServerBackend
+     * @see SyncServer::getBackend
+     */
+    ServerBackend backend = ServerBackend::Asio;
+
+    /**
+     * @brief Socket type of the served socket, clients have to connect with the same SyncClientOptions::transport.
+     *
+     * Transport::SeqPacket receives every request with a single call and never sees a partial frame, but
+     * limits messages to 1 MiB. ServerBackend::IoUring does not support it and falls back to ServerBackend::Asio.
+     *
+     * @see Transport
+     */
+    Transport transport = Transport::Stream;
+
+    /**
+     * @brief Largest accepted serialized request in bytes.
+     *
+     * A frame announcing a longer payload is rejected from its header alone, before any of the payload is
+     * buffered. The client receives SyncClientError::MessageTooLarge and the connection is closed, since the
+     * rest of the stream cannot be resynchronized. This also bounds the receive buffer of every connection.
+     */
+    std::size_t max_request_size = 16 * 1024 * 1024;
+
+    /**
+     * @brief Largest serialized response in bytes, larger responses are replaced by a
+     * SyncServerError::MessageTooLarge error.
+     */
+    std::size_t max_response_size = 16 * 1024 * 1024;
+
+    /**
+     * @brief Limits for concurrent connections, in-flight requests and queued bytes.
+     * @see ServerAdmissionLimits
+     */
+    ServerAdmissionLimits admission_limits;
+
+    /**
+     * @brief Backlog handling for subscribers of published events.
+     * @see SubscriptionOptions
+     */
+    SubscriptionOptions subscriptions;
+
+    /**
+     * @brief Number of threads running request handlers, 0 runs them on the thread that called SyncServer::start.
+     *
+     * With handler threads the thread calling SyncServer::start only reads and writes frames. Decoded requests
+     * are handed to a work-stealing pool and their responses are written by the I/O thread once the handler
+     * returns, so a slow handler no longer stalls the other connections and CPU-heavy handlers scale across
+     * cores. Requests still leave the priority queue highest priority first. Handlers have to be safe to call
+     * concurrently in this mode.
+     */
+    std::size_t handler_threads = 0;
+
+    /**
+     * @brief Time the I/O thread spins for new work before it blocks in the kernel, zero disables spinning.
+     *
+     * Meant for latency-critical deployments with a dedicated core per server. Spinning saves the scheduler
+     * wakeup when a request arrives within the budget, at the cost of keeping the core busy while idle.
+     *
+     * @see SyncServer::getBusyPollStatistics
+     */
+    std::chrono::microseconds busy_poll_budget{0};
+
+    /**
+     * @brief Captures every received request with its arrival time and connection to a file, nothing if unset.
+     *
+     * The capture holds the requests as they were sent, so it can be replayed against a server with
+     * courier-replay or read with TrafficCaptureReader. The file is memory-mapped, capturing a request costs
+     * two copies on the I/O thread and no system call. Subscription changes are not captured. The shards of a
+     * ShardedSyncServer capture to one file each.
+     *
+     * @see SyncServer::getTrafficCaptureStatistics
+     */
+    std::optional<TrafficCaptureOptions> traffic_capture;
 };
 
 /**
@@ -85,6 +264,10 @@ struct SyncServerOptions {
  * This class provides a high-level interface for accepting client connections,
  * receiving Protocol Buffer requests, dispatching them to registered handlers,
  * and sending Protocol Buffer responses.
+ *
+ * A request that cannot be served, because no handler is registered for its type, it fails to parse or its
+ * handler throws an exception derived from `std::exception`, is answered with an error response that the
+ * client receives as the matching SyncClientError. The connection and the server keep running.
  */
 class SyncServer {
 public:
@@ -97,14 +280,53 @@ public:
      * @tparam RequestType The type of the Protocol Buffer request message.
      * @tparam ResponseType The type of the Protocol Buffer response message.
      */
-    template <IsDerivedFromProtoMessage RequestType, IsDerivedFromProtoMessage ResponseType>
+    template <IsCourierMessage RequestType, IsCourierMessage ResponseType>
     using HandlerForSpecificType = std::function<ResponseType(const RequestType&)>;
 
+    /**
+     * @brief Type alias for a handler of one-way messages of a given type, which produce no response.
+     *
+     * @tparam RequestType The type of the Protocol Buffer message.
+     */
+    template <IsCourierMessage RequestType>
+    using OneWayHandlerForSpecificType = std::function<void(const RequestType&)>;
+
+    /**
+     * @brief Type alias for a handler that completes requests of a given type through a Responder.
+     *
+     * @tparam RequestType The type of the Protocol Buffer request message.
+     * @tparam ResponseType The type of the Protocol Buffer response message.
+     */
+    template <IsCourierMessage RequestType, IsCourierMessage ResponseType>
+    using DeferredHandlerForSpecificType = std::function<void(const RequestType&, Responder<ResponseType>)>;
+
+    /**
+     * @brief Type alias for a coroutine handler that produces the response of a given type with `co_return`.
+     *
+     * @tparam RequestType The type of the Protocol Buffer request message.
+     * @tparam ResponseType The type of the Protocol Buffer response message.
+     */
+    template <IsCourierMessage RequestType, IsCourierMessage ResponseType>
+    using CoroutineHandlerForSpecificType = std::function<Task<ResponseType>(const RequestType&)>;
+
+    /**
+     * @brief Type alias for a handler receiving requests undecoded and returning an already serialized response.
+     *
+     * The handler is called with the full type name and the serialized body of the request.
+     */
+    using RawHandler = std::function<RawMessage(std::string_view type_name, std::string_view body)>;
+
+    /**
+     * @brief Type alias for a handler receiving one-way messages undecoded.
+     */
+    using RawOneWayHandler = std::function<void(std::string_view type_name, std::string_view body)>;
+
     /**
      * @brief Constructs a SyncServer instance.
      *
      * @param socket_addr The path to the Unix Domain Socket file to bind to and listen on.
      * @param server_options Various settings relating to the server. @see SyncServerOptions
+     * @throws std::runtime_error If SyncServerOptions::traffic_capture is set and its file cannot be created.
      */
     SyncServer(std::string socket_addr, SyncServerOptions server_options);
 
@@ -122,35 +344,244 @@ public:
      * \warning What this function returns depends on the `SyncServerOptions::duplicate_registration_strategy` setting.
      *
      * @tparam RequestType The type of the Protocol Buffer request message this handler processes.
-     * Must derive from `google::protobuf::Message`.
+     * Must have a Codec, see IsCourierMessage.
      * @tparam ResponseType The type of the Protocol Buffer response message this handler returns.
-     * Must derive from `google::protobuf::Message`.
+     * Must have a Codec, see IsCourierMessage.
      * @param handler The function to be called when a `RequestType` message is received.
+     * @param priority Priority class of `RequestType` requests, used unless the client sets one for the call.
+     * @see RequestPriority
      * @returns Boolean value, what it indicated depends on the `SyncServerOptions::duplicate_registration_strategy`
      * setting.
      */
-    template <IsDerivedFromProtoMessage RequestType, IsDerivedFromProtoMessage ResponseType>
-    bool registerHandler(HandlerForSpecificType<RequestType, ResponseType> handler) {
-        const auto request_name = RequestType::descriptor()->full_name();
-        const auto response_name = ResponseType::descriptor()->full_name();
-        if (m_handlers.contains(request_name)) {
-            return registerDuplicateRequestResponsePair(request_name, response_name, handler);
-        }
+    template <IsCourierMessage RequestType, IsCourierMessage ResponseType>
+    bool registerHandler(HandlerForSpecificType<RequestType, ResponseType> handler,
+                         const RequestPriority priority = RequestPriority::Normal) {
+        return registerGenericHandler(
+            std::string(_detail::getMessageTypeName<RequestType>()),
+            std::string(_detail::getMessageTypeName<ResponseType>()),
+            [handler = std::move(handler)](std::string_view, const std::string_view body, _detail::ResponseDeferral&)
+                -> GenericHandlerResult {
+                const auto request = parseRequest<RequestType>(body);
+                if (!request.has_value()) {
+                    return std::unexpected(request.error());
+                }
 
-        registerValidatedRequestResponsePair<RequestType, ResponseType>(request_name, response_name, handler);
-        return true;
+                const auto response = handler(request.value());
+                return _detail::makePayloadFromMessage(response);
+            },
+            priority);
     }
 
-    template <IsDerivedFromProtoMessage RequestType, IsDerivedFromProtoMessage ResponseType>
-    bool registerDuplicateRequestResponsePair(const std::string& request_name,
-                                              const std::string& response_name,
-                                              HandlerForSpecificType<RequestType, ResponseType> handler) {
-        const auto register_handler = [this, handler](const auto& handler_request_name,
-                                                      const auto& handler_response_name) {
-            this->registerValidatedRequestResponsePair(handler_request_name, handler_response_name, handler);
-        };
-        return _detail::registerDuplicateRequestResponsePair(
-            m_server_options.duplicate_registration_strategy, register_handler, request_name, response_name);
+    /**
+     * @brief Registers a handler whose responses are cached, for handlers that are pure functions of their request.
+     *
+     * Responses are kept in a least recently used cache keyed by the serialized request. A request whose bytes
+     * match a cached one is answered with the stored serialized response, without parsing the request, calling
+     * the handler or serializing the response. Only use it for handlers whose response depends on nothing but
+     * the request, e.g. capability queries or schema lookups. Requests that fail to parse are not cached.
+     *
+     * \warning What this function returns depends on the `SyncServerOptions::duplicate_registration_strategy` setting.
+     *
+     * @tparam RequestType The type of the Protocol Buffer request message this handler processes.
+     * Must have a Codec, see IsCourierMessage.
+     * @tparam ResponseType The type of the Protocol Buffer response message this handler returns.
+     * Must have a Codec, see IsCourierMessage.
+     * @param handler The function to be called when a `RequestType` message is received that is not cached.
+     * @param cache_options Bounds of the cache of this handler. @see ResponseCacheOptions
+     * @param priority Priority class of `RequestType` requests, used unless the client sets one for the call.
+     * @returns Boolean value, what it indicated depends on the `SyncServerOptions::duplicate_registration_strategy`
+     * setting.
+     */
+    template <IsCourierMessage RequestType, IsCourierMessage ResponseType>
+    bool registerCachedHandler(HandlerForSpecificType<RequestType, ResponseType> handler,
+                               const ResponseCacheOptions& cache_options,
+                               const RequestPriority priority = RequestPriority::Normal) {
+        return registerCachedGenericHandler(
+            std::string(_detail::getMessageTypeName<RequestType>()),
+            std::string(_detail::getMessageTypeName<ResponseType>()),
+            [handler = std::move(handler)](std::string_view, const std::string_view body, _detail::ResponseDeferral&)
+                -> GenericHandlerResult {
+                const auto request = parseRequest<RequestType>(body);
+                if (!request.has_value()) {
+                    return std::unexpected(request.error());
+                }
+
+                const auto response = handler(request.value());
+                return _detail::makePayloadFromMessage(response);
+            },
+            cache_options,
+            priority);
+    }
+
+    /**
+     * @brief Registers a handler that may respond to `RequestType` requests after it returned.
+     *
+     * The handler receives a Responder along with the request and returns right away, e.g. after starting a
+     * disk read or a call to another service. The server thread goes on serving other requests meanwhile, so
+     * a single server can keep many slow operations in flight. The response is sent once Responder::respond is
+     * called, from any thread. Reflection reports the pair like for a synchronous handler.
+     *
+     * \warning What this function returns depends on the `SyncServerOptions::duplicate_registration_strategy` setting.
+     *
+     * @tparam RequestType The type of the Protocol Buffer request message this handler processes.
+     * Must have a Codec, see IsCourierMessage.
+     * @tparam ResponseType The type of the Protocol Buffer response message passed to the Responder.
+     * Must have a Codec, see IsCourierMessage.
+     * @param handler The function to be called when a `RequestType` message is received.
+     * @param priority Priority class of `RequestType` requests, used unless the client sets one for the call.
+     * @returns Boolean value, what it indicated depends on the `SyncServerOptions::duplicate_registration_strategy`
+     * setting.
+     */
+    template <IsCourierMessage RequestType, IsCourierMessage ResponseType>
+    bool registerHandler(DeferredHandlerForSpecificType<RequestType, ResponseType> handler,
+                         const RequestPriority priority = RequestPriority::Normal) {
+        return registerGenericHandler(
+            std::string(_detail::getMessageTypeName<RequestType>()),
+            std::string(_detail::getMessageTypeName<ResponseType>()),
+            [handler = std::move(handler)](
+                std::string_view, const std::string_view body, _detail::ResponseDeferral& deferral)
+                -> GenericHandlerResult {
+                const auto request = parseRequest<RequestType>(body);
+                if (!request.has_value()) {
+                    return std::unexpected(request.error());
+                }
+
+                handler(request.value(),
+                        Responder<ResponseType>(std::make_shared<_detail::DeferredResponse>(deferral.defer())));
+                return std::nullopt;
+            },
+            priority);
+    }
+
+    /**
+     * @brief Registers a coroutine handler whose `co_return` value is the response to `RequestType` requests.
+     *
+     * The coroutine runs on the server thread until it first suspends, the server thread then goes on serving
+     * other requests. The response is sent once the coroutine finishes, on whichever thread resumed it.
+     *
+     * \warning What this function returns depends on the `SyncServerOptions::duplicate_registration_strategy` setting.
+     *
+     * @tparam RequestType The type of the Protocol Buffer request message this handler processes.
+     * Must have a Codec, see IsCourierMessage.
+     * @tparam ResponseType The type of the Protocol Buffer response message the coroutine returns.
+     * Must have a Codec, see IsCourierMessage.
+     * @param handler The coroutine to be called when a `RequestType` message is received.
+     * @param priority Priority class of `RequestType` requests, used unless the client sets one for the call.
+     * @see Task
+     * @returns Boolean value, what it indicated depends on the `SyncServerOptions::duplicate_registration_strategy`
+     * setting.
+     */
+    template <IsCourierMessage RequestType, IsCourierMessage ResponseType>
+    bool registerHandler(CoroutineHandlerForSpecificType<RequestType, ResponseType> handler,
+                         const RequestPriority priority = RequestPriority::Normal) {
+        return registerGenericHandler(
+            std::string(_detail::getMessageTypeName<RequestType>()),
+            std::string(_detail::getMessageTypeName<ResponseType>()),
+            [handler = std::move(handler)](
+                std::string_view, const std::string_view body, _detail::ResponseDeferral& deferral)
+                -> GenericHandlerResult {
+                const auto request = parseRequest<RequestType>(body);
+                if (!request.has_value()) {
+                    return std::unexpected(request.error());
+                }
+
+                auto task = handler(request.value());
+                std::move(task).start(
+                    Responder<ResponseType>(std::make_shared<_detail::DeferredResponse>(deferral.defer())));
+                return std::nullopt;
+            },
+            priority);
+    }
+
+    /**
+     * @brief Registers a handler for one-way messages of a specific Protocol Buffer type.
+     *
+     * One-way messages are sent by SyncClient::post. The server never writes anything back for them, neither
+     * a response nor an error, which saves the client a round trip per message. Reflection reports an empty
+     * response type name for `RequestType`.
+     *
+     * \warning What this function returns depends on the `SyncServerOptions::duplicate_registration_strategy` setting.
+     *
+     * @tparam RequestType The type of the Protocol Buffer message this handler processes.
+     * Must have a Codec, see IsCourierMessage.
+     * @param handler The function to be called when a `RequestType` message is received.
+     * @param priority Priority class of `RequestType` messages, used unless the client sets one for the call.
+     * @returns Boolean value, what it indicated depends on the `SyncServerOptions::duplicate_registration_strategy`
+     * setting.
+     */
+    template <IsCourierMessage RequestType>
+    bool registerHandler(OneWayHandlerForSpecificType<RequestType> handler,
+                         const RequestPriority priority = RequestPriority::Normal) {
+        return registerGenericHandler(
+            std::string(_detail::getMessageTypeName<RequestType>()),
+            std::string(_detail::k_one_way_response_name),
+            [handler = std::move(handler)](std::string_view, const std::string_view body, _detail::ResponseDeferral&)
+                -> GenericHandlerResult {
+                const auto request = parseRequest<RequestType>(body);
+                if (!request.has_value()) {
+                    return std::unexpected(request.error());
+                }
+
+                handler(request.value());
+                return _detail::SerializedProtoPayload{};
+            },
+            priority);
+    }
+
+    /**
+     * @brief Registers a handler that gets `request_name` requests without them being parsed.
+     *
+     * The handler sees the serialized body of the request and returns its response already serialized, the
+     * server neither parses nor serializes anything for these requests. Meant for proxies and routers that
+     * forward requests, e.g. with SyncClient::sendRawRequest, and for types only known at runtime. The
+     * returned message is sent as it is, its type should be `response_name`, which is what reflection reports
+     * for `request_name`.
+     *
+     * \warning What this function returns depends on the `SyncServerOptions::duplicate_registration_strategy` setting.
+     *
+     * @param request_name Full name of the Protocol Buffer request type this handler processes.
+     * @param response_name Full name of the Protocol Buffer type of the responses.
+     * @param handler The function to be called when a `request_name` message is received.
+     * @param priority Priority class of `request_name` requests, used unless the client sets one for the call.
+     * @returns Boolean value, what it indicated depends on the `SyncServerOptions::duplicate_registration_strategy`
+     * setting.
+     */
+    bool registerRawHandler(const std::string& request_name,
+                            const std::string& response_name,
+                            RawHandler handler,
+                            RequestPriority priority = RequestPriority::Normal);
+
+    /**
+     * @brief Registers a handler that gets one-way messages of type `request_name` without them being parsed.
+     *
+     * Counterpart of registerRawHandler for messages sent with SyncClient::post or SyncClient::postRaw.
+     *
+     * \warning What this function returns depends on the `SyncServerOptions::duplicate_registration_strategy` setting.
+     *
+     * @param request_name Full name of the Protocol Buffer type this handler processes.
+     * @param handler The function to be called when a `request_name` message is received.
+     * @param priority Priority class of `request_name` messages, used unless the client sets one for the call.
+     * @returns Boolean value, what it indicated depends on the `SyncServerOptions::duplicate_registration_strategy`
+     * setting.
+     */
+    bool registerRawOneWayHandler(const std::string& request_name,
+                                  RawOneWayHandler handler,
+                                  RequestPriority priority = RequestPriority::Normal);
+
+    /**
+     * @brief Publishes an event to every client subscribed to `EventType`.
+     *
+     * Clients subscribe with SyncClient::subscribe, the topic of an event is the full name of its type. The
+     * event is serialized into a single frame shared by all subscribers, so publishing costs the same no matter
+     * how many clients receive it. Subscribers that do not keep up are handled according to
+     * SyncServerOptions::subscriptions. May be called from any thread, also while start() is running.
+     *
+     * @tparam EventType The type of the Protocol Buffer event message. Must have a Codec, see IsCourierMessage.
+     * @param event The Protocol Buffer message to publish.
+     */
+    template <IsCourierMessage EventType>
+    void publish(const EventType& event) {
+        publishPayload(std::string(_detail::getMessageTypeName<EventType>()), _detail::makePayloadFromMessage(event));
     }
 
     /**
@@ -164,29 +595,92 @@ public:
      */
     SyncServerResult<void> start() const;
 
+    /**
+     * @brief Gets the I/O backend that is actually used by the server.
+     *
+     * May differ from SyncServerOptions::backend if the requested backend is not supported on the
+     * current platform or kernel.
+     *
+     * @return The backend serving the socket.
+     */
+    ServerBackend getBackend() const;
+
+    /**
+     * @brief How often the I/O thread found new work while spinning, see SyncServerOptions::busy_poll_budget.
+     *
+     * May be called from any thread, also while the server is running.
+     */
+    BusyPollStatistics getBusyPollStatistics() const;
+
+    /**
+     * @brief How many requests were captured, see SyncServerOptions::traffic_capture.
+     *
+     * May be called from any thread, also while the server is running.
+     */
+    TrafficCaptureStatistics getTrafficCaptureStatistics() const;
+
 private:
-    using GenericHandler = std::function<std::string(const BaseProtoType&)>;
+    // Holds nothing if the handler took the request over through the deferral and responds later
+    using GenericHandlerResult = SyncServerResult<std::optional<_detail::SerializedProtoPayload> >;
+
+    // Receives the type name and the still serialized body of the request
+    using GenericHandler =
+        std::function<GenericHandlerResult(std::string_view, std::string_view, _detail::ResponseDeferral&)>;
 
     SyncServerOptions m_server_options;
     std::string m_socket_addr;
     std::unique_ptr<boost::asio::io_context> m_io_context;
 
-    std::unordered_map<std::string, GenericHandler> m_handlers;
+    struct TransparentStringHash {
+        using is_transparent = void;
+
+        std::size_t operator()(const std::string_view value) const {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    std::unordered_map<std::string, GenericHandler, TransparentStringHash, std::equal_to<> > m_handlers;
+    std::unordered_map<std::string, RequestPriority, TransparentStringHash, std::equal_to<> > m_handler_priorities;
     std::unordered_map<std::string, std::string> m_request_response_pairs;
-    std::unique_ptr<_detail::SyncUnixDomainServer> m_server;
+    std::unique_ptr<_detail::TrafficCaptureWriter> m_traffic_capture;
+    std::unique_ptr<_detail::UnixDomainServerBackend> m_server;
+
+    template <IsCourierMessage RequestType>
+    static SyncServerResult<RequestType> parseRequest(const std::string_view body) {
+        auto request = _detail::makeMessageFromBody<RequestType>(body);
+        if (!request.has_value()) {
+            return std::unexpected(
+                Error(SyncServerError::UnableToDeserializeMessage, std::move(request.error().message)));
+        }
+
+        return std::move(request.value());
+    }
 
-    SyncServerResult<_detail::SerializedProtoPayload> acceptMessage(const _detail::SerializedProtoPayload& serialized);
+    GenericHandlerResult acceptMessage(const _detail::SerializedProtoPayload& serialized,
+                                       _detail::ResponseDeferral& deferral);
+
+    RequestPriority resolveRequestPriority(const _detail::SerializedProtoPayload& serialized) const;
+
+    // Answers the hello a client sends on connect with the server's capabilities
+    GenericHandlerResult answerHello(std::string_view client_hello_body) const;
+
+    void publishPayload(const std::string& topic, const _detail::SerializedProtoPayload& payload);
+
+    bool registerGenericHandler(const std::string& request_name,
+                                const std::string& response_name,
+                                GenericHandler handler,
+                                RequestPriority priority);
+
+    bool registerCachedGenericHandler(const std::string& request_name,
+                                      const std::string& response_name,
+                                      GenericHandler handler,
+                                      const ResponseCacheOptions& cache_options,
+                                      RequestPriority priority);
 
-    template <IsDerivedFromProtoMessage RequestType, IsDerivedFromProtoMessage ResponseType>
     void registerValidatedRequestResponsePair(const std::string& request_name,
                                               const std::string& response_name,
-                                              HandlerForSpecificType<RequestType, ResponseType> handler) {
-        m_handlers[request_name] = [handler = std::move(handler)](const BaseProtoType& msg) {
-            const auto response = handler(static_cast<const RequestType&>(msg));
-            return _detail::makePayloadFromProto(response);
-        };
-        m_request_response_pairs[request_name] = response_name;
-    }
+                                              GenericHandler handler,
+                                              RequestPriority priority);
 };
 }  // namespace ipcourier
 
@@ -214,6 +708,10 @@ private:
                 return "Unable to deserialize message";
             case ipcourier::SyncServerError::UnableToSerializeMessage:
                 return "Unable to serialize message";
+            case ipcourier::SyncServerError::ServerOverloaded:
+                return "Server overloaded";
+            case ipcourier::SyncServerError::MessageTooLarge:
+                return "Message too large";
 
             default:
                 return "<Unknown>";
@@ -0,0 +1,171 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+/**
+ * @file TrafficCapture.hpp
+ * @brief Defines the capture of the requests a SyncServer receives and the reader of the captured log.
+ */
+
+#ifndef INTER_PROCESS_COURIER_TRAFFIC_CAPTURE_HPP
+#define INTER_PROCESS_COURIER_TRAFFIC_CAPTURE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <format>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <InterProcessCourier/Error.hpp>
+#include <InterProcessCourier/SyncCommons.hpp>
+
+namespace ipcourier {
+/**
+ * @brief Enumeration of specific error codes for capturing traffic and reading captures.
+ */
+enum class TrafficCaptureError {
+    UnknownError,       ///< An unspecified error occurred.
+    UnableToOpenFile,   ///< The capture file could not be created, sized, opened or mapped.
+    InvalidFileFormat,  ///< The file is not a capture or was written by an incompatible version.
+};
+
+/**
+ * @brief Type alias for the result of capture operations.
+ *
+ * @tparam SuccessType The type returned on successful operation.
+ */
+template <typename SuccessType>
+using TrafficCaptureResult = std::expected<SuccessType, Error<TrafficCaptureError> >;
+
+/**
+ * @brief Settings of the capture of the requests a SyncServer receives.
+ *
+ * @see SyncServerOptions::traffic_capture
+ */
+struct TrafficCaptureOptions {
+    /**
+     * @brief File the captured requests are written to, an existing file is replaced.
+     */
+    std::string path;
+
+    /**
+     * @brief Size the file is mapped with. Requests arriving once it is full are counted but not captured.
+     *
+     * The file is truncated to the captured part when the server is destroyed, a capture cut short by a crash
+     * keeps the mapped size and still reads up to the last complete request.
+     */
+    std::size_t max_bytes = 256 * 1024 * 1024;
+};
+
+/**
+ * @brief How many requests were captured, see SyncServer::getTrafficCaptureStatistics.
+ */
+struct TrafficCaptureStatistics {
+    std::uint64_t captured_requests = 0;  ///< Requests written to the capture file.
+    std::uint64_t dropped_requests = 0;   ///< Requests that arrived after the capture file was full.
+};
+
+/**
+ * @brief A request as it was received by the server.
+ */
+struct CapturedRequest {
+    std::chrono::nanoseconds timestamp{0};    ///< Time of arrival since the capture started.
+    std::uint64_t connection_id = 0;          ///< Identifies the client connection within the capture.
+    bool one_way = false;                     ///< Sent with SyncClient::post, no response was expected.
+    std::optional<RequestPriority> priority;  ///< Priority chosen by the client, if any.
+    std::string_view payload;                 ///< Type name and body, valid as long as the reader exists.
+};
+
+/**
+ * @brief Reads the requests of a capture file in the order they arrived.
+ *
+ * The file is mapped, reading copies nothing.
+ *
+ * @see SyncServerOptions::traffic_capture
+ */
+class TrafficCaptureReader {
+public:
+    /**
+     * @brief Opens a capture file.
+     *
+     * @retval TrafficCaptureError::UnableToOpenFile If the file cannot be opened or mapped.
+     * @retval TrafficCaptureError::InvalidFileFormat If the file is not a capture.
+     */
+    static TrafficCaptureResult<TrafficCaptureReader> open(const std::string& path);
+
+    TrafficCaptureReader(TrafficCaptureReader&& other) noexcept;
+
+    TrafficCaptureReader& operator=(TrafficCaptureReader&& other) noexcept;
+
+    TrafficCaptureReader(const TrafficCaptureReader&) = delete;
+
+    TrafficCaptureReader& operator=(const TrafficCaptureReader&) = delete;
+
+    ~TrafficCaptureReader();
+
+    /**
+     * @brief Gets the next captured request, nothing once all were read.
+     */
+    std::optional<CapturedRequest> next();
+
+    /**
+     * @brief Gets the wall clock time the capture started at, CapturedRequest::timestamp counts from it.
+     */
+    std::chrono::system_clock::time_point getStartTime() const;
+
+private:
+    const char* m_data = nullptr;
+    std::size_t m_size = 0;
+    std::size_t m_offset = 0;
+    std::chrono::system_clock::time_point m_start_time;
+
+    TrafficCaptureReader(const char* data, std::size_t size);
+};
+}  // namespace ipcourier
+
+template <>
+struct std::formatter<ipcourier::TrafficCaptureError> {
+public:
+    static constexpr auto parse(const std::format_parse_context& ctx) {
+        return ctx.begin();
+    }
+
+    static auto format(const ipcourier::TrafficCaptureError error, std::format_context& ctx) {
+        return std::format_to(ctx.out(), "{}", convertTrafficCaptureErrorToString(error));
+    }
+
+private:
+    static constexpr std::string_view convertTrafficCaptureErrorToString(
+        const ipcourier::TrafficCaptureError error_type) {
+        switch (error_type) {
+            case ipcourier::TrafficCaptureError::UnknownError:
+                return "Unknown error";
+            case ipcourier::TrafficCaptureError::UnableToOpenFile:
+                return "Unable to open file";
+            case ipcourier::TrafficCaptureError::InvalidFileFormat:
+                return "Invalid file format";
+
+            default:
+                return "<Unknown>";
+        }
+    }
+};
+
+#endif  // INTER_PROCESS_COURIER_TRAFFIC_CAPTURE_HPP
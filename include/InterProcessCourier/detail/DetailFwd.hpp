@@ -19,8 +19,12 @@
 #define INTER_PROCESS_COURIER_DETAIL_FWD_HPP
 
 namespace ipcourier::_detail {
+class ConsistentHashRing;
 class SyncUnixDomainClient;
+class TrafficCaptureWriter;
+template <typename Protocol>
 class SyncUnixDomainServer;
+class UnixDomainServerBackend;
 }  // namespace ipcourier::_detail
 
 #endif  // INTER_PROCESS_COURIER_DETAIL_FWD_HPP
@@ -19,6 +19,8 @@
 #define INTER_PROCESS_COURIER_PROTOBUF_TOOLS_HPP
 
 #include <expected>
+#include <format>
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -37,8 +39,17 @@ enum class ProtoPayloadParseError {
 template <typename SuccessType>
 using ProtobufToolResult = std::expected<SuccessType, Error<ProtoPayloadParseError> >;
 
+// Type name and serialized body of a payload, both viewing into the payload
+struct ProtoPayloadParts {
+    std::string_view type_name;
+    std::string_view body;
+};
+
 SerializedProtoPayload createProtoPayload(std::string_view type_name, std::string_view serialized_data);
 
+// Returns nothing if the payload has no type name delimiter
+std::optional<ProtoPayloadParts> splitProtoPayload(std::string_view payload);
+
 template <IsDerivedFromProtoMessage ProtoType>
 SerializedProtoPayload makePayloadFromProto(const ProtoType& message) {
     std::string serialized_data;
@@ -51,18 +62,19 @@ template <IsDerivedFromProtoMessage ProtoType>
 ProtobufToolResult<ProtoType> makeProtoFromPayload(const SerializedProtoPayload& payload) {
     const auto delimiter_pos = payload.find(':');
     if (delimiter_pos == std::string::npos) {
-        const auto message = payload.size() > 128 ? payload.substr(0, 128) + "..." : payload;
-        return std::unexpected(
-            Error(ProtoPayloadParseError::InvalidFormat, std::format("Received message: {}", message)));
+        return std::unexpected(Error(ProtoPayloadParseError::InvalidFormat,
+                                     ErrorMessage::format("Received message: {}{}",
+                                                          std::string_view(payload).substr(0, 128),
+                                                          payload.size() > 128 ? "..." : "")));
     }
 
-    const auto type_name = payload.substr(0, delimiter_pos);
-    const auto serialized_data = payload.substr(delimiter_pos + 1);
+    const auto type_name = std::string_view(payload).substr(0, delimiter_pos);
+    const auto serialized_data = std::string_view(payload).substr(delimiter_pos + 1);
 
     if (type_name != ProtoType::descriptor()->full_name()) {
-        return std::unexpected(
-            Error(ProtoPayloadParseError::TypeMismatch,
-                  std::format("Received {} but expected {}", type_name, ProtoType::descriptor()->full_name())));
+        return std::unexpected(Error(
+            ProtoPayloadParseError::TypeMismatch,
+            ErrorMessage::format("Received {} but expected {}", type_name, ProtoType::descriptor()->full_name())));
     }
 
     ProtoType message;
@@ -0,0 +1,71 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef INTER_PROCESS_COURIER_BUFFERPOOL_HPP
+#define INTER_PROCESS_COURIER_BUFFERPOOL_HPP
+
+#include "UnixDomainProtocol.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace ipcourier::_detail {
+/*
+ * Keeps drained buffers for the next messages, so steady traffic reuses their capacity instead of allocating.
+ * Buffers that grew beyond k_retained_buffer_size are released rather than pinning their memory.
+ * Not thread safe, a pool belongs to the I/O thread of its owner.
+ */
+template <typename Buffer>
+class BufferPool {
+public:
+    explicit BufferPool(const std::size_t max_spare_count) : m_max_spare_count(max_spare_count) {
+        m_spares.reserve(max_spare_count);
+    }
+
+    // The buffer is empty, but keeps the capacity of its previous use
+    Buffer take() {
+        if (m_spares.empty()) {
+            return Buffer();
+        }
+
+        auto buffer = std::move(m_spares.back());
+        m_spares.pop_back();
+        return buffer;
+    }
+
+    void recycle(Buffer buffer) {
+        if (m_spares.size() >= m_max_spare_count || buffer.capacity() > k_retained_buffer_size) {
+            return;
+        }
+
+        buffer.clear();
+        m_spares.push_back(std::move(buffer));
+    }
+
+    std::size_t getSpareCount() const {
+        return m_spares.size();
+    }
+
+private:
+    std::size_t m_max_spare_count;
+    std::vector<Buffer> m_spares;
+};
+}  // namespace ipcourier::_detail
+
+#endif  // INTER_PROCESS_COURIER_BUFFERPOOL_HPP
@@ -0,0 +1,98 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef INTER_PROCESS_COURIER_BUSYPOLLER_HPP
+#define INTER_PROCESS_COURIER_BUSYPOLLER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <InterProcessCourier/SyncCommons.hpp>
+
+namespace ipcourier::_detail {
+// Tells the core that this is a spin loop, so a sibling hyperthread is not starved
+inline void relaxCpu() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Spinning is paused for a while once it kept missing, e.g. because the peer shares the core or is idle
+constexpr unsigned k_busy_poll_misses_before_backoff = 8;
+constexpr unsigned k_busy_poll_backoff_waits = 64;
+
+/*
+ * Spins on a readiness check for a bounded time before the owner blocks in the kernel, trading CPU for the
+ * scheduler wakeup latency. Polls are made by the owning thread only, the statistics may be read from any thread.
+ */
+class BusyPoller {
+public:
+    explicit BusyPoller(const std::chrono::microseconds budget) : m_budget(budget) {
+    }
+
+    bool isEnabled() const {
+        return m_budget > std::chrono::microseconds::zero();
+    }
+
+    // Returns whether is_ready returned true within the budget, the caller has to block otherwise
+    template <typename IsReady>
+    bool poll(IsReady&& is_ready) {
+        if (m_backoff_waits > 0) {
+            --m_backoff_waits;
+            m_spins_skipped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        const auto give_up_at = std::chrono::steady_clock::now() + m_budget;
+        while (!is_ready()) {
+            if (std::chrono::steady_clock::now() >= give_up_at) {
+                m_spin_misses.fetch_add(1, std::memory_order_relaxed);
+                if (++m_consecutive_misses >= k_busy_poll_misses_before_backoff) {
+                    m_consecutive_misses = 0;
+                    m_backoff_waits = k_busy_poll_backoff_waits;
+                }
+                return false;
+            }
+            relaxCpu();
+        }
+
+        m_consecutive_misses = 0;
+        m_spin_hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    BusyPollStatistics getStatistics() const {
+        return BusyPollStatistics{.spin_hits = m_spin_hits.load(std::memory_order_relaxed),
+                                  .spin_misses = m_spin_misses.load(std::memory_order_relaxed),
+                                  .spins_skipped = m_spins_skipped.load(std::memory_order_relaxed)};
+    }
+
+private:
+    std::chrono::microseconds m_budget;
+    unsigned m_consecutive_misses = 0;
+    unsigned m_backoff_waits = 0;
+    std::atomic<std::uint64_t> m_spin_hits = 0;
+    std::atomic<std::uint64_t> m_spin_misses = 0;
+    std::atomic<std::uint64_t> m_spins_skipped = 0;
+};
+}  // namespace ipcourier::_detail
+
+#endif  // INTER_PROCESS_COURIER_BUSYPOLLER_HPP
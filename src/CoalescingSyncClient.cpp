@@ -0,0 +1,123 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "ConnectionHealth.hpp"
+
+#include <exception>
+
+#include <InterProcessCourier/CoalescingSyncClient.hpp>
+
+namespace ipcourier {
+CoalescingSyncClient::CoalescingSyncClient(std::string socket_addr, CoalescingSyncClientOptions options) :
+    m_socket_addr(std::move(socket_addr)), m_options(std::move(options)) {
+}
+
+CoalescingSyncClient::~CoalescingSyncClient() = default;
+
+SyncClientResult<void> CoalescingSyncClient::connect() {
+    auto client = acquireClient();
+    if (!client.has_value()) {
+        return std::unexpected(client.error());
+    }
+
+    releaseClient(std::move(client.value()));
+    return {};
+}
+
+std::uint64_t CoalescingSyncClient::getCoalescedRequestCount() const {
+    return m_coalesced_request_count.load(std::memory_order_relaxed);
+}
+
+SyncClientResult<std::unique_ptr<SyncClient> > CoalescingSyncClient::acquireClient() {
+    {
+        const std::lock_guard lock(m_idle_clients_mutex);
+        if (!m_idle_clients.empty()) {
+            auto client = std::move(m_idle_clients.back());
+            m_idle_clients.pop_back();
+            return client;
+        }
+    }
+
+    auto client = std::make_unique<SyncClient>(m_socket_addr, m_options.client_options);
+    const auto connect_result = client->connect();
+    if (!connect_result.has_value()) {
+        return std::unexpected(connect_result.error());
+    }
+
+    return client;
+}
+
+void CoalescingSyncClient::releaseClient(std::unique_ptr<SyncClient> client,
+                                         const std::optional<SyncClientError> failure) {
+    if (failure.has_value() && !_detail::keepsConnection(failure.value())) {
+        return;
+    }
+
+    const std::lock_guard lock(m_idle_clients_mutex);
+    if (m_idle_clients.size() < m_options.max_idle_connections) {
+        m_idle_clients.push_back(std::move(client));
+    }
+}
+
+CoalescingSyncClient::CoalescedResult CoalescingSyncClient::callCoalesced(
+    std::string key,
+    const std::chrono::steady_clock::time_point deadline,
+    const std::function<CoalescedResult()>& call) {
+    std::promise<CoalescedResult> promise;
+    std::shared_future<CoalescedResult> in_flight_call;
+    {
+        const std::lock_guard lock(m_in_flight_calls_mutex);
+        const auto [it, inserted] = m_in_flight_calls.try_emplace(key);
+        if (inserted) {
+            it->second = promise.get_future().share();
+        } else {
+            in_flight_call = it->second;
+        }
+    }
+
+    if (in_flight_call.valid()) {
+        m_coalesced_request_count.fetch_add(1, std::memory_order_relaxed);
+        if (deadline != std::chrono::steady_clock::time_point::max() &&
+            in_flight_call.wait_until(deadline) == std::future_status::timeout) {
+            return nullptr;
+        }
+
+        return in_flight_call.get();
+    }
+
+    // The call is taken out before its result is published, later calls start a new request instead of joining
+    // one that is already answered
+    const auto finish_call = [this, &key] {
+        const std::lock_guard lock(m_in_flight_calls_mutex);
+        m_in_flight_calls.erase(key);
+    };
+
+    CoalescedResult result;
+    try {
+        result = call();
+    } catch (...) {
+        finish_call();
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    finish_call();
+    promise.set_value(result);
+    return result;
+}
+}  // namespace ipcourier
@@ -0,0 +1,65 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "ConsistentHashRing.hpp"
+
+#include <algorithm>
+#include <format>
+
+namespace ipcourier::_detail {
+std::uint64_t hashShardKey(const std::string_view key) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const auto character : key) {
+        hash ^= static_cast<unsigned char>(character);
+        hash *= 1099511628211ULL;
+    }
+
+    // FNV-1a alone leaves similar keys close together on the ring, the finalizer of splitmix64 spreads them
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebULL;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+ConsistentHashRing::ConsistentHashRing(const std::span<const std::string> node_names,
+                                       const std::size_t points_per_node) :
+    m_node_count(node_names.size()) {
+    m_points.reserve(node_names.size() * points_per_node);
+    for (std::size_t node = 0; node < node_names.size(); ++node) {
+        for (std::size_t point = 0; point < points_per_node; ++point) {
+            m_points.push_back({.hash = hashShardKey(std::format("{}#{}", node_names[node], point)), .node = node});
+        }
+    }
+
+    std::ranges::sort(m_points, [](const Point& lhs, const Point& rhs) {
+        return lhs.hash != rhs.hash ? lhs.hash < rhs.hash : lhs.node < rhs.node;
+    });
+}
+
+std::size_t ConsistentHashRing::getNode(const std::string_view key) const {
+    const auto key_hash = hashShardKey(key);
+    const auto it = std::ranges::lower_bound(m_points, key_hash, {}, &Point::hash);
+    return it == m_points.end() ? m_points.front().node : it->node;
+}
+
+std::size_t ConsistentHashRing::getNodeCount() const {
+    return m_node_count;
+}
+}  // namespace ipcourier::_detail
@@ -0,0 +1,62 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef INTER_PROCESS_COURIER_CONSISTENTHASHRING_HPP
+#define INTER_PROCESS_COURIER_CONSISTENTHASHRING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ipcourier::_detail {
+// Virtual points per node, enough to keep the share of every node within a few percent of the average
+constexpr std::size_t k_default_ring_points_per_node = 160;
+
+// FNV-1a with a final mix, fixed so that every client process maps a key to the same node
+std::uint64_t hashShardKey(std::string_view key);
+
+/*
+ * Maps keys to nodes such that adding or removing a node only moves the keys of that node. Every node owns
+ * points_per_node points on a 64-bit ring, placed by hashing the node name, and a key belongs to the first
+ * point at or after its own hash. Immutable after construction, so lookups are safe from any thread.
+ */
+class ConsistentHashRing {
+public:
+    explicit ConsistentHashRing(std::span<const std::string> node_names,
+                                std::size_t points_per_node = k_default_ring_points_per_node);
+
+    // Index of the node in the names passed on construction, the ring must not be empty
+    std::size_t getNode(std::string_view key) const;
+
+    std::size_t getNodeCount() const;
+
+private:
+    struct Point {
+        std::uint64_t hash = 0;
+        std::size_t node = 0;
+    };
+
+    std::size_t m_node_count;
+    std::vector<Point> m_points;
+};
+}  // namespace ipcourier::_detail
+
+#endif  // INTER_PROCESS_COURIER_CONSISTENTHASHRING_HPP
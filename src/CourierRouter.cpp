@@ -0,0 +1,216 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "ConnectionHealth.hpp"
+#include "Handshake.hpp"
+
+#include <InterProcessCourier/CourierRouter.hpp>
+
+#include "InternalRequests.pb.h"
+
+namespace ipcourier {
+static SyncServerError mapClientErrorToServerError(const SyncClientError client_error) {
+    if (client_error == SyncClientError::ServerOverloaded) {
+        return SyncServerError::ServerOverloaded;
+    }
+
+    if (client_error == SyncClientError::MessageTooLarge) {
+        return SyncServerError::MessageTooLarge;
+    }
+
+    if (client_error == SyncClientError::HandlerNotRegistered) {
+        return SyncServerError::HandlerNotRegistered;
+    }
+
+    if (client_error == SyncClientError::RequestRejected) {
+        return SyncServerError::UnableToDeserializeMessage;
+    }
+
+    return SyncServerError::RuntimeError;
+}
+
+static RawMessage makeBackendErrorResponse(const std::string& socket_addr, const Error<SyncClientError>& error) {
+    internal_request_proto::IPCInternal_ErrorResponse error_response;
+    error_response.set_error_type(static_cast<std::int32_t>(mapClientErrorToServerError(error.type)));
+    error_response.set_message(std::format("Backend {}: {}", socket_addr, error.message));
+    return RawMessage::fromMessage(error_response);
+}
+
+CourierRouter::CourierRouter(std::string socket_addr,
+                             std::vector<std::string> backend_socket_addrs,
+                             CourierRouterOptions router_options) :
+    m_router_options(std::move(router_options)), m_server(std::move(socket_addr), m_router_options.server_options) {
+    // Routes are only created for types a backend reported, validating them again per request is redundant
+    m_router_options.backend_options.validate_req_res_pair_strategy = ValidateRequestResponsePairStrategy::NoValidation;
+
+    for (auto& backend_socket_addr : backend_socket_addrs) {
+        auto backend = std::make_unique<Backend>();
+        backend->socket_addr = std::move(backend_socket_addr);
+        m_backends.push_back(std::move(backend));
+    }
+}
+
+CourierRouter::~CourierRouter() = default;
+
+CourierRouterResult<void> CourierRouter::discoverRoutes() {
+    using MappingReflectionRequest = internal_request_proto::IPCInternal_GetRequestResponseMappingPairsRequest;
+    using MappingReflectionResponse = internal_request_proto::IPCInternal_GetRequestResponseMappingPairsResponse;
+
+    for (const auto& backend : m_backends) {
+        auto client = std::make_unique<SyncClient>(backend->socket_addr, m_router_options.backend_options);
+        const auto connect_result = client->connect();
+        if (!connect_result.has_value()) {
+            return std::unexpected(
+                Error(CourierRouterError::UnableToReachBackend,
+                      std::format("Backend {}: {}", backend->socket_addr, connect_result.error().message)));
+        }
+
+        const auto mappings = client->sendRequest<MappingReflectionRequest, MappingReflectionResponse>({});
+        if (!mappings.has_value()) {
+            return std::unexpected(
+                Error(CourierRouterError::UnableToReflectRoutes,
+                      std::format("Backend {}: {}", backend->socket_addr, mappings.error().message)));
+        }
+
+        for (const auto& [request_name, response_name] : mappings->mappings()) {
+            // The router answers reflection and the hello itself, with the routes of all backends
+            if (request_name == MappingReflectionRequest::descriptor()->full_name() ||
+                request_name == _detail::k_hello_type_name) {
+                continue;
+            }
+
+            auto* routed_backend = backend.get();
+            const auto registered =
+                response_name == _detail::k_one_way_response_name
+                    ? m_server.registerRawOneWayHandler(
+                          request_name,
+                          [this, routed_backend](const std::string_view type_name, const std::string_view body) {
+                              forwardOneWayMessage(*routed_backend, RawMessage(type_name, body));
+                          })
+                    : m_server.registerRawHandler(
+                          request_name,
+                          response_name,
+                          [this, routed_backend](const std::string_view type_name, const std::string_view body) {
+                              return forwardRequest(*routed_backend, RawMessage(type_name, body));
+                          });
+
+            // Mirrors the duplicate registration strategy, the first backend keeps a route unless overridden
+            if (registered && (!m_routes.contains(request_name) ||
+                               m_router_options.server_options.duplicate_registration_strategy ==
+                                   DuplicateRequestResponsePairRegistrationStrategy::SilentOverride)) {
+                m_routes[request_name] = routed_backend;
+            }
+        }
+
+        releaseClient(*backend, std::move(client));
+    }
+
+    return {};
+}
+
+CourierRouterResult<void> CourierRouter::start() const {
+    const auto result = m_server.start();
+    if (!result.has_value()) {
+        return std::unexpected(Error(CourierRouterError::RuntimeError, result.error().message));
+    }
+
+    return {};
+}
+
+std::optional<std::string> CourierRouter::getRoute(const std::string_view request_name) const {
+    const auto it = m_routes.find(std::string(request_name));
+    if (it == m_routes.end()) {
+        return std::nullopt;
+    }
+
+    return it->second->socket_addr;
+}
+
+std::unique_ptr<SyncClient> CourierRouter::acquireClient(Backend& backend) const {
+    {
+        const std::lock_guard lock(backend.idle_clients_mutex);
+        if (!backend.idle_clients.empty()) {
+            auto client = std::move(backend.idle_clients.back());
+            backend.idle_clients.pop_back();
+            return client;
+        }
+    }
+
+    auto client = std::make_unique<SyncClient>(backend.socket_addr, m_router_options.backend_options);
+    if (!client->connect().has_value()) {
+        return nullptr;
+    }
+
+    return client;
+}
+
+void CourierRouter::releaseClient(Backend& backend, std::unique_ptr<SyncClient> client) const {
+    const std::lock_guard lock(backend.idle_clients_mutex);
+    if (backend.idle_clients.size() < m_router_options.max_idle_connections_per_backend) {
+        backend.idle_clients.push_back(std::move(client));
+    }
+}
+
+RawMessage CourierRouter::forwardRequest(Backend& backend, const RawMessage& request) const {
+    auto client = acquireClient(backend);
+    if (client == nullptr) {
+        return makeBackendErrorResponse(backend.socket_addr,
+                                        Error(SyncClientError::UnableToConnectToServer, "Unable to connect"));
+    }
+
+    auto response = client->sendRawRequest(request);
+    if (!response.has_value() && response.error().type == SyncClientError::UnableToSendMessage) {
+        // Kept connections are closed if the backend restarted, nothing was delivered so retrying is safe
+        {
+            const std::lock_guard lock(backend.idle_clients_mutex);
+            backend.idle_clients.clear();
+        }
+
+        client = acquireClient(backend);
+        if (client == nullptr) {
+            return makeBackendErrorResponse(backend.socket_addr, response.error());
+        }
+
+        response = client->sendRawRequest(request);
+    }
+
+    if (!response.has_value()) {
+        if (_detail::keepsConnection(response.error().type)) {
+            releaseClient(backend, std::move(client));
+        }
+
+        return makeBackendErrorResponse(backend.socket_addr, response.error());
+    }
+
+    releaseClient(backend, std::move(client));
+    return std::move(response.value());
+}
+
+void CourierRouter::forwardOneWayMessage(Backend& backend, const RawMessage& request) const {
+    auto client = acquireClient(backend);
+    if (client == nullptr) {
+        return;
+    }
+
+    // One-way messages have nobody to report a failure to, a broken connection is just not kept
+    const auto post_result = client->postRaw(request);
+    if (post_result.has_value() || _detail::keepsConnection(post_result.error().type)) {
+        releaseClient(backend, std::move(client));
+    }
+}
+}  // namespace ipcourier
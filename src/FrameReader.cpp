@@ -0,0 +1,114 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "FrameReader.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ipcourier::_detail {
+FrameReader::FrameReader(const std::size_t max_payload_length) : m_max_payload_length(max_payload_length) {
+}
+
+std::span<char> FrameReader::prepare(const std::size_t min_size) {
+    const auto buffered = getBufferedSize();
+
+    // Only the header of an oversized frame is looked at, its payload is never made room for
+    auto required_size = min_size;
+    if (buffered >= k_frame_header_size && !getOversizedFrameHeader().has_value()) {
+        const auto frame_size = k_frame_header_size + decodeFrameHeader(m_buffer.data() + m_begin).payload_length;
+        if (frame_size > buffered) {
+            required_size = std::max(required_size, frame_size - buffered);
+        }
+    }
+
+    // A buffer enlarged for an exceptionally large frame is released once that frame is consumed
+    if (buffered == 0 && m_buffer.size() > std::max(k_retained_buffer_size, required_size)) {
+        ProtocolMessageBuffer().swap(m_buffer);
+        m_begin = 0;
+        m_end = 0;
+    }
+
+    if (m_buffer.size() - m_end < required_size) {
+        // The unparsed rest is usually a partial frame, moving it to the front is cheaper than growing
+        if (m_begin > 0) {
+            std::memmove(m_buffer.data(), m_buffer.data() + m_begin, buffered);
+            m_begin = 0;
+            m_end = buffered;
+        }
+
+        // Doubling stops at the largest frame accepted, so a peer cannot make the buffer grow past it
+        if (m_buffer.size() - m_end < required_size) {
+            const auto max_frame_size = k_frame_header_size + m_max_payload_length;
+            m_buffer.resize(std::max(m_end + required_size, std::min(2 * m_buffer.size(), max_frame_size)));
+        }
+    }
+
+    return {m_buffer.data() + m_end, m_buffer.size() - m_end};
+}
+
+void FrameReader::commit(const std::size_t size) {
+    m_end += size;
+}
+
+std::optional<FrameReader::Frame> FrameReader::next() {
+    const auto buffered = getBufferedSize();
+    if (buffered < k_frame_header_size) {
+        return std::nullopt;
+    }
+
+    const auto header = decodeFrameHeader(m_buffer.data() + m_begin);
+    if (header.payload_length > m_max_payload_length || buffered - k_frame_header_size < header.payload_length) {
+        return std::nullopt;
+    }
+
+    const Frame frame{.header = header,
+                      .payload = std::string_view(m_buffer.data() + m_begin + k_frame_header_size,
+                                                  header.payload_length)};
+    m_begin += k_frame_header_size + header.payload_length;
+
+    // Once everything is parsed the next read starts at the front again, nothing has to be moved
+    if (m_begin == m_end) {
+        m_begin = 0;
+        m_end = 0;
+    }
+
+    return frame;
+}
+
+std::optional<FrameHeader> FrameReader::getOversizedFrameHeader() const {
+    if (getBufferedSize() < k_frame_header_size) {
+        return std::nullopt;
+    }
+
+    const auto header = decodeFrameHeader(m_buffer.data() + m_begin);
+    if (header.payload_length <= m_max_payload_length) {
+        return std::nullopt;
+    }
+
+    return header;
+}
+
+std::size_t FrameReader::getBufferedSize() const {
+    return m_end - m_begin;
+}
+
+std::size_t FrameReader::getCapacity() const {
+    return m_buffer.size();
+}
+}  // namespace ipcourier::_detail
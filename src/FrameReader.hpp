@@ -0,0 +1,72 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef INTER_PROCESS_COURIER_FRAMEREADER_HPP
+#define INTER_PROCESS_COURIER_FRAMEREADER_HPP
+
+#include "UnixDomainProtocol.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace ipcourier::_detail {
+/*
+ * Receive buffer of a connection. Whatever a single read returns is committed at once and all complete
+ * frames in it are parsed in place, so pipelined frames cost one read instead of two per frame.
+ */
+class FrameReader {
+public:
+    struct Frame {
+        FrameHeader header;
+        std::string_view payload;
+    };
+
+    // Frames announcing a longer payload are never buffered, see getOversizedFrameHeader
+    explicit FrameReader(std::size_t max_payload_length = std::numeric_limits<std::uint32_t>::max());
+
+    // Space for the next read of at least min_size bytes, enlarged so that the rest of a partially received
+    // frame fits as well. The buffer grows geometrically, but not beyond the largest frame accepted unless a
+    // single read needs it, and is trimmed back once an exceptionally large frame is consumed. Invalidates the
+    // payloads of all frames returned so far.
+    std::span<char> prepare(std::size_t min_size);
+
+    void commit(std::size_t size);
+
+    // The payload points into the buffer and stays valid until the next prepare
+    std::optional<Frame> next();
+
+    // Header of the next frame if its payload exceeds the maximum, the connection cannot be read past it
+    std::optional<FrameHeader> getOversizedFrameHeader() const;
+
+    std::size_t getBufferedSize() const;
+
+    std::size_t getCapacity() const;
+
+private:
+    std::size_t m_max_payload_length;
+    ProtocolMessageBuffer m_buffer;
+    std::size_t m_begin = 0;
+    std::size_t m_end = 0;
+};
+}  // namespace ipcourier::_detail
+
+#endif  // INTER_PROCESS_COURIER_FRAMEREADER_HPP
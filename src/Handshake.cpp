@@ -0,0 +1,165 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "Handshake.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include <InterProcessCourier/SyncCommons.hpp>
+
+namespace ipcourier::_detail {
+namespace {
+struct HelloHeader {
+    std::uint32_t magic = 0;
+    std::uint16_t header_size = 0;
+    std::uint16_t protocol_version = 0;
+    std::uint32_t flags = 0;
+    std::uint32_t library_version_size = 0;
+    std::uint64_t features = 0;
+    std::uint64_t max_request_size = 0;
+    std::uint64_t max_response_size = 0;
+    std::uint32_t mapping_count = 0;
+    std::uint32_t reserved = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<HelloHeader>);
+
+// "IPCH", tells a hello apart from a payload of a peer speaking something else
+constexpr std::uint32_t k_hello_magic = 0x48435049;
+
+constexpr std::uint32_t k_hello_flag_wants_mappings = 1U << 0U;
+constexpr std::uint32_t k_hello_flag_has_mappings = 1U << 1U;
+
+void appendValue(std::string& encoded, const std::uint32_t value) {
+    encoded.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Consumes sizeof(value) bytes from the front of encoded
+bool takeValue(std::string_view& encoded, std::uint32_t& value) {
+    if (encoded.size() < sizeof(value)) {
+        return false;
+    }
+
+    std::memcpy(&value, encoded.data(), sizeof(value));
+    encoded.remove_prefix(sizeof(value));
+    return true;
+}
+
+bool takeText(std::string_view& encoded, const std::uint32_t size, std::string& text) {
+    if (encoded.size() < size) {
+        return false;
+    }
+
+    text.assign(encoded.substr(0, size));
+    encoded.remove_prefix(size);
+    return true;
+}
+}  // namespace
+
+std::uint64_t getSupportedWireFeatures() {
+    return static_cast<std::uint64_t>(WireFeature::OneWayMessages) |
+           static_cast<std::uint64_t>(WireFeature::Subscriptions) |
+           static_cast<std::uint64_t>(WireFeature::RequestPriorities) |
+           static_cast<std::uint64_t>(WireFeature::Deadlines);
+}
+
+std::string encodeHello(const Hello& hello) {
+    HelloHeader header{.magic = k_hello_magic,
+                       .header_size = sizeof(HelloHeader),
+                       .protocol_version = hello.protocol_version,
+                       .flags = hello.wants_mappings ? k_hello_flag_wants_mappings : 0U,
+                       .library_version_size = static_cast<std::uint32_t>(hello.library_version.size()),
+                       .features = hello.features,
+                       .max_request_size = hello.max_request_size,
+                       .max_response_size = hello.max_response_size};
+    if (hello.mappings.has_value()) {
+        header.flags |= k_hello_flag_has_mappings;
+        header.mapping_count = static_cast<std::uint32_t>(hello.mappings->size());
+    }
+
+    std::string encoded(reinterpret_cast<const char*>(&header), sizeof(header));
+    encoded.append(hello.library_version);
+    if (hello.mappings.has_value()) {
+        for (const auto& [request_name, response_name] : hello.mappings.value()) {
+            appendValue(encoded, static_cast<std::uint32_t>(request_name.size()));
+            appendValue(encoded, static_cast<std::uint32_t>(response_name.size()));
+            encoded.append(request_name);
+            encoded.append(response_name);
+        }
+    }
+
+    return encoded;
+}
+
+std::optional<Hello> decodeHello(std::string_view encoded) {
+    // Fields appended by later versions are skipped, fields missing from earlier ones keep their defaults
+    std::uint32_t magic = 0;
+    std::uint16_t header_size = 0;
+    if (encoded.size() < offsetof(HelloHeader, header_size) + sizeof(header_size)) {
+        return std::nullopt;
+    }
+
+    std::memcpy(&magic, encoded.data() + offsetof(HelloHeader, magic), sizeof(magic));
+    std::memcpy(&header_size, encoded.data() + offsetof(HelloHeader, header_size), sizeof(header_size));
+    if (magic != k_hello_magic || header_size > encoded.size()) {
+        return std::nullopt;
+    }
+
+    std::array<char, sizeof(HelloHeader)> header_bytes{};
+    encoded.copy(header_bytes.data(), std::min(header_bytes.size(), std::size_t{header_size}));
+    encoded.remove_prefix(header_size);
+
+    HelloHeader header;
+    std::memcpy(&header, header_bytes.data(), sizeof(header));
+
+    Hello hello;
+    hello.protocol_version = header.protocol_version;
+    hello.features = header.features;
+    hello.max_request_size = header.max_request_size;
+    hello.max_response_size = header.max_response_size;
+    hello.wants_mappings = (header.flags & k_hello_flag_wants_mappings) != 0;
+    if (!takeText(encoded, header.library_version_size, hello.library_version)) {
+        return std::nullopt;
+    }
+
+    if ((header.flags & k_hello_flag_has_mappings) == 0) {
+        return hello;
+    }
+
+    auto& mappings = hello.mappings.emplace();
+    for (std::uint32_t index = 0; index < header.mapping_count; ++index) {
+        std::uint32_t request_name_size = 0;
+        std::uint32_t response_name_size = 0;
+        std::string request_name;
+        std::string response_name;
+        if (!takeValue(encoded, request_name_size) || !takeValue(encoded, response_name_size) ||
+            !takeText(encoded, request_name_size, request_name) ||
+            !takeText(encoded, response_name_size, response_name)) {
+            return std::nullopt;
+        }
+
+        mappings.emplace(std::move(request_name), std::move(response_name));
+    }
+
+    return hello;
+}
+}  // namespace ipcourier::_detail
@@ -0,0 +1,65 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef INTER_PROCESS_COURIER_HANDSHAKE_HPP
+#define INTER_PROCESS_COURIER_HANDSHAKE_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace ipcourier::_detail {
+// Request type of the hello, the server answers it with its own hello under the same type name
+constexpr std::string_view k_hello_type_name = "ipcourier.internal.Hello";
+
+// Raised whenever the framing changes in a way older peers cannot follow
+constexpr std::uint16_t k_wire_protocol_version = 1;
+
+/*
+ * Capabilities of one end of a connection. The client sends its hello right after connecting, the server
+ * answers with its own, and both then use the lower protocol version and the features both announced.
+ * A client asking for the request/response mappings gets them with the server's hello, which saves the
+ * separate reflection round trip.
+ */
+struct Hello {
+    std::uint16_t protocol_version = k_wire_protocol_version;
+    std::uint64_t features = 0;
+    std::uint64_t max_request_size = 0;
+    std::uint64_t max_response_size = 0;
+    std::string library_version;
+    bool wants_mappings = false;
+    std::optional<std::unordered_map<std::string, std::string> > mappings;
+};
+
+// WireFeature bits implemented by this build
+std::uint64_t getSupportedWireFeatures();
+
+/*
+ * Fixed size header in host byte order followed by the library version and the mappings, every mapping
+ * being the sizes of both names followed by the names. header_size lets later versions append fields that
+ * older peers skip.
+ */
+std::string encodeHello(const Hello& hello);
+
+// Returns nothing if the data is not a complete hello
+std::optional<Hello> decodeHello(std::string_view encoded);
+}  // namespace ipcourier::_detail
+
+#endif  // INTER_PROCESS_COURIER_HANDSHAKE_HPP
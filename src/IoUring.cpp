@@ -0,0 +1,238 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "IoUring.hpp"
+
+#if INTER_PROCESS_COURIER_IO_URING_AVAILABLE
+
+#include <cerrno>
+#include <cstring>
+#include <format>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace ipcourier::_detail {
+static void* mapRingRegion(const int ring_fd, const std::size_t size, const off_t offset) {
+    void* region = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, offset);
+    return region == MAP_FAILED ? nullptr : region;
+}
+
+template <typename T>
+static T* ringMember(void* ring_region, const std::uint32_t offset) {
+    return reinterpret_cast<T*>(static_cast<char*>(ring_region) + offset);
+}
+
+IoUringResult<std::unique_ptr<IoUring> > IoUring::create(const unsigned entries) {
+    io_uring_params params{};
+    const auto ring_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (ring_fd < 0) {
+        return std::unexpected(Error(IoUringError::SetupFailed, std::strerror(errno)));
+    }
+
+    auto ring = std::unique_ptr<IoUring>(new IoUring());
+    ring->m_ring_fd = ring_fd;
+    ring->m_sq_entries = params.sq_entries;
+
+    ring->m_sq_ring_size = params.sq_off.array + (params.sq_entries * sizeof(unsigned));
+    ring->m_cq_ring_size = params.cq_off.cqes + (params.cq_entries * sizeof(io_uring_cqe));
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        ring->m_sq_ring_size = std::max(ring->m_sq_ring_size, ring->m_cq_ring_size);
+    }
+
+    ring->m_sq_ring = mapRingRegion(ring_fd, ring->m_sq_ring_size, IORING_OFF_SQ_RING);
+    if (ring->m_sq_ring == nullptr) {
+        return std::unexpected(Error(IoUringError::MemoryMappingFailed, std::strerror(errno)));
+    }
+
+    if (single_mmap) {
+        ring->m_cq_ring = ring->m_sq_ring;
+    } else {
+        ring->m_cq_ring = mapRingRegion(ring_fd, ring->m_cq_ring_size, IORING_OFF_CQ_RING);
+        if (ring->m_cq_ring == nullptr) {
+            return std::unexpected(Error(IoUringError::MemoryMappingFailed, std::strerror(errno)));
+        }
+    }
+
+    ring->m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    ring->m_sqes = static_cast<io_uring_sqe*>(mapRingRegion(ring_fd, ring->m_sqes_size, IORING_OFF_SQES));
+    if (ring->m_sqes == nullptr) {
+        return std::unexpected(Error(IoUringError::MemoryMappingFailed, std::strerror(errno)));
+    }
+
+    ring->m_sq_head = ringMember<unsigned>(ring->m_sq_ring, params.sq_off.head);
+    ring->m_sq_tail = ringMember<unsigned>(ring->m_sq_ring, params.sq_off.tail);
+    ring->m_sq_mask = ringMember<unsigned>(ring->m_sq_ring, params.sq_off.ring_mask);
+    ring->m_sq_array = ringMember<unsigned>(ring->m_sq_ring, params.sq_off.array);
+    ring->m_cq_head = ringMember<unsigned>(ring->m_cq_ring, params.cq_off.head);
+    ring->m_cq_tail = ringMember<unsigned>(ring->m_cq_ring, params.cq_off.tail);
+    ring->m_cq_mask = ringMember<unsigned>(ring->m_cq_ring, params.cq_off.ring_mask);
+    ring->m_cqes = ringMember<io_uring_cqe>(ring->m_cq_ring, params.cq_off.cqes);
+    ring->m_local_sq_tail = *ring->m_sq_tail;
+
+    return ring;
+}
+
+IoUring::~IoUring() {
+    if (m_sqes != nullptr) {
+        munmap(m_sqes, m_sqes_size);
+    }
+    if (m_cq_ring != nullptr && m_cq_ring != m_sq_ring) {
+        munmap(m_cq_ring, m_cq_ring_size);
+    }
+    if (m_sq_ring != nullptr) {
+        munmap(m_sq_ring, m_sq_ring_size);
+    }
+    if (m_ring_fd >= 0) {
+        close(m_ring_fd);
+    }
+}
+
+int IoUring::getFileDescriptor() const {
+    return m_ring_fd;
+}
+
+unsigned IoUring::getFreeSubmissionEntries() const {
+    const auto head = std::atomic_ref(*m_sq_head).load(std::memory_order_acquire);
+    return m_sq_entries - (m_local_sq_tail - head);
+}
+
+IoUringResult<io_uring_sqe*> IoUring::getSubmissionEntry() {
+    if (getFreeSubmissionEntries() == 0) {
+        const auto submit_result = submit();
+        if (!submit_result.has_value()) {
+            return std::unexpected(submit_result.error());
+        }
+    }
+
+    const auto index = m_local_sq_tail & *m_sq_mask;
+    m_sq_array[index] = index;
+    ++m_local_sq_tail;
+
+    auto* entry = &m_sqes[index];
+    std::memset(entry, 0, sizeof(io_uring_sqe));
+    return entry;
+}
+
+IoUringResult<void> IoUring::submit() {
+    return submitAndWait(0);
+}
+
+IoUringResult<void> IoUring::submitAndWait(const unsigned wait_count) {
+    const auto published_tail = std::atomic_ref(*m_sq_tail).load(std::memory_order_relaxed);
+    const auto to_submit = m_local_sq_tail - published_tail;
+    std::atomic_ref(*m_sq_tail).store(m_local_sq_tail, std::memory_order_release);
+
+    if (to_submit == 0 && wait_count == 0) {
+        return {};
+    }
+
+    return enter(to_submit, wait_count);
+}
+
+IoUringResult<void> IoUring::enter(const unsigned to_submit, const unsigned wait_count) {
+    const unsigned flags = wait_count > 0 ? IORING_ENTER_GETEVENTS : 0;
+    while (true) {
+        const auto result = syscall(__NR_io_uring_enter, m_ring_fd, to_submit, wait_count, flags, nullptr, 0);
+        if (result >= 0) {
+            return {};
+        }
+
+        if (errno != EINTR) {
+            return std::unexpected(Error(IoUringError::SubmissionFailed, std::strerror(errno)));
+        }
+    }
+}
+
+IoUringResult<std::unique_ptr<ProvidedBufferRing> > ProvidedBufferRing::create(const IoUring& ring,
+                                                                                const std::uint16_t group_id,
+                                                                                const unsigned buffer_count,
+                                                                                const std::size_t buffer_size) {
+    if (buffer_count == 0 || (buffer_count & (buffer_count - 1)) != 0) {
+        return std::unexpected(Error(IoUringError::RegistrationFailed,
+                                     std::format("Buffer count must be a power of two, got {}", buffer_count)));
+    }
+
+    auto buffer_ring = std::unique_ptr<ProvidedBufferRing>(new ProvidedBufferRing());
+    buffer_ring->m_group_id = group_id;
+    buffer_ring->m_buffer_count = buffer_count;
+    buffer_ring->m_buffer_size = buffer_size;
+    buffer_ring->m_buffer_ring_size = buffer_count * sizeof(io_uring_buf);
+
+    void* region =
+        mmap(nullptr, buffer_ring->m_buffer_ring_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (region == MAP_FAILED) {
+        return std::unexpected(Error(IoUringError::MemoryMappingFailed, std::strerror(errno)));
+    }
+
+    buffer_ring->m_buffer_entries = static_cast<io_uring_buf*>(region);
+    buffer_ring->m_buffer_ring_tail = &static_cast<io_uring_buf_ring*>(region)->tail;
+    *buffer_ring->m_buffer_ring_tail = 0;
+    buffer_ring->m_buffers = std::make_unique_for_overwrite<char[]>(buffer_count * buffer_size);
+
+    io_uring_buf_reg registration{};
+    registration.ring_addr = reinterpret_cast<std::uint64_t>(region);
+    registration.ring_entries = buffer_count;
+    registration.bgid = group_id;
+
+    const auto result = syscall(
+        __NR_io_uring_register, ring.getFileDescriptor(), IORING_REGISTER_PBUF_RING, &registration, 1);
+    if (result < 0) {
+        return std::unexpected(Error(IoUringError::RegistrationFailed, std::strerror(errno)));
+    }
+    buffer_ring->m_ring_fd = ring.getFileDescriptor();
+
+    for (unsigned buffer_id = 0; buffer_id < buffer_count; ++buffer_id) {
+        buffer_ring->recycleBuffer(static_cast<std::uint16_t>(buffer_id));
+    }
+
+    return buffer_ring;
+}
+
+ProvidedBufferRing::~ProvidedBufferRing() {
+    if (m_ring_fd >= 0) {
+        io_uring_buf_reg registration{};
+        registration.bgid = m_group_id;
+        syscall(__NR_io_uring_register, m_ring_fd, IORING_UNREGISTER_PBUF_RING, &registration, 1);
+    }
+    if (m_buffer_entries != nullptr) {
+        munmap(m_buffer_entries, m_buffer_ring_size);
+    }
+}
+
+std::uint16_t ProvidedBufferRing::getGroupId() const {
+    return m_group_id;
+}
+
+std::span<const char> ProvidedBufferRing::getBuffer(const std::uint16_t buffer_id, const std::size_t length) const {
+    return {m_buffers.get() + (buffer_id * m_buffer_size), length};
+}
+
+void ProvidedBufferRing::recycleBuffer(const std::uint16_t buffer_id) {
+    const auto tail = *m_buffer_ring_tail;
+    auto& entry = m_buffer_entries[tail & (m_buffer_count - 1)];
+    entry.addr = reinterpret_cast<std::uint64_t>(m_buffers.get() + (buffer_id * m_buffer_size));
+    entry.len = static_cast<std::uint32_t>(m_buffer_size);
+    entry.bid = buffer_id;
+
+    std::atomic_ref(*m_buffer_ring_tail).store(static_cast<std::uint16_t>(tail + 1), std::memory_order_release);
+}
+}  // namespace ipcourier::_detail
+
+#endif  // INTER_PROCESS_COURIER_IO_URING_AVAILABLE
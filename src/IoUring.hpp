@@ -0,0 +1,164 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef INTER_PROCESS_COURIER_IOURING_HPP
+#define INTER_PROCESS_COURIER_IOURING_HPP
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+
+// Headers older than Linux 6.0 lack multishot receive, the provided buffer rings and multishot accept the backend
+// relies on predate it
+#if defined(IORING_RECV_MULTISHOT) && defined(IORING_ACCEPT_MULTISHOT)
+#define INTER_PROCESS_COURIER_IO_URING_AVAILABLE 1
+#else
+#define INTER_PROCESS_COURIER_IO_URING_AVAILABLE 0
+#endif
+
+#if INTER_PROCESS_COURIER_IO_URING_AVAILABLE
+
+#include <atomic>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+
+#include <InterProcessCourier/Error.hpp>
+
+namespace ipcourier::_detail {
+enum class IoUringError {
+    SetupFailed,
+    MemoryMappingFailed,
+    RegistrationFailed,
+    SubmissionFailed,
+};
+
+template <typename SuccessType>
+using IoUringResult = std::expected<SuccessType, Error<IoUringError> >;
+
+// Minimal io_uring wrapper built directly on top of the kernel interface, so that no additional
+// third party dependency is needed. Not thread safe, meant to be owned by a single event loop.
+class IoUring {
+public:
+    static IoUringResult<std::unique_ptr<IoUring> > create(unsigned entries);
+
+    IoUring(const IoUring&) = delete;
+
+    IoUring& operator=(const IoUring&) = delete;
+
+    ~IoUring();
+
+    int getFileDescriptor() const;
+
+    unsigned getFreeSubmissionEntries() const;
+
+    // Submits pending entries first if the submission queue is full.
+    IoUringResult<io_uring_sqe*> getSubmissionEntry();
+
+    IoUringResult<void> submit();
+
+    IoUringResult<void> submitAndWait(unsigned wait_count);
+
+    bool hasCompletions() const {
+        return std::atomic_ref(*m_cq_head).load(std::memory_order_relaxed) !=
+               std::atomic_ref(*m_cq_tail).load(std::memory_order_acquire);
+    }
+
+    template <typename Callback>
+    unsigned forEachCompletion(Callback&& callback) {
+        unsigned processed = 0;
+        auto head = std::atomic_ref(*m_cq_head).load(std::memory_order_relaxed);
+        const auto tail = std::atomic_ref(*m_cq_tail).load(std::memory_order_acquire);
+        while (head != tail) {
+            const auto completion = m_cqes[head & *m_cq_mask];
+            std::atomic_ref(*m_cq_head).store(++head, std::memory_order_release);
+            callback(completion);
+            ++processed;
+        }
+
+        return processed;
+    }
+
+private:
+    int m_ring_fd = -1;
+    unsigned m_sq_entries = 0;
+
+    void* m_sq_ring = nullptr;
+    std::size_t m_sq_ring_size = 0;
+    void* m_cq_ring = nullptr;
+    std::size_t m_cq_ring_size = 0;
+    io_uring_sqe* m_sqes = nullptr;
+    std::size_t m_sqes_size = 0;
+
+    unsigned* m_sq_head = nullptr;
+    unsigned* m_sq_tail = nullptr;
+    unsigned* m_sq_mask = nullptr;
+    unsigned* m_sq_array = nullptr;
+    unsigned* m_cq_head = nullptr;
+    unsigned* m_cq_tail = nullptr;
+    unsigned* m_cq_mask = nullptr;
+    io_uring_cqe* m_cqes = nullptr;
+
+    unsigned m_local_sq_tail = 0;
+
+    IoUring() = default;
+
+    IoUringResult<void> enter(unsigned to_submit, unsigned wait_count);
+};
+
+// Ring of kernel-selected receive buffers (IORING_REGISTER_PBUF_RING). The kernel picks a free buffer
+// for every completed receive, the owner hands it back with recycleBuffer() once the data was consumed.
+class ProvidedBufferRing {
+public:
+    static IoUringResult<std::unique_ptr<ProvidedBufferRing> > create(const IoUring& ring,
+                                                                       std::uint16_t group_id,
+                                                                       unsigned buffer_count,
+                                                                       std::size_t buffer_size);
+
+    ProvidedBufferRing(const ProvidedBufferRing&) = delete;
+
+    ProvidedBufferRing& operator=(const ProvidedBufferRing&) = delete;
+
+    ~ProvidedBufferRing();
+
+    std::uint16_t getGroupId() const;
+
+    std::span<const char> getBuffer(std::uint16_t buffer_id, std::size_t length) const;
+
+    void recycleBuffer(std::uint16_t buffer_id);
+
+private:
+    int m_ring_fd = -1;
+    std::uint16_t m_group_id = 0;
+    unsigned m_buffer_count = 0;
+    std::size_t m_buffer_size = 0;
+
+    // Entries are addressed through io_uring_buf directly, as the flexible array declaration of
+    // io_uring_buf_ring does not have the same layout in C++ as in C.
+    io_uring_buf* m_buffer_entries = nullptr;
+    std::uint16_t* m_buffer_ring_tail = nullptr;
+    std::size_t m_buffer_ring_size = 0;
+    std::unique_ptr<char[]> m_buffers;
+
+    ProvidedBufferRing() = default;
+};
+}  // namespace ipcourier::_detail
+
+#endif  // INTER_PROCESS_COURIER_IO_URING_AVAILABLE
+
+#endif  // INTER_PROCESS_COURIER_IOURING_HPP
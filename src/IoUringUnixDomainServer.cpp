@@ -0,0 +1,843 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "IoUringUnixDomainServer.hpp"
+
+#if INTER_PROCESS_COURIER_IO_URING_AVAILABLE
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace ipcourier::_detail {
+constexpr unsigned k_io_uring_queue_entries = 256;
+constexpr std::uint16_t k_receive_buffer_group_id = 0;
+constexpr unsigned k_receive_buffer_count = 128;
+constexpr std::size_t k_receive_buffer_size = 16 * 1024;
+constexpr unsigned k_max_sends_per_chain = k_io_uring_queue_entries / 2;
+constexpr std::size_t k_spare_request_buffers = 64;
+
+constexpr unsigned k_user_data_operation_shift = 56;
+constexpr std::uint64_t k_user_data_connection_mask = (std::uint64_t{1} << k_user_data_operation_shift) - 1;
+
+template <typename Operation>
+static std::uint64_t encodeUserData(const Operation operation, const std::uint64_t connection_id) {
+    return (static_cast<std::uint64_t>(operation) << k_user_data_operation_shift) |
+           (connection_id & k_user_data_connection_mask);
+}
+
+static std::string describeErrno(const int error_number) {
+    return std::strerror(error_number);
+}
+
+UnixDomainServerResult<std::unique_ptr<IoUringUnixDomainServer> > IoUringUnixDomainServer::create(
+    const std::string& socket_path,
+    RequestHandler request_handler,
+    RequestPriorityResolver priority_resolver,
+    TrafficCaptureWriter* traffic_capture,
+    const SyncServerOptions& server_options) {
+    auto server = std::unique_ptr<IoUringUnixDomainServer>(new IoUringUnixDomainServer(
+        std::move(request_handler), std::move(priority_resolver), traffic_capture, socket_path, server_options));
+
+    auto ring_result = IoUring::create(k_io_uring_queue_entries);
+    if (!ring_result.has_value()) {
+        return std::unexpected(Error(UnixDomainServerError::GeneralServerError, ring_result.error().message));
+    }
+    server->m_ring = std::move(ring_result.value());
+
+    auto buffer_ring_result = ProvidedBufferRing::create(
+        *server->m_ring, k_receive_buffer_group_id, k_receive_buffer_count, k_receive_buffer_size);
+    if (!buffer_ring_result.has_value()) {
+        return std::unexpected(Error(UnixDomainServerError::GeneralServerError, buffer_ring_result.error().message));
+    }
+    server->m_buffer_ring = std::move(buffer_ring_result.value());
+
+    server->m_wake_fd = eventfd(0, EFD_CLOEXEC);
+    if (server->m_wake_fd < 0) {
+        return std::unexpected(Error(UnixDomainServerError::GeneralServerError, describeErrno(errno)));
+    }
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        return std::unexpected(Error(UnixDomainServerError::GeneralServerError, "Socket path is too long"));
+    }
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+    server->m_listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (server->m_listen_fd < 0) {
+        return std::unexpected(Error(UnixDomainServerError::GeneralServerError, describeErrno(errno)));
+    }
+
+    if (bind(server->m_listen_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        return std::unexpected(Error(UnixDomainServerError::GeneralServerError, describeErrno(errno)));
+    }
+
+    return server;
+}
+
+IoUringUnixDomainServer::IoUringUnixDomainServer(RequestHandler request_handler,
+                                                 RequestPriorityResolver priority_resolver,
+                                                 TrafficCaptureWriter* traffic_capture,
+                                                 std::string socket_path,
+                                                 const SyncServerOptions& server_options) :
+    m_request_handler(std::move(request_handler)), m_priority_resolver(std::move(priority_resolver)),
+    m_traffic_capture(traffic_capture), m_socket_path(std::move(socket_path)),
+    m_admission_controller(server_options.admission_limits),
+    m_request_pool(k_spare_request_buffers), m_subscription_options(server_options.subscriptions),
+    m_max_request_size(server_options.max_request_size), m_max_response_size(server_options.max_response_size),
+    m_busy_poller(server_options.busy_poll_budget) {
+    if (server_options.handler_threads > 0) {
+        m_handler_executor = std::make_unique<WorkStealingExecutor>(server_options.handler_threads);
+    }
+}
+
+IoUringUnixDomainServer::~IoUringUnixDomainServer() {
+    m_handler_executor.reset();
+
+    for (const auto& [connection_id, connection] : m_connections) {
+        close(connection.fd);
+        if (connection.admitted) {
+            m_admission_controller.releaseConnection();
+        }
+    }
+
+    // Buffer ring has to be unregistered while the ring is still alive
+    m_buffer_ring.reset();
+    m_ring.reset();
+
+    if (m_listen_fd >= 0) {
+        close(m_listen_fd);
+    }
+    if (m_wake_fd >= 0) {
+        close(m_wake_fd);
+    }
+}
+
+UnixDomainServerResult<void> IoUringUnixDomainServer::run() {
+    const auto fail = [this](ErrorMessage message) -> UnixDomainServerResult<void> {
+        unlink(m_socket_path.c_str());
+        return std::unexpected(Error(UnixDomainServerError::GeneralServerError, std::move(message)));
+    };
+
+    if (listen(m_listen_fd, SOMAXCONN) != 0) {
+        return fail(describeErrno(errno));
+    }
+
+    const auto arm_result = armAccept();
+    if (!arm_result.has_value()) {
+        return fail(arm_result.error().message);
+    }
+
+    const auto wake_result = armWake();
+    if (!wake_result.has_value()) {
+        return fail(wake_result.error().message);
+    }
+
+    while (true) {
+        // Every iteration publishes all queued accepts, receives and sends with a single syscall and then
+        // waits for at least one of them to complete. While requests can be served it only reaps what already
+        // completed and serves a single request, so newly arrived higher priority work is considered next.
+        unsigned wait_count = canRunNextRequest() ? 0 : 1;
+        if (wait_count > 0 && m_busy_poller.isEnabled()) {
+            // The kernel posts completions while this thread spins, only waiting has to be skipped
+            const auto spin_submit_result = m_ring->submit();
+            if (!spin_submit_result.has_value()) {
+                return fail(spin_submit_result.error().message);
+            }
+
+            if (m_busy_poller.poll([this] { return m_ring->hasCompletions(); })) {
+                wait_count = 0;
+            }
+        }
+
+        const auto submit_result = m_ring->submitAndWait(wait_count);
+        if (!submit_result.has_value()) {
+            return fail(submit_result.error().message);
+        }
+
+        UnixDomainServerResult<void> completion_result;
+        m_ring->forEachCompletion([this, &completion_result](const io_uring_cqe& completion) {
+            if (completion_result.has_value()) {
+                completion_result = handleCompletion(completion);
+            }
+        });
+
+        if (!completion_result.has_value()) {
+            return fail(completion_result.error().message);
+        }
+
+        const auto request_result = runNextRequest();
+        if (!request_result.has_value()) {
+            return fail(request_result.error().message);
+        }
+    }
+}
+
+ServerBackend IoUringUnixDomainServer::getType() const {
+    return ServerBackend::IoUring;
+}
+
+BusyPollStatistics IoUringUnixDomainServer::getBusyPollStatistics() const {
+    return m_busy_poller.getStatistics();
+}
+
+void IoUringUnixDomainServer::publish(SharedPublishedEvent event) {
+    {
+        std::lock_guard lock(m_handoff_mutex);
+        m_published_events.push_back(std::move(event));
+    }
+
+    wake();
+}
+
+void IoUringUnixDomainServer::wake() const {
+    const std::uint64_t wake_increment = 1;
+    [[maybe_unused]] const auto written = write(m_wake_fd, &wake_increment, sizeof(wake_increment));
+}
+
+UnixDomainServerResult<void> IoUringUnixDomainServer::armAccept() {
+    const auto entry_result = m_ring->getSubmissionEntry();
+    if (!entry_result.has_value()) {
+        return std::unexpected(Error(UnixDomainServerError::GeneralServerError, entry_result.error().message));
+    }
+
+    auto* entry = entry_result.value();
+    entry->opcode = IORING_OP_ACCEPT;
+    entry->fd = m_listen_fd;
+    entry->accept_flags = SOCK_CLOEXEC;
+    entry->ioprio = m_multishot_accept ? IORING_ACCEPT_MULTISHOT : 0;
+    entry->user_data = encodeUserData(Operation::Accept, 0);
+
+    return {};
+}
+
+UnixDomainServerResult<void> IoUringUnixDomainServer::armReceive(const std::uint64_t connection_id,
+                                                                 Connection& connection) {
+    const auto entry_result = m_ring->getSubmissionEntry();
+    if (!entry_result.has_value()) {
+        return std::unexpected(Error(UnixDomainServerError::GeneralServerError, entry_result.error().message));
+    }
+
+    auto* entry = entry_result.value();
+    entry->opcode = IORING_OP_RECV;
+    entry->fd = connection.fd;
+    entry->flags = IOSQE_BUFFER_SELECT;
+    entry->buf_group = m_buffer_ring->getGroupId();
+    entry->ioprio = m_multishot_receive ? IORING_RECV_MULTISHOT : 0;
+    entry->user_data = encodeUserData(Operation::Receive, connection_id);
+    connection.receiving = true;
+
+    return {};
+}
+
+UnixDomainServerResult<void> IoUringUnixDomainServer::armWake() {
+    const auto entry_result = m_ring->getSubmissionEntry();
+    if (!entry_result.has_value()) {
+        return std::unexpected(Error(UnixDomainServerError::GeneralServerError, entry_result.error().message));
+    }
+
+    auto* entry = entry_result.value();
+    entry->opcode = IORING_OP_READ;
+    entry->fd = m_wake_fd;
+    entry->addr = reinterpret_cast<std::uint64_t>(&m_wake_counter);
+    entry->len = sizeof(m_wake_counter);
+    entry->user_data = encodeUserData(Operation::Wake, 0);
+
+    return {};
+}
+
+UnixDomainServerResult<void> IoUringUnixDomainServer::cancelReceive(const std::uint64_t connection_id) {
+    const auto entry_result = m_ring->getSubmissionEntry();
+    if (!entry_result.has_value()) {
+        return std::unexpected(Error(UnixDomainServerError::GeneralServerError, entry_result.error().message));
+    }
+
+    auto* entry = entry_result.value();
+    entry->opcode = IORING_OP_ASYNC_CANCEL;
+    entry->fd = -1;
+    entry->addr = encodeUserData(Operation::Receive, connection_id);
+    entry->user_data = encodeUserData(Operation::CancelReceive, connection_id);
+
+    return {};
+}
+
+bool IoUringUnixDomainServer::exceedsInputLimit(const Connection& connection) const {
+    return connection.input.getBufferedSize() + connection.unanswered_request_bytes >
+           k_frame_header_size + m_max_request_size;
+}
+
+UnixDomainServerResult<void> IoUringUnixDomainServer::resumeReceiveIfBelowLimit(const std::uint64_t connection_id,
+                                                                                Connection& connection) {
+    if (!connection.receive_paused || exceedsInputLimit(connection)) {
+        return {};
+    }
+
+    // A cancelled multishot receive may not have completed yet, it is armed again once it has
+    connection.receive_paused = false;
+    if (connection.receiving || connection.closing || connection.draining) {
+        return {};
+    }
+
+    return armReceive(connection_id, connection);
+}
+
+UnixDomainServerResult<void> IoUringUnixDomainServer::submitResponses(const std::uint64_t connection_id,
+                                                                      Connection& connection) {
+    if (connection.sends_in_flight > 0 || connection.queued_responses.empty() || connection.closing) {
+        return {};
+    }
+
+    // Responses of a single connection are written as one linked chain, so the kernel keeps their
+    // order even if a send has to wait for socket buffer space. The next chain is only submitted
+    // once the previous one fully completed.
+    std::vector<std::pair<const char*, std::size_t> > sends;
+    while (!connection.queued_responses.empty() && sends.size() + 2 <= k_max_sends_per_chain) {
+        auto& response = connection.sending_responses.emplace_back(std::move(connection.queued_responses.front()));
+        connection.queued_responses.pop_front();
+
+        if (response.event != nullptr) {
+            sends.emplace_back(response.event->frame.data(), response.event->frame.size());
+            continue;
+        }
+
+        sends.emplace_back(response.header.data(), response.header.size());
+        if (!response.body.empty()) {
+            sends.emplace_back(response.body.data(), response.body.size());
+        }
+    }
+
+    if (m_ring->getFreeSubmissionEntries() < sends.size()) {
+        const auto submit_result = m_ring->submit();
+        if (!submit_result.has_value()) {
+            return std::unexpected(Error(UnixDomainServerError::UnableToSendMessage, submit_result.error().message));
+        }
+    }
+
+    for (std::size_t i = 0; i < sends.size(); ++i) {
+        const auto entry_result = m_ring->getSubmissionEntry();
+        if (!entry_result.has_value()) {
+            return std::unexpected(Error(UnixDomainServerError::UnableToSendMessage, entry_result.error().message));
+        }
+
+        auto* entry = entry_result.value();
+        entry->opcode = IORING_OP_SEND;
+        entry->fd = connection.fd;
+        entry->addr = reinterpret_cast<std::uint64_t>(sends[i].first);
+        entry->len = static_cast<std::uint32_t>(sends[i].second);
+        entry->msg_flags = MSG_WAITALL | MSG_NOSIGNAL;
+        entry->flags = i + 1 < sends.size() ? IOSQE_IO_LINK : 0;
+        entry->user_data = encodeUserData(Operation::Send, connection_id);
+    }
+
+    connection.send_lengths.clear();
+    for (const auto& send : sends) {
+        connection.send_lengths.push_back(send.second);
+    }
+    connection.sends_in_flight = static_cast<unsigned>(sends.size());
+    return {};
+}
+
+UnixDomainServerResult<void> IoUringUnixDomainServer::handleCompletion(const io_uring_cqe& completion) {
+    const auto operation = static_cast<Operation>(completion.user_data >> k_user_data_operation_shift);
+    const auto connection_id = completion.user_data & k_user_data_connection_mask;
+
+    switch (operation) {
+        case Operation::Accept:
+            return handleAccept(completion);
+        case Operation::Receive:
+            return handleReceive(connection_id, completion);
+        case Operation::Send:
+            return handleSend(connection_id, completion);
+        case Operation::Wake:
+            return handleWake(completion);
+        case Operation::CancelReceive:
+            // The cancelled receive completes on its own
+            return {};
+        default:
+            return std::unexpected(Error(UnixDomainServerError::UnknownError, "Unknown io_uring operation"));
+    }
+}
+
+UnixDomainServerResult<void> IoUringUnixDomainServer::handleAccept(const io_uring_cqe& completion) {
+    if (completion.res == -EINVAL && m_multishot_accept) {
+        m_multishot_accept = false;
+        return armAccept();
+    }
+
+    if (completion.res >= 0) {
+        const auto connection_id = m_next_connection_id++;
+        auto& connection = m_connections[connection_id];
+        connection.fd = completion.res;
+        connection.input = FrameReader(m_max_request_size);
+        connection.admitted = m_admission_controller.tryAdmitConnection();
+
+        if (!connection.admitted) {
+            queueResponse(
+                connection, k_connection_request_id, m_admission_controller.getOverloadedResponse(), std::nullopt);
+            const auto submit_result = submitResponses(connection_id, connection);
+            connection.draining = true;
+            if (!submit_result.has_value()) {
+                return submit_result;
+            }
+        } else {
+            const auto arm_result = armReceive(connection_id, connection);
+            if (!arm_result.has_value()) {
+                return arm_result;
+            }
+        }
+    }
+
+    if ((completion.flags & IORING_CQE_F_MORE) == 0) {
+        return armAccept();
+    }
+
+    return {};
+}
+
+UnixDomainServerResult<void> IoUringUnixDomainServer::handleReceive(const std::uint64_t connection_id,
+                                                                    const io_uring_cqe& completion) {
+    const auto it = m_connections.find(connection_id);
+    if (it == m_connections.end()) {
+        return {};
+    }
+    auto& connection = it->second;
+
+    if ((completion.flags & IORING_CQE_F_BUFFER) != 0) {
+        const auto buffer_id = static_cast<std::uint16_t>(completion.flags >> IORING_CQE_BUFFER_SHIFT);
+        if (completion.res > 0) {
+            const auto received = m_buffer_ring->getBuffer(buffer_id, static_cast<std::size_t>(completion.res));
+            const auto space = connection.input.prepare(received.size());
+            std::memcpy(space.data(), received.data(), received.size());
+            connection.input.commit(received.size());
+        }
+        m_buffer_ring->recycleBuffer(buffer_id);
+    }
+
+    const bool still_armed = (completion.flags & IORING_CQE_F_MORE) != 0;
+    if (!still_armed) {
+        connection.receiving = false;
+    }
+
+    // Responses to the requests read so far are still written, like the Asio backend does. A cancelled receive
+    // belongs to a paused connection and is not an error.
+    if (completion.res == 0) {
+        connection.draining = true;
+    } else if (completion.res == -EINVAL && m_multishot_receive) {
+        m_multishot_receive = false;
+    } else if (completion.res < 0 && completion.res != -ENOBUFS && completion.res != -ECANCELED) {
+        connection.draining = true;
+    }
+
+    if (completion.res > 0 && !connection.closing && !connection.draining) {
+        processReceivedFrames(connection_id, connection);
+
+        // The stream cannot be read past a frame whose payload is never buffered, the connection is closed once
+        // the answer and the responses queued before it are written
+        const auto oversized_header = connection.input.getOversizedFrameHeader();
+        if (oversized_header.has_value() && !isOneWay(oversized_header.value())) {
+            queueResponse(connection, oversized_header->request_id, getRequestTooLargeResponse(), std::nullopt);
+        }
+
+        const auto submit_result = submitResponses(connection_id, connection);
+        if (oversized_header.has_value()) {
+            connection.draining = true;
+            if (connection.receiving) {
+                shutdown(connection.fd, SHUT_RD);
+            }
+        }
+        if (!submit_result.has_value()) {
+            return submit_result;
+        }
+
+        // A client pipelining faster than its requests are answered is no longer read from, the socket buffer
+        // fills up and its sends block
+        if (!connection.draining && !connection.receive_paused && exceedsInputLimit(connection)) {
+            connection.receive_paused = true;
+            if (connection.receiving) {
+                const auto cancel_result = cancelReceive(connection_id);
+                if (!cancel_result.has_value()) {
+                    return cancel_result;
+                }
+            }
+        }
+    }
+
+    if (!connection.receiving && !connection.closing && !connection.draining && !connection.receive_paused) {
+        return armReceive(connection_id, connection);
+    }
+
+    closeConnectionIfDone(connection_id, connection);
+    return {};
+}
+
+UnixDomainServerResult<void> IoUringUnixDomainServer::handleSend(const std::uint64_t connection_id,
+                                                                 const io_uring_cqe& completion) {
+    const auto it = m_connections.find(connection_id);
+    if (it == m_connections.end()) {
+        return {};
+    }
+    auto& connection = it->second;
+
+    const auto send_length = connection.send_lengths[connection.send_lengths.size() - connection.sends_in_flight];
+    --connection.sends_in_flight;
+
+    // A short send left part of a frame in the stream, which cannot be resynchronized, and broke the chain as well
+    const auto short_send = completion.res >= 0 && static_cast<std::size_t>(completion.res) < send_length;
+    if ((completion.res < 0 || short_send) && !connection.closing) {
+        // Broken chain, remaining linked sends complete with -ECANCELED
+        connection.closing = true;
+        if (connection.receiving) {
+            shutdown(connection.fd, SHUT_RDWR);
+        }
+    }
+
+    if (connection.sends_in_flight == 0) {
+        for (const auto& response : connection.sending_responses) {
+            if (response.admitted_request_size.has_value()) {
+                m_admission_controller.releaseRequest(response.admitted_request_size.value());
+            }
+        }
+        connection.sending_responses.clear();
+
+        const auto submit_result = submitResponses(connection_id, connection);
+        if (!submit_result.has_value()) {
+            return submit_result;
+        }
+    }
+
+    closeConnectionIfDone(connection_id, connection);
+    return {};
+}
+
+UnixDomainServerResult<void> IoUringUnixDomainServer::handleWake(const io_uring_cqe& completion) {
+    if (completion.res < 0 && completion.res != -EINTR) {
+        return std::unexpected(Error(UnixDomainServerError::GeneralServerError, describeErrno(-completion.res)));
+    }
+
+    std::vector<SharedPublishedEvent> published_events;
+    std::vector<CompletedRequest> completed_requests;
+    {
+        std::lock_guard lock(m_handoff_mutex);
+        published_events.swap(m_published_events);
+        completed_requests.swap(m_completed_requests);
+    }
+
+    for (const auto& event : published_events) {
+        const auto fan_out_result = fanOutEvent(event);
+        if (!fan_out_result.has_value()) {
+            return fan_out_result;
+        }
+    }
+
+    for (auto& completed : completed_requests) {
+        if (completed.frees_handler_thread) {
+            --m_dispatched_requests;
+        }
+
+        // Handler failures leave the loop the same way as when the handler runs on this thread
+        if (completed.failure != nullptr) {
+            std::rethrow_exception(completed.failure);
+        }
+
+        if (!completed.response.has_value()) {
+            continue;
+        }
+
+        const auto complete_result = completeRequest(completed.connection_id,
+                                                     completed.header,
+                                                     completed.admitted_request_size,
+                                                     std::move(completed.response.value()));
+        if (!complete_result.has_value()) {
+            return complete_result;
+        }
+    }
+
+    return armWake();
+}
+
+UnixDomainServerResult<void> IoUringUnixDomainServer::fanOutEvent(const SharedPublishedEvent& event) {
+    const auto subscribers_it = m_subscribers.find(event->topic);
+    if (subscribers_it == m_subscribers.end()) {
+        return {};
+    }
+
+    // Disconnecting a slow subscriber may unsubscribe it, so the subscriber set is not iterated directly
+    const std::vector<std::uint64_t> subscribers(subscribers_it->second.begin(), subscribers_it->second.end());
+    for (const auto connection_id : subscribers) {
+        const auto it = m_connections.find(connection_id);
+        if (it == m_connections.end() || it->second.closing || it->second.draining) {
+            continue;
+        }
+        auto& connection = it->second;
+
+        if (!queueEventForSubscriber(connection.queued_responses, event, m_subscription_options)) {
+            connection.closing = true;
+            if (connection.receiving) {
+                shutdown(connection.fd, SHUT_RDWR);
+            }
+            closeConnectionIfDone(connection_id, connection);
+            continue;
+        }
+
+        const auto submit_result = submitResponses(connection_id, connection);
+        if (!submit_result.has_value()) {
+            return submit_result;
+        }
+    }
+
+    return {};
+}
+
+void IoUringUnixDomainServer::handleSubscriptionFrame(const std::uint64_t connection_id,
+                                                      const FrameHeader& header,
+                                                      const char* body) {
+    std::string topic(body, header.payload_length);
+    if (hasFrameFlag(header, k_frame_flag_subscribe)) {
+        m_subscribers[std::move(topic)].insert(connection_id);
+        return;
+    }
+
+    const auto it = m_subscribers.find(topic);
+    if (it != m_subscribers.end()) {
+        it->second.erase(connection_id);
+        if (it->second.empty()) {
+            m_subscribers.erase(it);
+        }
+    }
+}
+
+void IoUringUnixDomainServer::queueResponse(Connection& connection,
+                                            const std::uint64_t request_id,
+                                            ProtocolMessage body,
+                                            const std::optional<std::size_t> admitted_request_size) {
+    auto& response = connection.queued_responses.emplace_back();
+    response.body = std::move(body);
+    response.admitted_request_size = admitted_request_size;
+
+    const FrameHeader header{.payload_length = static_cast<std::uint32_t>(response.body.length()),
+                             .request_id = request_id};
+    encodeFrameHeader(header, response.header.data());
+}
+
+void IoUringUnixDomainServer::processReceivedFrames(const std::uint64_t connection_id, Connection& connection) {
+    const auto now = std::chrono::steady_clock::now();
+
+    while (const auto frame = connection.input.next()) {
+        const auto& header = frame->header;
+        const auto* body_begin = frame->payload.data();
+        const auto msg_length = frame->payload.size();
+
+        // The empty acknowledgement tells the client that events of the topic are delivered from now on
+        if (hasFrameFlag(header, k_frame_flag_subscribe) || hasFrameFlag(header, k_frame_flag_unsubscribe)) {
+            handleSubscriptionFrame(connection_id, header, body_begin);
+            queueResponse(connection, header.request_id, {}, std::nullopt);
+            continue;
+        }
+
+        if (m_traffic_capture != nullptr) {
+            m_traffic_capture->capture(connection_id, header, frame->payload);
+        }
+
+        // Expired while waiting in the socket buffer, nobody is waiting for the response anymore
+        if (isDeadlineExpired(header, now)) {
+            continue;
+        }
+
+        // Responses waiting for a previous chain to be written still count as in flight, so a client
+        // pipelining faster than it reads its responses is throttled as well
+        if (!m_admission_controller.tryAdmitRequest(msg_length)) {
+            if (!isOneWay(header)) {
+                queueResponse(
+                    connection, header.request_id, m_admission_controller.getOverloadedResponse(), std::nullopt);
+            }
+            continue;
+        }
+
+        auto request = m_request_pool.take();
+        request.assign(frame->payload);
+        const auto priority = resolveRequestPriority(header, request, m_priority_resolver);
+        m_scheduler.push(priority, ScheduledRequest{connection_id, header, std::move(request)});
+        if (!isOneWay(header)) {
+            ++connection.unanswered_requests;
+            connection.unanswered_request_bytes += msg_length;
+        }
+    }
+}
+
+bool IoUringUnixDomainServer::canRunNextRequest() const {
+    if (m_scheduler.empty()) {
+        return false;
+    }
+
+    // Once the handler threads are saturated the next request waits for a completion to wake the ring
+    return m_handler_executor == nullptr ||
+           m_dispatched_requests < m_handler_executor->getWorkerCount() * k_dispatched_requests_per_handler_thread;
+}
+
+UnixDomainServerResult<void> IoUringUnixDomainServer::runNextRequest() {
+    if (!canRunNextRequest()) {
+        return {};
+    }
+
+    auto scheduled = m_scheduler.pop();
+
+    // Handlers of requests that expired or whose connection is gone are skipped, unless nothing has to be written
+    // back for the latter
+    const auto expired = isDeadlineExpired(scheduled->header, std::chrono::steady_clock::now());
+    if (expired || !isOneWay(scheduled->header)) {
+        const auto it = m_connections.find(scheduled->connection_id);
+        const auto connection_gone = it == m_connections.end() || it->second.closing;
+        if (expired || connection_gone) {
+            const auto request_size = scheduled->request.size();
+            m_admission_controller.releaseRequest(request_size);
+            m_request_pool.recycle(std::move(scheduled->request));
+            if (connection_gone || isOneWay(scheduled->header)) {
+                return {};
+            }
+
+            auto& connection = it->second;
+            --connection.unanswered_requests;
+            connection.unanswered_request_bytes -= request_size;
+            const auto resume_result = resumeReceiveIfBelowLimit(it->first, connection);
+            closeConnectionIfDone(it->first, connection);
+            return resume_result;
+        }
+    }
+
+    if (m_handler_executor == nullptr) {
+        auto response = callRequestHandler(scheduled.value());
+        const auto admitted_request_size = scheduled->request.size();
+        m_request_pool.recycle(std::move(scheduled->request));
+        if (!response.has_value()) {
+            return {};
+        }
+
+        return completeRequest(
+            scheduled->connection_id, scheduled->header, admitted_request_size, std::move(response.value()));
+    }
+
+    ++m_dispatched_requests;
+    m_handler_executor->submit([this, shared_scheduled = std::make_shared<ScheduledRequest>(std::move(*scheduled))] {
+        CompletedRequest completed{.connection_id = shared_scheduled->connection_id,
+                                   .header = shared_scheduled->header,
+                                   .admitted_request_size = shared_scheduled->request.size(),
+                                   .frees_handler_thread = true};
+        try {
+            completed.response = callRequestHandler(*shared_scheduled);
+        } catch (...) {
+            completed.failure = std::current_exception();
+        }
+
+        handOffCompletedRequest(std::move(completed));
+    });
+    return {};
+}
+
+std::optional<ProtocolMessage> IoUringUnixDomainServer::callRequestHandler(const ScheduledRequest& scheduled) {
+    LazyResponseDeferral deferral([this, &scheduled] {
+        return DeferredResponseCallback([this,
+                                         connection_id = scheduled.connection_id,
+                                         header = scheduled.header,
+                                         admitted_request_size = scheduled.request.size()](ProtocolMessage response) {
+            handOffCompletedRequest(CompletedRequest{.connection_id = connection_id,
+                                                     .header = header,
+                                                     .admitted_request_size = admitted_request_size,
+                                                     .response = std::move(response)});
+        });
+    });
+
+    return m_request_handler(scheduled.request, deferral);
+}
+
+UnixDomainServerResult<void> IoUringUnixDomainServer::completeRequest(const std::uint64_t connection_id,
+                                                                      const FrameHeader& header,
+                                                                      const std::size_t admitted_request_size,
+                                                                      ProtocolMessage response) {
+    if (isOneWay(header)) {
+        m_admission_controller.releaseRequest(admitted_request_size);
+        return {};
+    }
+
+    // The connection may have closed while the request was served by a handler thread or a deferred handler
+    const auto it = m_connections.find(connection_id);
+    if (it == m_connections.end() || it->second.closing) {
+        m_admission_controller.releaseRequest(admitted_request_size);
+        return {};
+    }
+    auto& connection = it->second;
+    --connection.unanswered_requests;
+    connection.unanswered_request_bytes -= admitted_request_size;
+
+    if (response.size() > m_max_response_size) {
+        response = getResponseTooLargeResponse();
+    }
+
+    queueResponse(connection, header.request_id, std::move(response), admitted_request_size);
+    const auto submit_result = submitResponses(connection_id, connection);
+    if (!submit_result.has_value()) {
+        return submit_result;
+    }
+
+    return resumeReceiveIfBelowLimit(connection_id, connection);
+}
+
+void IoUringUnixDomainServer::handOffCompletedRequest(CompletedRequest completed) {
+    {
+        std::lock_guard lock(m_handoff_mutex);
+        m_completed_requests.push_back(std::move(completed));
+    }
+
+    wake();
+}
+
+void IoUringUnixDomainServer::closeConnectionIfDone(const std::uint64_t connection_id, Connection& connection) {
+    const auto done = connection.closing || (connection.draining && connection.unanswered_requests == 0 &&
+                                             connection.queued_responses.empty());
+    if (!done || connection.receiving || connection.sends_in_flight > 0) {
+        return;
+    }
+
+    // Responses that never made it into a chain still hold their admitted request size
+    for (const auto& response : connection.queued_responses) {
+        if (response.admitted_request_size.has_value()) {
+            m_admission_controller.releaseRequest(response.admitted_request_size.value());
+        }
+    }
+
+    close(connection.fd);
+    if (connection.admitted) {
+        m_admission_controller.releaseConnection();
+    }
+    unsubscribeAll(connection_id);
+    m_connections.erase(connection_id);
+}
+
+void IoUringUnixDomainServer::unsubscribeAll(const std::uint64_t connection_id) {
+    for (auto it = m_subscribers.begin(); it != m_subscribers.end();) {
+        it->second.erase(connection_id);
+        it = it->second.empty() ? m_subscribers.erase(it) : std::next(it);
+    }
+}
+}  // namespace ipcourier::_detail
+
+#endif  // INTER_PROCESS_COURIER_IO_URING_AVAILABLE
@@ -0,0 +1,225 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef INTER_PROCESS_COURIER_IOURINGUNIXDOMAINSERVER_HPP
+#define INTER_PROCESS_COURIER_IOURINGUNIXDOMAINSERVER_HPP
+
+#include "BufferPool.hpp"
+#include "BusyPoller.hpp"
+#include "FrameReader.hpp"
+#include "IoUring.hpp"
+#include "RequestScheduler.hpp"
+#include "ServerAdmissionController.hpp"
+#include "UnixDomainProtocol.hpp"
+#include "UnixDomainServerBackend.hpp"
+#include "WorkStealingExecutor.hpp"
+
+#if INTER_PROCESS_COURIER_IO_URING_AVAILABLE
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ipcourier::_detail {
+class IoUringUnixDomainServer final : public UnixDomainServerBackend {
+public:
+    static UnixDomainServerResult<std::unique_ptr<IoUringUnixDomainServer> > create(
+        const std::string& socket_path,
+        RequestHandler request_handler,
+        RequestPriorityResolver priority_resolver,
+        TrafficCaptureWriter* traffic_capture,
+        const SyncServerOptions& server_options);
+
+    IoUringUnixDomainServer(const IoUringUnixDomainServer&) = delete;
+
+    IoUringUnixDomainServer& operator=(const IoUringUnixDomainServer&) = delete;
+
+    ~IoUringUnixDomainServer() override;
+
+    UnixDomainServerResult<void> run() override;
+
+    ServerBackend getType() const override;
+
+    BusyPollStatistics getBusyPollStatistics() const override;
+
+    void publish(SharedPublishedEvent event) override;
+
+private:
+    enum class Operation : std::uint8_t {
+        Accept,
+        Receive,
+        Send,
+        Wake,
+        CancelReceive,
+    };
+
+    // Event frames are sent straight from the shared event, header and body are left empty for them
+    struct PendingResponse {
+        std::array<char, k_frame_header_size> header{};
+        ProtocolMessage body;
+        SharedPublishedEvent event;
+        std::optional<std::size_t> admitted_request_size;
+    };
+
+    struct ScheduledRequest {
+        std::uint64_t connection_id = 0;
+        FrameHeader header;
+        ProtocolMessage request;
+    };
+
+    // Handed back by a handler thread once the handler returned, or by a deferred handler once it responded
+    struct CompletedRequest {
+        std::uint64_t connection_id = 0;
+        FrameHeader header;
+        std::size_t admitted_request_size = 0;
+        std::optional<ProtocolMessage> response = std::nullopt;
+        bool frees_handler_thread = false;
+        std::exception_ptr failure = nullptr;
+    };
+
+    struct Connection {
+        int fd = -1;
+        FrameReader input;
+        std::deque<PendingResponse> queued_responses;
+        std::deque<PendingResponse> sending_responses;
+        // Lengths of the sends of the chain in flight, its completions arrive in the same order
+        std::vector<std::size_t> send_lengths;
+        unsigned sends_in_flight = 0;
+        // Requests read from the connection whose response is not queued yet, and their size
+        std::size_t unanswered_requests = 0;
+        std::size_t unanswered_request_bytes = 0;
+        bool admitted = false;
+        bool receiving = false;
+        // Nothing more is read until the buffered input shrinks below the limit again, see exceedsInputLimit
+        bool receive_paused = false;
+        // Nothing more is read, the connection closes once the requests read so far are answered and written
+        bool draining = false;
+        // Nothing more is read or written, e.g. after a failed send
+        bool closing = false;
+    };
+
+    RequestHandler m_request_handler;
+    RequestPriorityResolver m_priority_resolver;
+    TrafficCaptureWriter* m_traffic_capture;
+    std::string m_socket_path;
+    ServerAdmissionController m_admission_controller;
+    RequestScheduler<ScheduledRequest> m_scheduler;
+    BufferPool<ProtocolMessage> m_request_pool;
+    SubscriptionOptions m_subscription_options;
+    std::size_t m_max_request_size;
+    std::size_t m_max_response_size;
+    std::unordered_map<std::string, std::unordered_set<std::uint64_t> > m_subscribers;
+    int m_listen_fd = -1;
+
+    // Events published from other threads and requests completed by the handler threads wait here until the
+    // eventfd read wakes up the ring
+    std::mutex m_handoff_mutex;
+    std::vector<SharedPublishedEvent> m_published_events;
+    std::vector<CompletedRequest> m_completed_requests;
+    int m_wake_fd = -1;
+    std::uint64_t m_wake_counter = 0;
+
+    std::unique_ptr<IoUring> m_ring;
+    std::unique_ptr<ProvidedBufferRing> m_buffer_ring;
+
+    std::unordered_map<std::uint64_t, Connection> m_connections;
+    std::uint64_t m_next_connection_id = 1;
+
+    bool m_multishot_accept = true;
+    bool m_multishot_receive = true;
+
+    std::size_t m_dispatched_requests = 0;
+
+    BusyPoller m_busy_poller;
+
+    // Declared last, so the handler threads are joined before anything they hand results to is destroyed
+    std::unique_ptr<WorkStealingExecutor> m_handler_executor;
+
+    IoUringUnixDomainServer(RequestHandler request_handler,
+                            RequestPriorityResolver priority_resolver,
+                            TrafficCaptureWriter* traffic_capture,
+                            std::string socket_path,
+                            const SyncServerOptions& server_options);
+
+    UnixDomainServerResult<void> armAccept();
+
+    UnixDomainServerResult<void> armReceive(std::uint64_t connection_id, Connection& connection);
+
+    UnixDomainServerResult<void> armWake();
+
+    UnixDomainServerResult<void> cancelReceive(std::uint64_t connection_id);
+
+    // Unparsed input and requests not answered yet are bounded per connection by the largest request
+    bool exceedsInputLimit(const Connection& connection) const;
+
+    UnixDomainServerResult<void> resumeReceiveIfBelowLimit(std::uint64_t connection_id, Connection& connection);
+
+    UnixDomainServerResult<void> submitResponses(std::uint64_t connection_id, Connection& connection);
+
+    UnixDomainServerResult<void> handleCompletion(const io_uring_cqe& completion);
+
+    UnixDomainServerResult<void> handleAccept(const io_uring_cqe& completion);
+
+    UnixDomainServerResult<void> handleReceive(std::uint64_t connection_id, const io_uring_cqe& completion);
+
+    UnixDomainServerResult<void> handleSend(std::uint64_t connection_id, const io_uring_cqe& completion);
+
+    UnixDomainServerResult<void> handleWake(const io_uring_cqe& completion);
+
+    UnixDomainServerResult<void> fanOutEvent(const SharedPublishedEvent& event);
+
+    void handleSubscriptionFrame(std::uint64_t connection_id, const FrameHeader& header, const char* body);
+
+    static void queueResponse(Connection& connection,
+                              std::uint64_t request_id,
+                              ProtocolMessage body,
+                              std::optional<std::size_t> admitted_request_size);
+
+    void processReceivedFrames(std::uint64_t connection_id, Connection& connection);
+
+    bool canRunNextRequest() const;
+
+    UnixDomainServerResult<void> runNextRequest();
+
+    std::optional<ProtocolMessage> callRequestHandler(const ScheduledRequest& scheduled);
+
+    UnixDomainServerResult<void> completeRequest(std::uint64_t connection_id,
+                                                 const FrameHeader& header,
+                                                 std::size_t admitted_request_size,
+                                                 ProtocolMessage response);
+
+    void handOffCompletedRequest(CompletedRequest completed);
+
+    void wake() const;
+
+    void closeConnectionIfDone(std::uint64_t connection_id, Connection& connection);
+
+    void unsubscribeAll(std::uint64_t connection_id);
+};
+}  // namespace ipcourier::_detail
+
+#endif  // INTER_PROCESS_COURIER_IO_URING_AVAILABLE
+
+#endif  // INTER_PROCESS_COURIER_IOURINGUNIXDOMAINSERVER_HPP
@@ -24,15 +24,31 @@ SerializedProtoPayload createProtoPayload(const std::string_view type_name, cons
     return std::format("{}:{}", type_name, serialized_data);
 }
 
-static std::string shortenPayload(const SerializedProtoPayload& payload) {
-    return payload.size() > 128 ? payload.substr(0, 128) + "..." : payload;
+std::optional<ProtoPayloadParts> splitProtoPayload(const std::string_view payload) {
+    const auto delimiter_pos = payload.find(':');
+    if (delimiter_pos == std::string_view::npos) {
+        return std::nullopt;
+    }
+
+    return ProtoPayloadParts{.type_name = payload.substr(0, delimiter_pos), .body = payload.substr(delimiter_pos + 1)};
+}
+
+// Payloads are quoted in error messages by their first 128 bytes, followed by the returned suffix if longer
+static std::string_view shortenPayload(const std::string_view payload) {
+    return payload.substr(0, 128);
+}
+
+static std::string_view getShortenedPayloadSuffix(const std::string_view payload) {
+    return payload.size() > 128 ? "..." : "";
 }
 
 ProtobufToolResult<std::unique_ptr<BaseProtoType> > makeBaseProtoFromPayload(const SerializedProtoPayload& payload) {
     const auto delimiter_pos = payload.find(':');
     if (delimiter_pos == std::string::npos) {
-        return std::unexpected(
-            Error(ProtoPayloadParseError::InvalidFormat, std::format("Received message: {}", shortenPayload(payload))));
+        return std::unexpected(Error(ProtoPayloadParseError::InvalidFormat,
+                                     ErrorMessage::format("Received message: {}{}",
+                                                          shortenPayload(payload),
+                                                          getShortenedPayloadSuffix(payload))));
     }
 
     const auto type_name = payload.substr(0, delimiter_pos);
@@ -41,20 +57,23 @@ ProtobufToolResult<std::unique_ptr<BaseProtoType> > makeBaseProtoFromPayload(con
     const auto* descriptor = google::protobuf::DescriptorPool::generated_pool()->FindMessageTypeByName(type_name);
     if (descriptor == nullptr) {
         return std::unexpected(Error(ProtoPayloadParseError::DeserializationFailed,
-                                     std::format("Description for {} not found", type_name)));
+                                     ErrorMessage::format("Description for {} not found", type_name)));
     }
 
     const BaseProtoType* prototype = google::protobuf::MessageFactory::generated_factory()->GetPrototype(descriptor);
     if (prototype == nullptr) {
         return std::unexpected(Error(ProtoPayloadParseError::DeserializationFailed,
-                                     std::format("Unable to generate prototype for {}", type_name)));
+                                     ErrorMessage::format("Unable to generate prototype for {}", type_name)));
     }
 
     auto msg = std::unique_ptr<BaseProtoType>(prototype->New());
     if (!msg->ParseFromString(serialized_data)) {
         return std::unexpected(
             Error(ProtoPayloadParseError::DeserializationFailed,
-                  std::format("Unable to deserialize as {}. Message: {}", type_name, shortenPayload(payload))));
+                  std::format("Unable to deserialize as {}. Message: {}{}",
+                              type_name,
+                              shortenPayload(payload),
+                              getShortenedPayloadSuffix(payload))));
     }
 
     return std::move(msg);
@@ -0,0 +1,57 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include <InterProcessCourier/RawMessage.hpp>
+
+namespace ipcourier {
+RawMessage::RawMessage(const std::string_view type_name, const std::string_view body) :
+    m_payload(_detail::createProtoPayload(type_name, body)), m_type_name_size(type_name.size()) {
+}
+
+RawMessage::RawMessage(_detail::SerializedProtoPayload payload, const std::size_t type_name_size) :
+    m_payload(std::move(payload)), m_type_name_size(type_name_size) {
+}
+
+std::string_view RawMessage::getTypeName() const {
+    return std::string_view(m_payload).substr(0, m_type_name_size);
+}
+
+std::string_view RawMessage::getBody() const {
+    return std::string_view(m_payload).substr(m_type_name_size + 1);
+}
+}  // namespace ipcourier
+
+namespace ipcourier::_detail {
+std::optional<RawMessage> makeRawMessage(SerializedProtoPayload payload) {
+    const auto parts = splitProtoPayload(payload);
+    if (!parts.has_value()) {
+        return std::nullopt;
+    }
+
+    const auto type_name_size = parts->type_name.size();
+    return RawMessage(std::move(payload), type_name_size);
+}
+
+SerializedProtoPayload takeRawMessagePayload(RawMessage&& message) {
+    return std::move(message.m_payload);
+}
+
+const SerializedProtoPayload& getRawMessagePayload(const RawMessage& message) {
+    return message.m_payload;
+}
+}  // namespace ipcourier::_detail
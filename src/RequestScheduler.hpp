@@ -0,0 +1,94 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef INTER_PROCESS_COURIER_REQUESTSCHEDULER_HPP
+#define INTER_PROCESS_COURIER_REQUESTSCHEDULER_HPP
+
+#include "UnixDomainProtocol.hpp"
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <optional>
+
+#include <InterProcessCourier/SyncCommons.hpp>
+
+namespace ipcourier::_detail {
+constexpr std::size_t k_default_starvation_limit = 8;
+
+// Serves queued requests strictly by priority, except that a non-empty lower lane which was passed over
+// more than starvation_limit times is served next, bounding its wait under sustained higher priority load.
+template <typename Item>
+class RequestScheduler {
+public:
+    explicit RequestScheduler(const std::size_t starvation_limit = k_default_starvation_limit) :
+        m_starvation_limit(starvation_limit) {
+    }
+
+    void push(const RequestPriority priority, Item item) {
+        m_lanes[laneIndex(priority)].push_back(std::move(item));
+        ++m_size;
+    }
+
+    std::optional<Item> pop() {
+        if (m_size == 0) {
+            return std::nullopt;
+        }
+
+        auto lane = k_request_priority_count - 1;
+        while (m_lanes[lane].empty()) {
+            --lane;
+        }
+
+        const auto highest_lane = lane;
+        for (std::size_t lower_lane = 0; lower_lane < highest_lane; ++lower_lane) {
+            if (m_lanes[lower_lane].empty()) {
+                m_passed_over[lower_lane] = 0;
+            } else if (++m_passed_over[lower_lane] > m_starvation_limit && lane == highest_lane) {
+                lane = lower_lane;
+            }
+        }
+        m_passed_over[lane] = 0;
+
+        auto item = std::move(m_lanes[lane].front());
+        m_lanes[lane].pop_front();
+        --m_size;
+        return item;
+    }
+
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    std::size_t size() const {
+        return m_size;
+    }
+
+private:
+    std::size_t m_starvation_limit;
+    std::size_t m_size = 0;
+    std::array<std::deque<Item>, k_request_priority_count> m_lanes;
+    std::array<std::size_t, k_request_priority_count> m_passed_over{};
+
+    static std::size_t laneIndex(const RequestPriority priority) {
+        const auto index = static_cast<std::size_t>(priority);
+        return index < k_request_priority_count ? index : static_cast<std::size_t>(RequestPriority::Normal);
+    }
+};
+}  // namespace ipcourier::_detail
+
+#endif  // INTER_PROCESS_COURIER_REQUESTSCHEDULER_HPP
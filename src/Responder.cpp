@@ -0,0 +1,48 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include <InterProcessCourier/Responder.hpp>
+#include <InterProcessCourier/SyncServer.hpp>
+
+#include "InternalRequests.pb.h"
+
+namespace ipcourier::_detail {
+static SerializedProtoPayload makeAbandonedResponse() {
+    internal_request_proto::IPCInternal_ErrorResponse error_response;
+    error_response.set_error_type(static_cast<std::int32_t>(SyncServerError::RuntimeError));
+    error_response.set_message("Handler finished without responding");
+    return makePayloadFromProto(error_response);
+}
+
+DeferredResponse::DeferredResponse(DeferredResponseCallback callback) : m_callback(std::move(callback)) {
+}
+
+DeferredResponse::~DeferredResponse() {
+    if (!m_completed.load(std::memory_order_acquire)) {
+        m_callback(makeAbandonedResponse());
+    }
+}
+
+void DeferredResponse::complete(SerializedProtoPayload payload) {
+    if (m_completed.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    m_callback(std::move(payload));
+}
+}  // namespace ipcourier::_detail
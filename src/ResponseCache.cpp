@@ -0,0 +1,78 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "ResponseCache.hpp"
+
+namespace ipcourier::_detail {
+ResponseCache::ResponseCache(const ResponseCacheOptions& options) : m_options(options) {
+}
+
+std::shared_ptr<const SerializedProtoPayload> ResponseCache::find(const std::string_view request_body) {
+    const std::lock_guard lock(m_mutex);
+    const auto it = m_index.find(request_body);
+    if (it == m_index.end()) {
+        return nullptr;
+    }
+
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->response;
+}
+
+void ResponseCache::insert(const std::string_view request_body, SerializedProtoPayload response) {
+    const auto entry_size = request_body.size() + response.size();
+    if (m_options.max_bytes != 0 && entry_size > m_options.max_bytes) {
+        return;
+    }
+
+    auto shared_response = std::make_shared<const SerializedProtoPayload>(std::move(response));
+    const std::lock_guard lock(m_mutex);
+    // Another thread may have computed the same response meanwhile, the responses of pure handlers are equal
+    if (m_index.contains(request_body)) {
+        return;
+    }
+
+    m_entries.push_front(Entry{.request_body = std::string(request_body), .response = std::move(shared_response)});
+    m_index.emplace(m_entries.front().request_body, m_entries.begin());
+    m_byte_count += entry_size;
+    evictUntilWithinLimits();
+}
+
+std::size_t ResponseCache::getEntryCount() const {
+    const std::lock_guard lock(m_mutex);
+    return m_entries.size();
+}
+
+std::size_t ResponseCache::getByteCount() const {
+    const std::lock_guard lock(m_mutex);
+    return m_byte_count;
+}
+
+void ResponseCache::evictUntilWithinLimits() {
+    const auto exceeds_limits = [this] {
+        return (m_options.max_entries != 0 && m_entries.size() > m_options.max_entries) ||
+               (m_options.max_bytes != 0 && m_byte_count > m_options.max_bytes);
+    };
+
+    while (!m_entries.empty() && exceeds_limits()) {
+        const auto& oldest = m_entries.back();
+        m_byte_count -= oldest.request_body.size() + oldest.response->size();
+        m_index.erase(oldest.request_body);
+        m_entries.pop_back();
+    }
+}
+}  // namespace ipcourier::_detail
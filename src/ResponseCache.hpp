@@ -0,0 +1,73 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef INTER_PROCESS_COURIER_RESPONSECACHE_HPP
+#define INTER_PROCESS_COURIER_RESPONSECACHE_HPP
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <InterProcessCourier/SyncServer.hpp>
+#include <InterProcessCourier/detail/ProtobufTools.hpp>
+
+namespace ipcourier::_detail {
+/*
+ * Least recently used map from the serialized body of a request to its serialized response payload, used to
+ * answer repeated requests of pure handlers without parsing, calling the handler or serializing.
+ * Thread safe, handlers may run on several handler threads at once. Responses are shared with the callers, so a
+ * hit holds the mutex only for a reference count instead of a copy of the payload.
+ */
+class ResponseCache {
+public:
+    explicit ResponseCache(const ResponseCacheOptions& options);
+
+    // Empty if no response is cached for the request
+    std::shared_ptr<const SerializedProtoPayload> find(std::string_view request_body);
+
+    // Evicts least recently used entries until the limits hold again, pairs larger than max_bytes are not kept
+    void insert(std::string_view request_body, SerializedProtoPayload response);
+
+    std::size_t getEntryCount() const;
+
+    // Bytes of all cached requests and responses
+    std::size_t getByteCount() const;
+
+private:
+    struct Entry {
+        std::string request_body;
+        std::shared_ptr<const SerializedProtoPayload> response;
+    };
+
+    ResponseCacheOptions m_options;
+    mutable std::mutex m_mutex;
+
+    // Most recently used first, the index refers to the request bodies held by the list nodes
+    std::list<Entry> m_entries;
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> m_index;
+    std::size_t m_byte_count = 0;
+
+    void evictUntilWithinLimits();
+};
+}  // namespace ipcourier::_detail
+
+#endif  // INTER_PROCESS_COURIER_RESPONSECACHE_HPP
@@ -0,0 +1,87 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "ServerAdmissionController.hpp"
+
+#include <InterProcessCourier/detail/ProtobufTools.hpp>
+
+#include "InternalRequests.pb.h"
+
+namespace ipcourier::_detail {
+static bool tryIncrement(std::atomic<std::size_t>& counter, const std::size_t amount, const std::size_t limit) {
+    auto current = counter.load(std::memory_order_relaxed);
+    do {
+        if (limit != 0 && current + amount > limit) {
+            return false;
+        }
+    } while (!counter.compare_exchange_weak(current, current + amount, std::memory_order_relaxed));
+
+    return true;
+}
+
+ServerAdmissionController::ServerAdmissionController(const ServerAdmissionLimits limits) : m_limits(limits) {
+    internal_request_proto::IPCInternal_ErrorResponse overloaded_response;
+    overloaded_response.set_error_type(static_cast<std::int32_t>(SyncServerError::ServerOverloaded));
+    overloaded_response.set_message("Server admission limit reached");
+    m_overloaded_response = makePayloadFromProto(overloaded_response);
+}
+
+bool ServerAdmissionController::tryAdmitConnection() {
+    return tryIncrement(m_connections, 1, m_limits.max_connections);
+}
+
+void ServerAdmissionController::releaseConnection() {
+    m_connections.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool ServerAdmissionController::tryAdmitRequest(const std::size_t request_size) {
+    if (!tryIncrement(m_in_flight_requests, 1, m_limits.max_in_flight_requests)) {
+        return false;
+    }
+
+    // A single request larger than the whole budget is still admitted when nothing else is queued,
+    // otherwise it could never be served.
+    const auto bytes_limit = m_queued_bytes.load(std::memory_order_relaxed) == 0 ? 0 : m_limits.max_queued_bytes;
+    if (!tryIncrement(m_queued_bytes, request_size, bytes_limit)) {
+        m_in_flight_requests.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    return true;
+}
+
+void ServerAdmissionController::releaseRequest(const std::size_t request_size) {
+    m_queued_bytes.fetch_sub(request_size, std::memory_order_relaxed);
+    m_in_flight_requests.fetch_sub(1, std::memory_order_relaxed);
+}
+
+std::size_t ServerAdmissionController::getConnectionCount() const {
+    return m_connections.load(std::memory_order_relaxed);
+}
+
+std::size_t ServerAdmissionController::getInFlightRequestCount() const {
+    return m_in_flight_requests.load(std::memory_order_relaxed);
+}
+
+std::size_t ServerAdmissionController::getQueuedBytes() const {
+    return m_queued_bytes.load(std::memory_order_relaxed);
+}
+
+const ProtocolMessage& ServerAdmissionController::getOverloadedResponse() const {
+    return m_overloaded_response;
+}
+}  // namespace ipcourier::_detail
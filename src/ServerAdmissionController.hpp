@@ -0,0 +1,60 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef INTER_PROCESS_COURIER_SERVERADMISSIONCONTROLLER_HPP
+#define INTER_PROCESS_COURIER_SERVERADMISSIONCONTROLLER_HPP
+
+#include "UnixDomainProtocol.hpp"
+
+#include <atomic>
+#include <cstddef>
+
+#include <InterProcessCourier/SyncServer.hpp>
+
+namespace ipcourier::_detail {
+class ServerAdmissionController {
+public:
+    explicit ServerAdmissionController(ServerAdmissionLimits limits);
+
+    bool tryAdmitConnection();
+
+    void releaseConnection();
+
+    bool tryAdmitRequest(std::size_t request_size);
+
+    void releaseRequest(std::size_t request_size);
+
+    std::size_t getConnectionCount() const;
+
+    std::size_t getInFlightRequestCount() const;
+
+    std::size_t getQueuedBytes() const;
+
+    // Serialized once, every rejection reuses the same payload
+    const ProtocolMessage& getOverloadedResponse() const;
+
+private:
+    ServerAdmissionLimits m_limits;
+    ProtocolMessage m_overloaded_response;
+
+    std::atomic<std::size_t> m_connections = 0;
+    std::atomic<std::size_t> m_in_flight_requests = 0;
+    std::atomic<std::size_t> m_queued_bytes = 0;
+};
+}  // namespace ipcourier::_detail
+
+#endif  // INTER_PROCESS_COURIER_SERVERADMISSIONCONTROLLER_HPP
@@ -0,0 +1,72 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "ConsistentHashRing.hpp"
+
+#include <InterProcessCourier/ShardedSyncClient.hpp>
+
+namespace ipcourier {
+ShardedSyncClient::ShardedSyncClient(std::vector<std::string> shard_socket_addrs,
+                                     const SyncClientOptions& client_options) :
+    m_ring(std::make_unique<_detail::ConsistentHashRing>(shard_socket_addrs)) {
+    m_shards.reserve(shard_socket_addrs.size());
+    for (auto& shard_socket_addr : shard_socket_addrs) {
+        m_shards.push_back(std::make_unique<SyncClient>(std::move(shard_socket_addr), client_options));
+    }
+}
+
+ShardedSyncClient::~ShardedSyncClient() = default;
+
+SyncClientResult<void> ShardedSyncClient::connect() {
+    for (const auto& shard : m_shards) {
+        const auto connect_result = shard->connect();
+        if (!connect_result.has_value()) {
+            return connect_result;
+        }
+    }
+
+    return {};
+}
+
+std::size_t ShardedSyncClient::getShardCount() const {
+    return m_shards.size();
+}
+
+std::size_t ShardedSyncClient::getShardIndex(const std::string_view key) const {
+    return m_ring->getNode(key);
+}
+
+SyncClient& ShardedSyncClient::getShard(const std::size_t shard_index) {
+    return *m_shards.at(shard_index);
+}
+
+SyncClientResult<SyncClient*> ShardedSyncClient::resolveShard(const std::string_view type_name,
+                                                              const void* request) {
+    const auto it = m_key_extractors.find(std::string(type_name));
+    if (it == m_key_extractors.end()) {
+        return std::unexpected(
+            Error(SyncClientError::ShardKeyNotRegistered, std::format("No shard key registered for {}", type_name)));
+    }
+
+    if (m_shards.empty()) {
+        return std::unexpected(Error(SyncClientError::UnableToSendMessage, "No shards to send to"));
+    }
+
+    return m_shards[getShardIndex(it->second(request))].get();
+}
+}  // namespace ipcourier
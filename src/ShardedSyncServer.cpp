@@ -0,0 +1,83 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include <format>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include <InterProcessCourier/ShardedSyncServer.hpp>
+
+namespace ipcourier {
+ShardedSyncServer::ShardedSyncServer(const std::vector<std::string>& shard_socket_addrs,
+                                     const SyncServerOptions& server_options) {
+    m_shards.reserve(shard_socket_addrs.size());
+    for (std::size_t shard_index = 0; shard_index < shard_socket_addrs.size(); ++shard_index) {
+        // Shards sharing one capture file would overwrite each other's records
+        auto shard_options = server_options;
+        if (auto& traffic_capture = shard_options.traffic_capture; traffic_capture.has_value()) {
+            traffic_capture->path = std::format("{}.{}", traffic_capture->path, shard_index);
+        }
+
+        m_shards.push_back(std::make_unique<SyncServer>(shard_socket_addrs[shard_index], shard_options));
+    }
+}
+
+ShardedSyncServer::~ShardedSyncServer() = default;
+
+std::size_t ShardedSyncServer::getShardCount() const {
+    return m_shards.size();
+}
+
+SyncServer& ShardedSyncServer::getShard(const std::size_t shard_index) {
+    return *m_shards.at(shard_index);
+}
+
+void ShardedSyncServer::forEachShard(const std::function<void(SyncServer& shard, std::size_t shard_index)>& setup) {
+    for (std::size_t shard_index = 0; shard_index < m_shards.size(); ++shard_index) {
+        setup(*m_shards[shard_index], shard_index);
+    }
+}
+
+SyncServerResult<void> ShardedSyncServer::start() const {
+    std::mutex first_error_mutex;
+    std::optional<Error<SyncServerError> > first_error;
+
+    std::vector<std::jthread> shard_threads;
+    shard_threads.reserve(m_shards.size());
+    for (const auto& shard : m_shards) {
+        shard_threads.emplace_back([&shard, &first_error_mutex, &first_error] {
+            auto result = shard->start();
+            if (!result.has_value()) {
+                const std::lock_guard lock(first_error_mutex);
+                if (!first_error.has_value()) {
+                    first_error = std::move(result.error());
+                }
+            }
+        });
+    }
+
+    // Joins the shard threads, each runs until its shard stopped
+    shard_threads.clear();
+    if (first_error.has_value()) {
+        return std::unexpected(std::move(first_error.value()));
+    }
+
+    return {};
+}
+}  // namespace ipcourier
@@ -15,22 +15,66 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
  ***************************************************************************/
 
+#include "ConnectionHealth.hpp"
+#include "Handshake.hpp"
 #include "SyncUnixDomainClient.hpp"
 
+#include <algorithm>
 #include <format>
+#include <optional>
 #include <stdexcept>
 
+#include <InterProcessCourier/Metadata.hpp>
 #include <InterProcessCourier/SyncClient.hpp>
+#include <InterProcessCourier/SyncServer.hpp>
 #include <InterProcessCourier/detail/DuplicateRegistrationHandler.hpp>
 #include <boost/asio.hpp>
 
 #include "InternalRequests.pb.h"
 
 namespace ipcourier {
+static SyncClientError mapServerErrorToClientError(const SyncServerError server_error) {
+    switch (server_error) {
+        case SyncServerError::ServerOverloaded:
+            return SyncClientError::ServerOverloaded;
+        case SyncServerError::MessageTooLarge:
+            return SyncClientError::MessageTooLarge;
+        case SyncServerError::HandlerNotRegistered:
+            return SyncClientError::HandlerNotRegistered;
+        case SyncServerError::UnableToDeserializeMessage:
+            return SyncClientError::RequestRejected;
+        case SyncServerError::RuntimeError:
+        case SyncServerError::UnableToSerializeMessage:
+            return SyncClientError::HandlerFailed;
+        case SyncServerError::UnknownError:
+            break;
+    }
+
+    return SyncClientError::UnknownError;
+}
+
+static std::optional<Error<SyncClientError> > extractServerError(const _detail::SerializedProtoPayload& payload) {
+    using ErrorResponse = internal_request_proto::IPCInternal_ErrorResponse;
+
+    const auto& error_type_name = ErrorResponse::descriptor()->full_name();
+    if (!payload.starts_with(error_type_name) || payload.size() <= error_type_name.size() ||
+        payload[error_type_name.size()] != ':') {
+        return std::nullopt;
+    }
+
+    const auto error_response = _detail::makeProtoFromPayload<ErrorResponse>(payload);
+    if (!error_response.has_value()) {
+        return Error(SyncClientError::UnknownError, error_response.error().message);
+    }
+
+    const auto server_error = static_cast<SyncServerError>(error_response->error_type());
+    return Error(mapServerErrorToClientError(server_error), error_response->message());
+}
+
 SyncClient::SyncClient(std::string socket_addr, SyncClientOptions client_options) :
     m_client_options(std::move(client_options)), m_socket_addr(std::move(socket_addr)),
     m_io_context(std::make_unique<boost::asio::io_context>()),
-    m_client(std::make_unique<_detail::SyncUnixDomainClient>(*m_io_context)) {
+    m_client(std::make_unique<_detail::SyncUnixDomainClient>(*m_io_context, m_client_options)) {
 }
 
 SyncClient::~SyncClient() = default;
@@ -41,7 +85,21 @@ SyncClientResult<void> SyncClient::connect() {
         return std::unexpected(Error(SyncClientError::UnableToConnectToServer, connect_result.error().message));
     }
 
-    if (m_client_options.validate_req_res_pair_strategy == ValidateRequestResponsePairStrategy::ServerReflection) {
+    m_connection_capabilities.reset();
+    bool mappings_received = false;
+    // Replaces the reflection request when the mappings are reflected, otherwise only sent if asked for
+    if (m_client_options.exchange_hello ||
+        m_client_options.validate_req_res_pair_strategy == ValidateRequestResponsePairStrategy::ServerReflection) {
+        const auto hello_result = exchangeHello();
+        if (!hello_result.has_value()) {
+            return std::unexpected(hello_result.error());
+        }
+
+        mappings_received = hello_result.value();
+    }
+
+    if (m_client_options.validate_req_res_pair_strategy == ValidateRequestResponsePairStrategy::ServerReflection &&
+        !mappings_received) {
         const auto reflect_result = reflectRequestResponseMappingPairs();
         if (!reflect_result.has_value()) {
             return std::unexpected(reflect_result.error());
@@ -60,6 +118,10 @@ SyncClientResult<void> SyncClient::reflectRequestResponseMappingPairs() {
     const auto mapping_reflect_result =
         sendRequest<MappingReflectionRequest, MappingReflectionResponse>(MappingReflectionRequest{});
     if (!mapping_reflect_result.has_value()) {
+        if (mapping_reflect_result.error().type == SyncClientError::ServerOverloaded) {
+            return std::unexpected(mapping_reflect_result.error());
+        }
+
         return std::unexpected(Error(SyncClientError::UnableToReflectMappings, mapping_reflect_result.error().message));
     }
 
@@ -71,6 +133,68 @@ SyncClientResult<void> SyncClient::reflectRequestResponseMappingPairs() {
     return {};
 }
 
+SyncClientResult<bool> SyncClient::exchangeHello() {
+    _detail::Hello client_hello;
+    client_hello.features = _detail::getSupportedWireFeatures();
+    client_hello.max_request_size = m_client_options.max_request_size;
+    client_hello.max_response_size = m_client_options.max_response_size;
+    client_hello.library_version = getLibraryVersion();
+    client_hello.wants_mappings =
+        m_client_options.validate_req_res_pair_strategy == ValidateRequestResponsePairStrategy::ServerReflection;
+
+    const auto payload = _detail::createProtoPayload(_detail::k_hello_type_name, _detail::encodeHello(client_hello));
+    auto hello_result = sendAndReceiveMessage(payload, RequestOptions{.priority = RequestPriority::High});
+    if (!hello_result.has_value()) {
+        // A server predating the handshake has no handler for the hello but serves everything else
+        if (hello_result.error().type == SyncClientError::HandlerNotRegistered) {
+            return false;
+        }
+
+        if (hello_result.error().type == SyncClientError::ServerOverloaded) {
+            return std::unexpected(hello_result.error());
+        }
+
+        return std::unexpected(Error(SyncClientError::UnableToConnectToServer,
+                                     ErrorMessage::format("Handshake failed: {}", hello_result.error().message)));
+    }
+
+    const auto response = _detail::makeRawMessage(std::move(hello_result.value()));
+    const auto server_hello = response.has_value() && response->getTypeName() == _detail::k_hello_type_name
+                                  ? _detail::decodeHello(response->getBody())
+                                  : std::nullopt;
+    if (!server_hello.has_value()) {
+        return std::unexpected(Error(SyncClientError::UnableToConnectToServer, "Server sent a malformed hello"));
+    }
+
+    m_connection_capabilities = ConnectionCapabilities{
+        .server_library_version = server_hello->library_version,
+        .protocol_version = std::min(server_hello->protocol_version, _detail::k_wire_protocol_version),
+        .features = server_hello->features & client_hello.features,
+        .max_request_size = static_cast<std::size_t>(server_hello->max_request_size),
+        .max_response_size = static_cast<std::size_t>(server_hello->max_response_size)};
+
+    if (!server_hello->mappings.has_value()) {
+        return false;
+    }
+
+    for (const auto& [request_name, response_name] : server_hello->mappings.value()) {
+        m_request_response_pairs[request_name] = response_name;
+    }
+
+    return true;
+}
+
+SyncClientResult<void> SyncClient::checkRequestSize(const _detail::SerializedProtoPayload& serialized) const {
+    if (!m_connection_capabilities.has_value() || serialized.size() <= m_connection_capabilities->max_request_size) {
+        return {};
+    }
+
+    return std::unexpected(Error(SyncClientError::MessageTooLarge,
+                                 ErrorMessage::format("Request of {} bytes exceeds the server's limit of {} bytes",
+                                                      serialized.size(),
+                                                      m_connection_capabilities->max_request_size)));
+}
+
 bool SyncClient::registerDuplicateRequestResponsePair(const std::string& request_name,
                                                       const std::string& response_name) {
     const auto register_handler = [this](const auto& handler_request_name, const auto& handler_response_name) {
@@ -85,18 +209,231 @@ void SyncClient::registerValidatedRequestResponsePair(const std::string& request
     m_request_response_pairs[request_name] = response_name;
 }
 
+SyncClientResult<void> SyncClient::validateRequestResponsePair(const std::string& request_name,
+                                                               const std::string& response_name) const {
+    if (m_client_options.validate_req_res_pair_strategy == ValidateRequestResponsePairStrategy::NoValidation) {
+        return {};
+    }
+
+    auto it = m_request_response_pairs.find(request_name);
+
+    const auto found = it != m_request_response_pairs.end();
+    if (!found || it->second != response_name) {
+        const auto expected_response_name = found ? it->second : "<Not Registered>";
+        const auto strategy = m_client_options.validate_req_res_pair_strategy;
+
+        return std::unexpected(Error(
+            SyncClientError::BadRequestToResponsePair,
+            std::format("Request type '{}' expects response type '{}', but '{}' was provided. Current strategy: {}",
+                        request_name,
+                        expected_response_name,
+                        response_name,
+                        strategy)));
+    }
+
+    return {};
+}
+
+SyncClientResult<void> SyncClient::validateRawRequest(const std::string_view request_name, const bool one_way) const {
+    if (m_client_options.validate_req_res_pair_strategy == ValidateRequestResponsePairStrategy::NoValidation) {
+        return {};
+    }
+
+    const auto it = m_request_response_pairs.find(std::string(request_name));
+    if (it == m_request_response_pairs.end() || (it->second == _detail::k_one_way_response_name) != one_way) {
+        return std::unexpected(Error(SyncClientError::BadRequestToResponsePair,
+                                     std::format("Request type '{}' is not registered as {}. Current strategy: {}",
+                                                 request_name,
+                                                 one_way ? "one-way message" : "request with a response",
+                                                 m_client_options.validate_req_res_pair_strategy)));
+    }
+
+    return {};
+}
+
+SyncClientResult<RawMessage> SyncClient::sendRawRequest(const RawMessage& request,
+                                                        const RequestOptions& request_options) {
+    const auto validation_result = validateRawRequest(request.getTypeName(), false);
+    if (!validation_result.has_value()) {
+        return std::unexpected(validation_result.error());
+    }
+
+    auto send_and_receive_result = sendAndReceiveMessage(_detail::getRawMessagePayload(request), request_options);
+    if (!send_and_receive_result.has_value()) {
+        return std::unexpected(send_and_receive_result.error());
+    }
+
+    auto response = _detail::makeRawMessage(std::move(send_and_receive_result.value()));
+    if (!response.has_value()) {
+        return std::unexpected(Error(SyncClientError::UnableToParseReturnedProto, "Response has no type name"));
+    }
+
+    return std::move(response.value());
+}
+
+SyncClientResult<void> SyncClient::postRaw(const RawMessage& request, const RequestOptions& request_options) {
+    const auto validation_result = validateRawRequest(request.getTypeName(), true);
+    if (!validation_result.has_value()) {
+        return std::unexpected(validation_result.error());
+    }
+
+    return postMessage(_detail::getRawMessagePayload(request), request_options);
+}
+
+SyncClientResult<void> SyncClient::postMessage(const _detail::SerializedProtoPayload& serialized,
+                                               const RequestOptions& request_options) {
+    const auto size_result = checkRequestSize(serialized);
+    if (!size_result.has_value()) {
+        return std::unexpected(size_result.error());
+    }
+
+    const _detail::FrameHeader header{.priority = _detail::encodeRequestPriority(request_options.priority),
+                                      .flags = _detail::k_frame_flag_one_way,
+                                      .request_id = m_next_request_id++,
+                                      .deadline_ns = _detail::toDeadlineNs(request_options.deadline)};
+
+    const auto post_result = m_client->postMessage(serialized, header);
+    if (!post_result.has_value()) {
+        if (post_result.error().type == _detail::UnixDomainClientError::SendBufferFull) {
+            return std::unexpected(Error(SyncClientError::SendBufferFull, post_result.error().message));
+        }
+
+        if (post_result.error().type == _detail::UnixDomainClientError::MessageTooLarge) {
+            return std::unexpected(Error(SyncClientError::MessageTooLarge, post_result.error().message));
+        }
+
+        return std::unexpected(Error(SyncClientError::UnableToSendMessage, post_result.error().message));
+    }
+
+    return {};
+}
+
+SyncClientResult<std::size_t> SyncClient::dispatchEvents(const std::chrono::steady_clock::time_point deadline) {
+    const auto receive_result = m_client->receiveEvents(deadline);
+    if (!receive_result.has_value()) {
+        return std::unexpected(Error(SyncClientError::UnableToReceiveMessage, receive_result.error().message));
+    }
+
+    std::size_t dispatched_events = 0;
+    for (const auto& payload : receive_result.value()) {
+        const auto it = m_event_handlers.find(payload.substr(0, payload.find(':')));
+        if (it == m_event_handlers.end()) {
+            continue;
+        }
+
+        it->second(payload);
+        ++dispatched_events;
+    }
+
+    return dispatched_events;
+}
+
+SyncClientResult<void> SyncClient::flush() {
+    const auto flush_result = m_client->flush();
+    if (!flush_result.has_value()) {
+        return std::unexpected(Error(SyncClientError::UnableToSendMessage, flush_result.error().message));
+    }
+
+    return {};
+}
+
+BusyPollStatistics SyncClient::getBusyPollStatistics() const {
+    return m_client->getBusyPollStatistics();
+}
+
+const std::optional<ConnectionCapabilities>& SyncClient::getConnectionCapabilities() const {
+    return m_connection_capabilities;
+}
+
+SyncClientResult<void> SyncClient::sendSubscriptionChange(const std::string& topic,
+                                                          const bool subscribe,
+                                                          const std::chrono::steady_clock::time_point deadline) {
+    const auto request_id = m_next_request_id++;
+    const _detail::FrameHeader header{
+        .flags = subscribe ? _detail::k_frame_flag_subscribe : _detail::k_frame_flag_unsubscribe,
+        .request_id = request_id};
+
+    const auto acknowledge_result = m_client->sendAndReceiveMessage(topic, header, deadline);
+    if (!acknowledge_result.has_value()) {
+        if (acknowledge_result.error().type == _detail::UnixDomainClientError::DeadlineExceeded) {
+            return std::unexpected(Error(SyncClientError::DeadlineExceeded, "Subscription was not acknowledged"));
+        }
+
+        return std::unexpected(Error(SyncClientError::UnableToSendMessage, acknowledge_result.error().message));
+    }
+
+    auto server_error = extractServerError(acknowledge_result.value());
+    if (server_error.has_value()) {
+        return std::unexpected(std::move(server_error.value()));
+    }
+
+    return {};
+}
+
 SyncClientResult<_detail::SerializedProtoPayload> SyncClient::sendAndReceiveMessage(
-    const _detail::SerializedProtoPayload& serialized) const {
-    const auto send_result = m_client->sendMessage(serialized);
+    const _detail::SerializedProtoPayload& serialized, const RequestOptions& request_options) {
+    const auto deadline = request_options.deadline;
+    if (deadline <= std::chrono::steady_clock::now()) {
+        return std::unexpected(Error(SyncClientError::DeadlineExceeded, "Deadline passed before the request was sent"));
+    }
+
+    const auto size_result = checkRequestSize(serialized);
+    if (!size_result.has_value()) {
+        return std::unexpected(size_result.error());
+    }
+
+    const auto request_id = m_next_request_id++;
+    const _detail::FrameHeader header{.priority = _detail::encodeRequestPriority(request_options.priority),
+                                      .request_id = request_id,
+                                      .deadline_ns = _detail::toDeadlineNs(deadline)};
+
+    const auto send_result = m_client->sendMessage(serialized, header, deadline);
     if (!send_result.has_value()) {
+        if (send_result.error().type == _detail::UnixDomainClientError::DeadlineExceeded) {
+            return std::unexpected(Error(SyncClientError::DeadlineExceeded, "Deadline passed while sending"));
+        }
+
+        if (send_result.error().type == _detail::UnixDomainClientError::MessageTooLarge) {
+            return std::unexpected(Error(SyncClientError::MessageTooLarge, send_result.error().message));
+        }
+
+        // A server rejecting the connection writes the error frame and closes, it may still be readable
+        const auto rejection = m_client->receiveMessage(request_id, deadline);
+        if (rejection.has_value()) {
+            auto server_error = extractServerError(rejection.value());
+            if (server_error.has_value()) {
+                return std::unexpected(std::move(server_error.value()));
+            }
+        }
+
         return std::unexpected(Error(SyncClientError::UnableToSendMessage, send_result.error().message));
     }
 
-    const auto receive_result = m_client->receiveMessage();
+    auto receive_result = m_client->receiveMessage(request_id, deadline);
     if (!receive_result.has_value()) {
+        if (receive_result.error().type == _detail::UnixDomainClientError::DeadlineExceeded) {
+            return std::unexpected(Error(SyncClientError::DeadlineExceeded, "Deadline passed awaiting the response"));
+        }
+
+        if (receive_result.error().type == _detail::UnixDomainClientError::MessageTooLarge) {
+            return std::unexpected(Error(SyncClientError::MessageTooLarge, receive_result.error().message));
+        }
+
         return std::unexpected(Error(SyncClientError::UnableToReceiveMessage, receive_result.error().message));
     }
 
-    return receive_result.value();
+    auto server_error = extractServerError(receive_result.value());
+    if (server_error.has_value()) {
+        return std::unexpected(std::move(server_error.value()));
+    }
+
+    return std::move(receive_result.value());
 }
 }  // namespace ipcourier
+
+namespace ipcourier::_detail {
+bool keepsConnection(const SyncClientError error) {
+    return error == SyncClientError::ServerOverloaded || error == SyncClientError::HandlerNotRegistered ||
+           error == SyncClientError::RequestRejected || error == SyncClientError::HandlerFailed;
+}
+}  // namespace ipcourier::_detail
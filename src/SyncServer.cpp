@@ -15,27 +15,85 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
  ***************************************************************************/
 
-#include "SyncUnixDomainServer.hpp"
+#include "Handshake.hpp"
+#include "ResponseCache.hpp"
+#include "UnixDomainServerBackend.hpp"
 
+#include <algorithm>
+#include <stdexcept>
+
+#include <InterProcessCourier/Metadata.hpp>
 #include <InterProcessCourier/SyncServer.hpp>
 #include <boost/asio.hpp>
 
 #include "InternalRequests.pb.h"
 
 namespace ipcourier {
+// Remembers whether the handler took the request over, it then answers the request itself even if it throws
+class TrackedResponseDeferral final : public _detail::ResponseDeferral {
+public:
+    explicit TrackedResponseDeferral(ResponseDeferral& deferral) : m_deferral(deferral) {
+    }
+
+    _detail::DeferredResponseCallback defer() override {
+        m_deferred = true;
+        return m_deferral.defer();
+    }
+
+    bool isDeferred() const {
+        return m_deferred;
+    }
+
+private:
+    ResponseDeferral& m_deferral;
+    bool m_deferred = false;
+};
+
 SyncServer::SyncServer(std::string socket_addr, SyncServerOptions server_options) :
     m_server_options(std::move(server_options)), m_socket_addr(std::move(socket_addr)),
     m_io_context(std::make_unique<boost::asio::io_context>()) {
-    m_server = std::make_unique<_detail::SyncUnixDomainServer>(
-        *m_io_context, m_socket_addr, [this](const _detail::ProtocolMessage& msg) {
-            // TODO: acceptMessage error handling should be exception?
-            const auto accept_result = acceptMessage(msg);
-            if (!accept_result.has_value()) {
-                throw std::runtime_error(std::format("Error while accepting message: {}", accept_result.error()));
-            }
+    if (m_server_options.traffic_capture.has_value()) {
+        auto capture_result = _detail::TrafficCaptureWriter::open(m_server_options.traffic_capture.value());
+        if (!capture_result.has_value()) {
+            throw std::runtime_error(std::format("Unable to capture traffic: {}", capture_result.error().message));
+        }
+
+        m_traffic_capture = std::move(capture_result.value());
+    }
+
+    m_server = _detail::makeUnixDomainServerBackend(
+        *m_io_context,
+        m_socket_addr,
+        [this](const _detail::ProtocolMessage& msg,
+               _detail::ResponseDeferral& deferral) -> std::optional<_detail::ProtocolMessage> {
+            // Failures are answered with an error response, the connection and the server keep running
+            TrackedResponseDeferral tracked_deferral(deferral);
+            try {
+                auto accept_result = acceptMessage(msg, tracked_deferral);
+                if (!accept_result.has_value()) {
+                    return _detail::makeErrorResponse(accept_result.error().type, accept_result.error().message.str());
+                }
+
+                return std::move(accept_result.value());
+            } catch (const std::exception& exception) {
+                if (tracked_deferral.isDeferred()) {
+                    return std::nullopt;
+                }
 
-            return accept_result.value();
-        });
+                return _detail::makeErrorResponse(SyncServerError::RuntimeError,
+                                                  std::format("Handler threw: {}", exception.what()));
+            } catch (...) {
+                if (tracked_deferral.isDeferred()) {
+                    return std::nullopt;
+                }
+
+                return _detail::makeErrorResponse(SyncServerError::RuntimeError,
+                                                  "Handler threw an exception not derived from std::exception");
+            }
+        },
+        [this](const _detail::ProtocolMessage& msg) { return resolveRequestPriority(msg); },
+        m_traffic_capture.get(),
+        m_server_options);
 
     using MappingReflectionRequest = internal_request_proto::IPCInternal_GetRequestResponseMappingPairsRequest;
     using MappingReflectionResponse = internal_request_proto::IPCInternal_GetRequestResponseMappingPairsResponse;
@@ -50,6 +108,13 @@ SyncServer::SyncServer(std::string socket_addr, SyncServerOptions server_options
 
         return response;
     });
+
+    // Kept out of the request-response pairs, a router reflecting them would otherwise forward its own hello
+    const std::string hello_type_name(_detail::k_hello_type_name);
+    m_handlers[hello_type_name] = [this](std::string_view, const std::string_view body, _detail::ResponseDeferral&) {
+        return answerHello(body);
+    };
+    m_handler_priorities[hello_type_name] = RequestPriority::High;
 }
 
 SyncServerResult<void> SyncServer::start() const {
@@ -62,24 +127,158 @@ SyncServerResult<void> SyncServer::start() const {
     return {};
 }
 
-SyncServer::~SyncServer() = default;
+ServerBackend SyncServer::getBackend() const {
+    return m_server->getType();
+}
+
+BusyPollStatistics SyncServer::getBusyPollStatistics() const {
+    return m_server->getBusyPollStatistics();
+}
 
-SyncServerResult<_detail::SerializedProtoPayload> SyncServer::acceptMessage(
-    const _detail::SerializedProtoPayload& serialized) {
-    const auto msg_result = _detail::makeBaseProtoFromPayload(serialized);
-    if (!msg_result.has_value()) {
-        return std::unexpected(Error(SyncServerError::UnableToDeserializeMessage, msg_result.error().message));
+TrafficCaptureStatistics SyncServer::getTrafficCaptureStatistics() const {
+    if (m_traffic_capture == nullptr) {
+        return {};
     }
 
-    const auto& msg = msg_result.value();
+    return m_traffic_capture->getStatistics();
+}
+
+SyncServer::~SyncServer() = default;
+
+void SyncServer::publishPayload(const std::string& topic, const _detail::SerializedProtoPayload& payload) {
+    m_server->publish(_detail::makePublishedEvent(topic, payload));
+}
+
+SyncServer::GenericHandlerResult SyncServer::acceptMessage(const _detail::SerializedProtoPayload& serialized,
+                                                           _detail::ResponseDeferral& deferral) {
+    // Only the type name is looked at here, each handler decides whether and how to parse the body
+    const auto parts = _detail::splitProtoPayload(serialized);
+    if (!parts.has_value()) {
+        return std::unexpected(Error(SyncServerError::UnableToDeserializeMessage, "Received message has no type name"));
+    }
 
-    const auto type_name = msg->GetDescriptor()->full_name();
-    const auto it = m_handlers.find(type_name);
+    const auto it = m_handlers.find(parts->type_name);
     if (it == m_handlers.end()) {
-        return std::unexpected(
-            Error(SyncServerError::HandlerNotRegistered, std::format("No handler for {} registered", type_name)));
+        return std::unexpected(Error(SyncServerError::HandlerNotRegistered,
+                                     ErrorMessage::format("No handler for {} registered", parts->type_name)));
+    }
+
+    return it->second(parts->type_name, parts->body, deferral);
+}
+
+SyncServer::GenericHandlerResult SyncServer::answerHello(const std::string_view client_hello_body) const {
+    const auto client_hello = _detail::decodeHello(client_hello_body);
+    if (!client_hello.has_value()) {
+        return std::unexpected(Error(SyncServerError::UnableToDeserializeMessage, "Malformed hello"));
+    }
+
+    _detail::Hello server_hello;
+    server_hello.protocol_version = std::min(client_hello->protocol_version, _detail::k_wire_protocol_version);
+    server_hello.features = _detail::getSupportedWireFeatures() & client_hello->features;
+    server_hello.max_request_size = m_server_options.max_request_size;
+    server_hello.max_response_size = m_server_options.max_response_size;
+    server_hello.library_version = getLibraryVersion();
+    if (client_hello->wants_mappings) {
+        server_hello.mappings.emplace(m_request_response_pairs.begin(), m_request_response_pairs.end());
+    }
+
+    return _detail::createProtoPayload(_detail::k_hello_type_name, _detail::encodeHello(server_hello));
+}
+
+bool SyncServer::registerRawHandler(const std::string& request_name,
+                                    const std::string& response_name,
+                                    RawHandler handler,
+                                    const RequestPriority priority) {
+    return registerGenericHandler(
+        request_name,
+        response_name,
+        [handler = std::move(handler)](const std::string_view type_name,
+                                       const std::string_view body,
+                                       _detail::ResponseDeferral&) -> GenericHandlerResult {
+            return _detail::takeRawMessagePayload(handler(type_name, body));
+        },
+        priority);
+}
+
+bool SyncServer::registerRawOneWayHandler(const std::string& request_name,
+                                          RawOneWayHandler handler,
+                                          const RequestPriority priority) {
+    return registerGenericHandler(
+        request_name,
+        std::string(_detail::k_one_way_response_name),
+        [handler = std::move(handler)](const std::string_view type_name,
+                                       const std::string_view body,
+                                       _detail::ResponseDeferral&) -> GenericHandlerResult {
+            handler(type_name, body);
+            return _detail::SerializedProtoPayload{};
+        },
+        priority);
+}
+
+bool SyncServer::registerCachedGenericHandler(const std::string& request_name,
+                                              const std::string& response_name,
+                                              GenericHandler handler,
+                                              const ResponseCacheOptions& cache_options,
+                                              const RequestPriority priority) {
+    // Shared, since the handler is copied whenever the std::function holding it is
+    auto cache = std::make_shared<_detail::ResponseCache>(cache_options);
+    return registerGenericHandler(
+        request_name,
+        response_name,
+        [handler = std::move(handler), cache = std::move(cache)](const std::string_view type_name,
+                                                                 const std::string_view body,
+                                                                 _detail::ResponseDeferral& deferral)
+            -> GenericHandlerResult {
+            // Copied outside of the cache's lock, the frame written to the socket needs its own payload
+            if (const auto cached = cache->find(body); cached != nullptr) {
+                return *cached;
+            }
+
+            auto result = handler(type_name, body, deferral);
+            if (result.has_value() && result->has_value()) {
+                cache->insert(body, result->value());
+            }
+
+            return result;
+        },
+        priority);
+}
+
+bool SyncServer::registerGenericHandler(const std::string& request_name,
+                                        const std::string& response_name,
+                                        GenericHandler handler,
+                                        const RequestPriority priority) {
+    if (m_handlers.contains(request_name)) {
+        const auto register_handler = [this, &handler, priority](const auto& handler_request_name,
+                                                                 const auto& handler_response_name) {
+            this->registerValidatedRequestResponsePair(
+                handler_request_name, handler_response_name, std::move(handler), priority);
+        };
+        return _detail::registerDuplicateRequestResponsePair(
+            m_server_options.duplicate_registration_strategy, register_handler, request_name, response_name);
+    }
+
+    registerValidatedRequestResponsePair(request_name, response_name, std::move(handler), priority);
+    return true;
+}
+
+void SyncServer::registerValidatedRequestResponsePair(const std::string& request_name,
+                                                      const std::string& response_name,
+                                                      GenericHandler handler,
+                                                      const RequestPriority priority) {
+    m_handlers[request_name] = std::move(handler);
+    m_handler_priorities[request_name] = priority;
+    m_request_response_pairs[request_name] = response_name;
+}
+
+RequestPriority SyncServer::resolveRequestPriority(const _detail::SerializedProtoPayload& serialized) const {
+    // Only the type name prefix is needed, the payload is not parsed before the request is scheduled
+    const auto type_name = std::string_view(serialized).substr(0, serialized.find(':'));
+    const auto it = m_handler_priorities.find(type_name);
+    if (it == m_handler_priorities.end()) {
+        return RequestPriority::Normal;
     }
 
-    return it->second(*msg);
+    return it->second;
 }
 }  // namespace ipcourier
@@ -17,75 +17,450 @@
 
 #include "SyncUnixDomainClient.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <limits>
+
+#include <poll.h>
+#include <sys/socket.h>
+
 namespace ipcourier::_detail {
-SyncUnixDomainClient::SyncUnixDomainClient(boost::asio::io_context& io_context) : m_socket(io_context) {
+constexpr std::size_t k_read_chunk_size = 64 * 1024;
+constexpr std::size_t k_max_pending_output_size = 4 * 1024 * 1024;
+constexpr std::size_t k_max_records_per_send = 64;
+
+SyncUnixDomainClient::SyncUnixDomainClient(boost::asio::io_context& io_context,
+                                           const SyncClientOptions& client_options) :
+    m_transport(client_options.transport), m_max_request_size(client_options.max_request_size),
+    m_max_response_size(client_options.max_response_size), m_cork_window(client_options.cork_window),
+    m_cork_max_bytes(client_options.cork_max_bytes), m_stream_socket(io_context),
+    m_seqpacket_socket(io_context), m_frame_reader(m_max_response_size),
+    m_busy_poller(client_options.busy_poll_budget) {
 }
 
 UnixDomainClientResult<void> SyncUnixDomainClient::connect(const std::string& addr) {
+    const boost::asio::local::stream_protocol::endpoint endpoint(addr);
     try {
-        m_socket.connect(boost::asio::local::stream_protocol::endpoint(addr));
+        // Deadlines are enforced by polling, a blocking call could otherwise outlive them
+        if (m_transport == Transport::SeqPacket) {
+            m_seqpacket_socket.connect(boost::asio::generic::seq_packet_protocol::endpoint(endpoint));
+            m_seqpacket_socket.non_blocking(true);
+
+            // A request record has to fit into the send buffer, raise it as far as the kernel permits
+            boost::system::error_code ignored_error;
+            m_seqpacket_socket.set_option(
+                boost::asio::socket_base::send_buffer_size(static_cast<int>(k_max_seqpacket_frame_size)),
+                ignored_error);
+        } else {
+            m_stream_socket.connect(endpoint);
+            m_stream_socket.non_blocking(true);
+        }
     } catch (const std::exception& e) {
         return std::unexpected(Error(UnixDomainClientError::ConnectionFailed, e.what()));
     }
 
+    m_output.clear();
+    m_output_offset = 0;
+    m_output_record_sizes.clear();
+    m_corked_since.reset();
+    m_frame_reader = FrameReader(m_max_response_size);
     return {};
 }
 
 void SyncUnixDomainClient::disconnect() {
-    m_socket.close();
+    if (m_transport == Transport::SeqPacket) {
+        m_seqpacket_socket.close();
+    } else {
+        m_stream_socket.close();
+    }
 }
 
-UnixDomainClientResult<void> SyncUnixDomainClient::sendMessage(const ProtocolMessage& message) {
-    const auto payload_length = static_cast<std::uint32_t>(message.length());
-    ProtocolMessageBuffer payload_buffer;
-    payload_buffer.resize(k_payload_length_header_size + payload_length);
+UnixDomainClientResult<void> SyncUnixDomainClient::sendMessage(const ProtocolMessage& message,
+                                                               FrameHeader header,
+                                                               const Deadline deadline) {
+    const auto append_result = appendFrame(message, header);
+    if (!append_result.has_value()) {
+        return std::unexpected(append_result.error());
+    }
 
-    std::memcpy(payload_buffer.data(), &payload_length, k_payload_length_header_size);
-    std::memcpy(payload_buffer.data() + k_payload_length_header_size, message.data(), message.length());
+    return flushOutput(deadline);
+}
 
-    try {
-        boost::asio::write(m_socket, boost::asio::buffer(payload_buffer));
-    } catch (std::exception& e) {
-        return std::unexpected(Error(UnixDomainClientError::UnableToSendMessage, e.what()));
+UnixDomainClientResult<void> SyncUnixDomainClient::postMessage(const ProtocolMessage& message,
+                                                               const FrameHeader header) {
+    if (m_output.size() - m_output_offset >= k_max_pending_output_size) {
+        // The socket may have drained since the last call, only give up if it is still full
+        const auto write_result = writeQueuedOutput();
+        if (!write_result.has_value()) {
+            return std::unexpected(write_result.error());
+        }
+
+        const auto pending_output_size = m_output.size() - m_output_offset;
+        if (pending_output_size >= k_max_pending_output_size) {
+            return std::unexpected(Error(UnixDomainClientError::SendBufferFull,
+                                         std::format("{} bytes are waiting to be sent", pending_output_size)));
+        }
+    }
+
+    const auto append_result = appendFrame(message, header);
+    if (!append_result.has_value()) {
+        return std::unexpected(append_result.error());
+    }
+
+    if (holdsCorkedOutput()) {
+        return {};
+    }
+
+    const auto write_result = writeQueuedOutput();
+    if (!write_result.has_value()) {
+        return std::unexpected(write_result.error());
     }
 
     return {};
 }
 
-UnixDomainClientResult<ProtocolMessage> SyncUnixDomainClient::receiveMessage() {
-    try {
-        ProtocolMessageBuffer message_length_header_reply_buffer;
-        message_length_header_reply_buffer.resize(k_payload_length_header_size);
+UnixDomainClientResult<void> SyncUnixDomainClient::flush() {
+    return flushOutput(Deadline::max());
+}
 
-        auto reply_length =
-            m_socket.read_some(boost::asio::buffer(message_length_header_reply_buffer, k_payload_length_header_size));
-        if (reply_length != k_payload_length_header_size) {
-            return std::unexpected(Error(UnixDomainClientError::NotEnoughBytesReceived));
+UnixDomainClientResult<ProtocolMessage> SyncUnixDomainClient::receiveMessage(const std::uint64_t request_id,
+                                                                             const Deadline deadline) {
+    while (true) {
+        auto message = takeReceivedFrames(request_id);
+        if (message.has_value()) {
+            return std::move(message.value());
         }
 
-        std::uint32_t message_length = 0;
-        std::memcpy(&message_length, message_length_header_reply_buffer.data(), k_payload_length_header_size);
+        const auto read_result = readIntoInput(deadline);
+        if (!read_result.has_value()) {
+            return std::unexpected(read_result.error());
+        }
+    }
+}
 
-        ProtocolMessageBuffer reply_buffer;
-        reply_buffer.resize(message_length);
+UnixDomainClientResult<std::vector<ProtocolMessage> > SyncUnixDomainClient::receiveEvents(const Deadline deadline) {
+    // Held back messages may be what the awaited events answer
+    const auto write_result = writeQueuedOutput();
+    if (!write_result.has_value()) {
+        return std::unexpected(write_result.error());
+    }
 
-        reply_length = m_socket.read_some(boost::asio::buffer(reply_buffer.data(), message_length));
-        if (reply_length != message_length) {
-            return std::unexpected(Error(UnixDomainClientError::NotEnoughBytesReceived));
+    while (true) {
+        takeReceivedFrames(std::nullopt);
+        if (!m_events.empty()) {
+            std::vector<ProtocolMessage> events(std::make_move_iterator(m_events.begin()),
+                                                std::make_move_iterator(m_events.end()));
+            m_events.clear();
+            return events;
         }
 
-        return ProtocolMessage(reply_buffer.begin(), reply_buffer.end());
-    } catch (const std::exception& e) {
-        return std::unexpected(Error(UnixDomainClientError::UnableToReceiveMessage, e.what()));
+        const auto read_result = readIntoInput(deadline);
+        if (!read_result.has_value()) {
+            if (read_result.error().type == UnixDomainClientError::DeadlineExceeded) {
+                return std::vector<ProtocolMessage>{};
+            }
+            return std::unexpected(read_result.error());
+        }
     }
 }
 
-UnixDomainClientResult<ProtocolMessage> SyncUnixDomainClient::sendAndReceiveMessage(const ProtocolMessage& message) {
-    const auto send_result = sendMessage(message);
+UnixDomainClientResult<ProtocolMessage> SyncUnixDomainClient::sendAndReceiveMessage(const ProtocolMessage& message,
+                                                                                    const FrameHeader& header,
+                                                                                    const Deadline deadline) {
+    const auto send_result = sendMessage(message, header, deadline);
     if (!send_result.has_value()) {
         return std::unexpected(send_result.error());
     }
 
-    return receiveMessage();
+    return receiveMessage(header.request_id, deadline);
+}
+
+BusyPollStatistics SyncUnixDomainClient::getBusyPollStatistics() const {
+    return m_busy_poller.getStatistics();
+}
+
+std::optional<ProtocolMessage> SyncUnixDomainClient::takeReceivedFrames(const std::optional<std::uint64_t> request_id) {
+    while (const auto frame = m_frame_reader.next()) {
+        const auto& header = frame->header;
+        if (hasFrameFlag(header, k_frame_flag_event)) {
+            m_events.emplace_back(frame->payload);
+        } else if (request_id.has_value() &&
+                   (header.request_id == request_id.value() || header.request_id == k_connection_request_id)) {
+            return ProtocolMessage(frame->payload);
+        }
+    }
+
+    return std::nullopt;
+}
+
+int SyncUnixDomainClient::nativeHandle() {
+    return m_transport == Transport::SeqPacket ? m_seqpacket_socket.native_handle() : m_stream_socket.native_handle();
+}
+
+UnixDomainClientResult<void> SyncUnixDomainClient::appendFrame(const ProtocolMessage& message, FrameHeader header) {
+    if (message.length() > m_max_request_size) {
+        return std::unexpected(Error(UnixDomainClientError::MessageTooLarge,
+                                     std::format("Request of {} bytes exceeds the maximum of {} bytes",
+                                                 message.length(),
+                                                 m_max_request_size)));
+    }
+
+    const auto frame_size = k_frame_header_size + message.length();
+    if (m_transport == Transport::SeqPacket && frame_size > k_max_seqpacket_frame_size) {
+        return std::unexpected(
+            Error(UnixDomainClientError::MessageTooLarge,
+                  std::format("Frame of {} bytes exceeds the seqpacket limit of {} bytes",
+                              frame_size,
+                              k_max_seqpacket_frame_size)));
+    }
+
+    header.payload_length = static_cast<std::uint32_t>(message.length());
+
+    // Drop the already written prefix once it dominates, so a steadily backlogged stream stays bounded
+    if (m_output_offset > 0 && m_output_offset >= m_output.size() / 2) {
+        m_output.erase(m_output.begin(), m_output.begin() + static_cast<std::ptrdiff_t>(m_output_offset));
+        m_output_offset = 0;
+    }
+
+    const auto frame_offset = m_output.size();
+    m_output.resize(frame_offset + frame_size);
+    encodeFrameHeader(header, m_output.data() + frame_offset);
+    std::memcpy(m_output.data() + frame_offset + k_frame_header_size, message.data(), message.length());
+
+    if (m_transport == Transport::SeqPacket) {
+        m_output_record_sizes.push_back(frame_size);
+    }
+
+    return {};
+}
+
+bool SyncUnixDomainClient::holdsCorkedOutput() {
+    if (m_cork_window.count() <= 0) {
+        return false;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (!m_corked_since.has_value()) {
+        m_corked_since = now;
+    }
+
+    return now - m_corked_since.value() < m_cork_window && m_output.size() - m_output_offset < m_cork_max_bytes;
+}
+
+UnixDomainClientResult<void> SyncUnixDomainClient::flushOutput(const Deadline deadline) {
+    while (true) {
+        const auto write_result = writeQueuedOutput();
+        if (!write_result.has_value()) {
+            return std::unexpected(write_result.error());
+        }
+
+        if (write_result.value()) {
+            return {};
+        }
+
+        const auto wait_result = waitUntilReady(POLLOUT, deadline);
+        if (!wait_result.has_value()) {
+            return std::unexpected(wait_result.error());
+        }
+    }
+}
+
+UnixDomainClientResult<bool> SyncUnixDomainClient::writeQueuedOutput() {
+    if (m_transport == Transport::SeqPacket) {
+        return writeQueuedRecords();
+    }
+
+    while (m_output_offset < m_output.size()) {
+        boost::system::error_code error;
+        const auto bytes_written = m_stream_socket.write_some(
+            boost::asio::buffer(m_output.data() + m_output_offset, m_output.size() - m_output_offset), error);
+        m_output_offset += bytes_written;
+
+        if (error == boost::asio::error::would_block) {
+            return false;
+        }
+
+        if (error) {
+            return std::unexpected(Error(UnixDomainClientError::UnableToSendMessage, error.message()));
+        }
+    }
+
+    releaseWrittenOutput();
+    return true;
+}
+
+UnixDomainClientResult<bool> SyncUnixDomainClient::writeQueuedRecords() {
+    std::array<mmsghdr, k_max_records_per_send> messages{};
+    std::array<iovec, k_max_records_per_send> buffers{};
+    while (!m_output_record_sizes.empty()) {
+        const auto record_count = std::min(m_output_record_sizes.size(), k_max_records_per_send);
+        auto record_offset = m_output_offset;
+        for (std::size_t index = 0; index < record_count; ++index) {
+            buffers[index].iov_base = m_output.data() + record_offset;
+            buffers[index].iov_len = m_output_record_sizes[index];
+            messages[index] = mmsghdr{};
+            messages[index].msg_hdr.msg_iov = &buffers[index];
+            messages[index].msg_hdr.msg_iovlen = 1;
+            record_offset += m_output_record_sizes[index];
+        }
+
+        const auto sent_count = ::sendmmsg(m_seqpacket_socket.native_handle(),
+                                           messages.data(),
+                                           static_cast<unsigned>(record_count),
+                                           MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (sent_count < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (sent_count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return false;
+        }
+
+        // A record is sent whole or not at all, one the kernel refuses is dropped so the queue does not stall
+        if (sent_count < 0 && errno != EMSGSIZE) {
+            return std::unexpected(Error(UnixDomainClientError::UnableToSendMessage, std::strerror(errno)));
+        }
+
+        if (sent_count < 0) {
+            const auto record_size = m_output_record_sizes.front();
+            m_output_offset += record_size;
+            m_output_record_sizes.pop_front();
+            return std::unexpected(Error(UnixDomainClientError::UnableToSendMessage,
+                                         std::format("Record of {} bytes: {}", record_size, std::strerror(EMSGSIZE))));
+        }
+
+        // The rest of a partial batch is retried, which reports why the kernel stopped accepting records
+        for (int index = 0; index < sent_count; ++index) {
+            m_output_offset += m_output_record_sizes.front();
+            m_output_record_sizes.pop_front();
+        }
+    }
+
+    releaseWrittenOutput();
+    return true;
+}
+
+void SyncUnixDomainClient::releaseWrittenOutput() {
+    m_output.clear();
+    m_output_offset = 0;
+    m_corked_since.reset();
+
+    // The buffer is reused for the next frames, unless an exceptionally large message made it grow
+    if (m_output.capacity() > k_retained_buffer_size) {
+        m_output.shrink_to_fit();
+    }
+}
+
+UnixDomainClientResult<void> SyncUnixDomainClient::readIntoInput(const Deadline deadline) {
+    // Rejected from the header alone, none of the payload is buffered
+    const auto oversized_header = m_frame_reader.getOversizedFrameHeader();
+    if (oversized_header.has_value()) {
+        disconnect();
+        return std::unexpected(Error(UnixDomainClientError::MessageTooLarge,
+                                     std::format("Response of {} bytes exceeds the maximum of {} bytes",
+                                                 oversized_header->payload_length,
+                                                 m_max_response_size)));
+    }
+
+    while (true) {
+        const auto read_result =
+            m_transport == Transport::SeqPacket ? receiveRecordIntoInput() : readChunkIntoInput();
+        if (!read_result.has_value()) {
+            return std::unexpected(read_result.error());
+        }
+
+        if (read_result.value()) {
+            return {};
+        }
+
+        const auto wait_result = waitUntilReady(POLLIN, deadline);
+        if (!wait_result.has_value()) {
+            return std::unexpected(wait_result.error());
+        }
+    }
+}
+
+UnixDomainClientResult<bool> SyncUnixDomainClient::readChunkIntoInput() {
+    const auto space = m_frame_reader.prepare(k_read_chunk_size);
+
+    boost::system::error_code error;
+    const auto bytes_read = m_stream_socket.read_some(boost::asio::buffer(space.data(), space.size()), error);
+    m_frame_reader.commit(bytes_read);
+
+    if (bytes_read > 0) {
+        return true;
+    }
+
+    if (error == boost::asio::error::would_block) {
+        return false;
+    }
+
+    if (error == boost::asio::error::eof) {
+        return std::unexpected(Error(UnixDomainClientError::NotEnoughBytesReceived, error.message()));
+    }
+
+    return std::unexpected(Error(UnixDomainClientError::UnableToReceiveMessage, error.message()));
+}
+
+UnixDomainClientResult<bool> SyncUnixDomainClient::receiveRecordIntoInput() {
+    // MSG_TRUNC makes the kernel report the full record size, so an oversized record is detected
+    const auto space = m_frame_reader.prepare(k_max_seqpacket_frame_size);
+    const auto received = ::recv(m_seqpacket_socket.native_handle(), space.data(), space.size(), MSG_TRUNC);
+    if (received > 0 && static_cast<std::size_t>(received) <= space.size()) {
+        m_frame_reader.commit(static_cast<std::size_t>(received));
+        return true;
+    }
+
+    if (received > 0) {
+        return std::unexpected(
+            Error(UnixDomainClientError::UnableToReceiveMessage,
+                  std::format("Record of {} bytes exceeds the seqpacket limit of {} bytes",
+                              received,
+                              k_max_seqpacket_frame_size)));
+    }
+
+    if (received == 0) {
+        return std::unexpected(Error(UnixDomainClientError::NotEnoughBytesReceived, "Connection closed by the server"));
+    }
+
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+        return false;
+    }
+
+    return std::unexpected(Error(UnixDomainClientError::UnableToReceiveMessage, std::strerror(errno)));
+}
+
+UnixDomainClientResult<void> SyncUnixDomainClient::waitUntilReady(const short events, const Deadline deadline) {
+    pollfd poll_descriptor{.fd = nativeHandle(), .events = events, .revents = 0};
+
+    // Checking readiness without a timeout never puts the thread to sleep, so nothing has to wake it up either
+    const auto is_ready = [&poll_descriptor] { return ::poll(&poll_descriptor, 1, 0) > 0; };
+    if (m_busy_poller.isEnabled() && m_busy_poller.poll(is_ready)) {
+        return {};
+    }
+
+    while (true) {
+        int timeout_ms = -1;
+        if (deadline != Deadline::max()) {
+            const auto remaining = deadline - std::chrono::steady_clock::now();
+            if (remaining <= Deadline::duration::zero()) {
+                return std::unexpected(Error(UnixDomainClientError::DeadlineExceeded));
+            }
+            const auto remaining_ms = std::chrono::ceil<std::chrono::milliseconds>(remaining).count();
+            timeout_ms = static_cast<int>(std::min<std::int64_t>(remaining_ms, std::numeric_limits<int>::max()));
+        }
+
+        const auto result = ::poll(&poll_descriptor, 1, timeout_ms);
+        if (result > 0) {
+            return {};
+        }
+
+        if (result < 0 && errno != EINTR) {
+            return std::unexpected(Error(UnixDomainClientError::UnknownError, std::strerror(errno)));
+        }
+    }
 }
 }  // namespace ipcourier::_detail
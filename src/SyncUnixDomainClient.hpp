@@ -18,11 +18,20 @@
 #ifndef INTER_PROCESS_COURIER_SYNCUNIXDOMAINCLIENT_HPP
 #define INTER_PROCESS_COURIER_SYNCUNIXDOMAINCLIENT_HPP
 
+#include "BusyPoller.hpp"
+#include "FrameReader.hpp"
 #include "UnixDomainProtocol.hpp"
 
+#include <chrono>
+#include <cstdint>
+#include <deque>
 #include <expected>
+#include <optional>
+#include <vector>
 
 #include <InterProcessCourier/Error.hpp>
+#include <InterProcessCourier/SyncClient.hpp>
+#include <InterProcessCourier/SyncCommons.hpp>
 #include <boost/asio.hpp>
 
 namespace ipcourier::_detail {
@@ -32,6 +41,9 @@ enum class UnixDomainClientError {
     NotEnoughBytesReceived,
     UnableToSendMessage,
     UnableToReceiveMessage,
+    DeadlineExceeded,
+    SendBufferFull,
+    MessageTooLarge,
 };
 
 template <typename SuccessType>
@@ -39,20 +51,92 @@ using UnixDomainClientResult = std::expected<SuccessType, Error<UnixDomainClient
 
 class SyncUnixDomainClient {
 public:
-    explicit SyncUnixDomainClient(boost::asio::io_context& io_context);
+    using Deadline = std::chrono::steady_clock::time_point;
+
+    SyncUnixDomainClient(boost::asio::io_context& io_context, const SyncClientOptions& client_options);
 
     UnixDomainClientResult<void> connect(const std::string& addr);
 
     void disconnect();
 
-    UnixDomainClientResult<void> sendMessage(const ProtocolMessage& message);
+    // A frame cut short by the deadline stays queued and is completed before the next one, so the stream
+    // never desynchronizes, the server then drops it as expired
+    // The payload length of header is filled in from message
+    UnixDomainClientResult<void> sendMessage(const ProtocolMessage& message, FrameHeader header, Deadline deadline);
+
+    // Queues the frame behind any unsent data and writes as much as the socket accepts without blocking
+    // While corking, the frame is only queued unless the cork window passed or the cork byte limit is reached
+    UnixDomainClientResult<void> postMessage(const ProtocolMessage& message, FrameHeader header);
+
+    // Writes all queued frames, blocking until the socket accepted them
+    UnixDomainClientResult<void> flush();
 
-    UnixDomainClientResult<ProtocolMessage> receiveMessage();
+    // Frames answering other (abandoned) requests are discarded, connection-wide frames are always returned
+    // Event frames arriving meanwhile are kept for receiveEvents
+    // A frame exceeding the maximum response size disconnects, the stream cannot be read past it
+    UnixDomainClientResult<ProtocolMessage> receiveMessage(std::uint64_t request_id, Deadline deadline);
 
-    UnixDomainClientResult<ProtocolMessage> sendAndReceiveMessage(const ProtocolMessage& message);
+    // Returns the payloads of all events received so far, waiting until the deadline if there are none yet
+    // Reaching the deadline without any event is not an error, the result is empty then
+    UnixDomainClientResult<std::vector<ProtocolMessage> > receiveEvents(Deadline deadline);
+
+    UnixDomainClientResult<ProtocolMessage> sendAndReceiveMessage(const ProtocolMessage& message,
+                                                                  const FrameHeader& header,
+                                                                  Deadline deadline);
+
+    BusyPollStatistics getBusyPollStatistics() const;
 
 private:
-    boost::asio::local::stream_protocol::socket m_socket;
+    // Only the socket matching the transport is ever opened
+    Transport m_transport;
+    std::size_t m_max_request_size;
+    std::size_t m_max_response_size;
+    std::chrono::microseconds m_cork_window;
+    std::size_t m_cork_max_bytes;
+    boost::asio::local::stream_protocol::socket m_stream_socket;
+    boost::asio::generic::seq_packet_protocol::socket m_seqpacket_socket;
+
+    ProtocolMessageBuffer m_output;
+    std::size_t m_output_offset = 0;
+    FrameReader m_frame_reader;
+    std::deque<ProtocolMessage> m_events;
+
+    // Sizes of the frames queued in m_output, Transport::SeqPacket sends each of them as one record
+    std::deque<std::size_t> m_output_record_sizes;
+
+    // When the oldest frame held back by corking was queued, nothing if no frame is held back
+    std::optional<std::chrono::steady_clock::time_point> m_corked_since;
+
+    BusyPoller m_busy_poller;
+
+    // Consumes all complete frames up to the one answering request_id, which is returned
+    std::optional<ProtocolMessage> takeReceivedFrames(std::optional<std::uint64_t> request_id);
+
+    int nativeHandle();
+
+    UnixDomainClientResult<void> appendFrame(const ProtocolMessage& message, FrameHeader header);
+
+    // Returns whether the queued frames are held back for later ones, see SyncClientOptions::cork_window
+    bool holdsCorkedOutput();
+
+    UnixDomainClientResult<void> flushOutput(Deadline deadline);
+
+    // Returns whether all queued output was written
+    UnixDomainClientResult<bool> writeQueuedOutput();
+
+    // Sends up to k_max_records_per_send records with every sendmmsg call
+    UnixDomainClientResult<bool> writeQueuedRecords();
+
+    void releaseWrittenOutput();
+
+    UnixDomainClientResult<void> readIntoInput(Deadline deadline);
+
+    // Both return whether anything was received, false means the socket has nothing to read yet
+    UnixDomainClientResult<bool> readChunkIntoInput();
+
+    UnixDomainClientResult<bool> receiveRecordIntoInput();
+
+    UnixDomainClientResult<void> waitUntilReady(short events, Deadline deadline);
 };
 }  // namespace ipcourier::_detail
 
@@ -17,119 +17,608 @@
 
 #include "SyncUnixDomainServer.hpp"
 
-#include <stdexcept>
-#include <thread>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <utility>
+
+#include <sys/socket.h>
 
 namespace ipcourier::_detail {
-constexpr auto k_sync_server_loop_sleep_ms = std::chrono::milliseconds(100);
+// Frames already buffered are parsed first, a read is only issued once they are used up
+constexpr std::size_t k_min_read_size = 16 * 1024;
+
+// Responses queued at once per session rarely exceed a few, requests are pooled for the whole server
+constexpr std::size_t k_spare_frames_per_session = 4;
+constexpr std::size_t k_spare_request_buffers = 64;
+
+static ProtocolMessageBuffer makeResponseFrame(ProtocolMessageBuffer response_message_buffer,
+                                               const std::uint64_t request_id,
+                                               const ProtocolMessage& response) {
+    const FrameHeader header{.payload_length = static_cast<std::uint32_t>(response.length()), .request_id = request_id};
 
-SyncUnixDomainSession::SyncUnixDomainSession(boost::asio::local::stream_protocol::socket socket,
-                                             RequestHandler request_handler) :
-    m_socket(std::move(socket)), m_request_handler(std::move(request_handler)) {
+    response_message_buffer.resize(k_frame_header_size + response.length());
+
+    encodeFrameHeader(header, response_message_buffer.data());
+    std::memcpy(response_message_buffer.data() + k_frame_header_size, response.data(), response.length());
+
+    return response_message_buffer;
 }
 
-UnixDomainServerResult<void> SyncUnixDomainSession::start() {
-    try {
-        while (true) {
-            const auto read_header_result = readHeader();
-            if (!read_header_result.has_value()) {
-                return std::unexpected(read_header_result.error());
+template <typename Protocol>
+SyncUnixDomainSession<Protocol>::SyncUnixDomainSession(typename Protocol::socket socket,
+                                                       SyncUnixDomainServer<Protocol>& server,
+                                                       ServerAdmissionController& admission_controller,
+                                                       const std::uint64_t connection_id) :
+    m_socket(std::move(socket)), m_server(server), m_admission_controller(admission_controller),
+    m_connection_id(connection_id), m_frame_reader(server.getMaxRequestSize()),
+    m_frame_pool(k_spare_frames_per_session) {
+}
+
+template <typename Protocol>
+SyncUnixDomainSession<Protocol>::~SyncUnixDomainSession() {
+    m_server.unsubscribeAll(this);
+    releasePendingWrites();
+    if (m_admitted) {
+        m_admission_controller.releaseConnection();
+    }
+}
+
+template <typename Protocol>
+void SyncUnixDomainSession<Protocol>::start() {
+    m_admitted = true;
+    readNextFrame();
+}
+
+template <typename Protocol>
+void SyncUnixDomainSession<Protocol>::reject() {
+    queueWrite(PendingWrite{
+        .frame = makeResponseFrame(
+            m_frame_pool.take(), k_connection_request_id, m_admission_controller.getOverloadedResponse()),
+        .close_when_written = true});
+}
+
+template <typename Protocol>
+void SyncUnixDomainSession<Protocol>::respond(const std::uint64_t request_id,
+                                              const ProtocolMessage& response,
+                                              const std::size_t admitted_request_size) {
+    queueWrite(PendingWrite{.frame = makeResponseFrame(m_frame_pool.take(), request_id, response),
+                            .admitted_request_size = admitted_request_size,
+                            .resume_reading = true});
+}
+
+template <typename Protocol>
+void SyncUnixDomainSession<Protocol>::dropRequest(const std::size_t admitted_request_size) {
+    m_admission_controller.releaseRequest(admitted_request_size);
+    readNextFrame();
+}
+
+template <typename Protocol>
+void SyncUnixDomainSession<Protocol>::publishEvent(SharedPublishedEvent event,
+                                                   const SubscriptionOptions& subscription_options) {
+    if (!m_socket.is_open()) {
+        return;
+    }
+
+    if (!queueEventForSubscriber(m_pending_writes, std::move(event), subscription_options)) {
+        close();
+        return;
+    }
+
+    if (!m_current_write.has_value()) {
+        writeNext();
+    }
+}
+
+template <typename Protocol>
+void SyncUnixDomainSession<Protocol>::readNextFrame() {
+    if constexpr (k_is_seqpacket_transport<Protocol>) {
+        receiveRecord();
+    } else {
+        // Frames that arrived with an earlier read are served before the socket is read again
+        while (const auto frame = m_frame_reader.next()) {
+            if (!handleFrame(frame->header, frame->payload)) {
+                return;
             }
+        }
+
+        // The stream cannot be read past a frame whose payload is never buffered, the connection is closed
+        const auto oversized_header = m_frame_reader.getOversizedFrameHeader();
+        if (oversized_header.has_value()) {
+            rejectOversizedFrame(oversized_header.value());
+            return;
+        }
+
+        readAvailable();
+    }
+}
 
-            const auto read_body_result = readBody(read_header_result.value());
-            if (!read_body_result.has_value()) {
-                return std::unexpected(read_body_result.error());
+template <typename Protocol>
+void SyncUnixDomainSession<Protocol>::readAvailable() {
+    const auto space = m_frame_reader.prepare(k_min_read_size);
+    m_socket.async_read_some(
+        boost::asio::buffer(space.data(), space.size()),
+        [self = this->shared_from_this()](const boost::system::error_code& error, const std::size_t bytes_read) {
+            // Client disconnected or the connection broke, session ends
+            if (error) {
+                self->close();
+                return;
             }
 
-            const auto write_response_result = writeResponse(read_body_result.value());
-            if (!write_response_result.has_value()) {
-                return std::unexpected(write_response_result.error());
+            self->m_frame_reader.commit(bytes_read);
+            self->readNextFrame();
+        });
+}
+
+template <typename Protocol>
+void SyncUnixDomainSession<Protocol>::receiveRecord() {
+    m_socket.async_wait(
+        Protocol::socket::wait_read, [self = this->shared_from_this()](const boost::system::error_code& error) {
+            if (error) {
+                self->close();
+                return;
             }
 
-            // TODO Is 100ms alright?
-            std::this_thread::sleep_for(k_sync_server_loop_sleep_ms);
-        }
-    } catch (const boost::system::system_error& e) {
-        if (e.code() == boost::asio::error::eof || e.code() == boost::asio::error::bad_descriptor) {
-            // Client disconnected normally
-        } else {
-            // TODO: Maybe not general server session error, be more specific
-            return std::unexpected(Error(UnixDomainServerError::GeneralServerSessionError, e.what()));
+            // MSG_TRUNC makes the kernel report the full record size, so an oversized record is detected
+            auto& record_buffer = self->m_server.getRecordBuffer();
+            const auto received = ::recv(
+                self->m_socket.native_handle(), record_buffer.data(), record_buffer.size(), MSG_TRUNC | MSG_DONTWAIT);
+            if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+                self->receiveRecord();
+                return;
+            }
+
+            // Client disconnected, the connection broke or the record does not hold exactly one frame
+            const auto record_size = static_cast<std::size_t>(received);
+            if (received <= 0 || record_size > record_buffer.size() || record_size < k_frame_header_size) {
+                self->close();
+                return;
+            }
+
+            const auto header = decodeFrameHeader(record_buffer.data());
+            if (header.payload_length != record_size - k_frame_header_size) {
+                self->close();
+                return;
+            }
+
+            // Records are delimited by the kernel, so reading continues after an oversized one
+            if (header.payload_length > self->m_server.getMaxRequestSize()) {
+                if (isOneWay(header)) {
+                    self->receiveRecord();
+                    return;
+                }
+
+                self->queueWrite(PendingWrite{
+                    .frame = makeResponseFrame(
+                        self->m_frame_pool.take(), header.request_id, getRequestTooLargeResponse()),
+                    .resume_reading = true});
+                return;
+            }
+
+            const std::string_view payload(record_buffer.data() + k_frame_header_size, header.payload_length);
+            if (self->handleFrame(header, payload)) {
+                self->receiveRecord();
+            }
+        });
+}
+
+template <typename Protocol>
+bool SyncUnixDomainSession<Protocol>::handleFrame(const FrameHeader& header, const std::string_view payload) {
+    if (hasFrameFlag(header, k_frame_flag_subscribe) || hasFrameFlag(header, k_frame_flag_unsubscribe)) {
+        handleSubscriptionFrame(header, payload);
+        return false;
+    }
+
+    m_server.captureRequest(m_connection_id, header, payload);
+
+    // The caller already gave up, running the handler would be wasted work
+    if (isDeadlineExpired(header, std::chrono::steady_clock::now())) {
+        return true;
+    }
+
+    const auto one_way = isOneWay(header);
+    if (!m_admission_controller.tryAdmitRequest(payload.size())) {
+        if (one_way) {
+            return true;
         }
+
+        queueWrite(PendingWrite{
+            .frame = makeResponseFrame(
+                m_frame_pool.take(), header.request_id, m_admission_controller.getOverloadedResponse()),
+            .resume_reading = true});
+        return false;
     }
 
-    return {};
+    m_server.scheduleRequest(this->shared_from_this(), header, payload);
+
+    // Nothing is written back for one-way messages, so the next frame can be read right away
+    return one_way;
 }
 
-UnixDomainServerResult<std::uint32_t> SyncUnixDomainSession::readHeader() {
-    std::uint32_t msg_length = 0;
-    const auto bytes_read = boost::asio::read(m_socket, boost::asio::buffer(&msg_length, k_payload_length_header_size));
-    if (bytes_read != k_payload_length_header_size) {
-        std::unexpected(Error(UnixDomainServerError::NotEnoughBytesReceived));
+template <typename Protocol>
+void SyncUnixDomainSession<Protocol>::rejectOversizedFrame(const FrameHeader& header) {
+    if (isOneWay(header)) {
+        close();
+        return;
     }
 
-    return msg_length;
+    queueWrite(PendingWrite{
+        .frame = makeResponseFrame(m_frame_pool.take(), header.request_id, getRequestTooLargeResponse()),
+        .close_when_written = true});
 }
 
-UnixDomainServerResult<ProtocolMessageBuffer> SyncUnixDomainSession::readBody(const std::uint32_t msg_length) {
-    ProtocolMessageBuffer message_buffer;
-    message_buffer.resize(msg_length);
-    const auto bytes_read = boost::asio::read(m_socket, boost::asio::buffer(message_buffer, msg_length));
-    if (bytes_read != msg_length) {
-        return std::unexpected(Error(UnixDomainServerError::NotEnoughBytesReceived));
+template <typename Protocol>
+void SyncUnixDomainSession<Protocol>::handleSubscriptionFrame(const FrameHeader& header,
+                                                              const std::string_view payload) {
+    const std::string topic(payload);
+    if (hasFrameFlag(header, k_frame_flag_subscribe)) {
+        m_server.subscribe(this, topic);
+    } else {
+        m_server.unsubscribe(this, topic);
     }
 
-    const auto request = ProtocolMessage(message_buffer.begin(), message_buffer.begin() + bytes_read);
-    const auto response = m_request_handler(request);
+    // The empty acknowledgement tells the client that events of the topic are delivered from now on
+    queueWrite(
+        PendingWrite{.frame = makeResponseFrame(m_frame_pool.take(), header.request_id, {}), .resume_reading = true});
+}
 
-    const auto response_length = static_cast<uint32_t>(response.length());
+template <typename Protocol>
+void SyncUnixDomainSession<Protocol>::queueWrite(PendingWrite pending_write) {
+    // A response completing after the connection closed is never written, its request is done all the same
+    if (!m_socket.is_open()) {
+        if (pending_write.admitted_request_size.has_value()) {
+            m_admission_controller.releaseRequest(pending_write.admitted_request_size.value());
+        }
+        return;
+    }
 
-    ProtocolMessageBuffer response_message_buffer;
-    response_message_buffer.resize(k_payload_length_header_size + response.length());
+    m_pending_writes.push_back(std::move(pending_write));
+    if (!m_current_write.has_value()) {
+        writeNext();
+    }
+}
 
-    std::memcpy(response_message_buffer.data(), &response_length, k_payload_length_header_size);
-    std::memcpy(response_message_buffer.data() + k_payload_length_header_size, response.data(), response.length());
+template <typename Protocol>
+void SyncUnixDomainSession<Protocol>::writeNext() {
+    if (m_pending_writes.empty()) {
+        return;
+    }
 
-    return std::move(response_message_buffer);
-}
+    m_current_write = std::move(m_pending_writes.front());
+    m_pending_writes.pop_front();
 
-UnixDomainServerResult<void> SyncUnixDomainSession::writeResponse(const ProtocolMessageBuffer& response) {
-    try {
-        boost::asio::write(m_socket, boost::asio::buffer(response));
-    } catch (std::exception& e) {
-        return std::unexpected(Error(UnixDomainServerError::UnableToSendMessage, e.what()));
+    const auto buffer = m_current_write->event != nullptr ? boost::asio::buffer(m_current_write->event->frame)
+                                                          : boost::asio::buffer(std::as_const(m_current_write->frame));
+    auto on_written = [self = this->shared_from_this()](const boost::system::error_code& error, std::size_t) {
+        auto written = std::move(self->m_current_write.value());
+        self->m_current_write.reset();
+        self->m_frame_pool.recycle(std::move(written.frame));
+
+        if (written.admitted_request_size.has_value()) {
+            self->m_admission_controller.releaseRequest(written.admitted_request_size.value());
+        }
+
+        if (error || written.close_when_written) {
+            self->close();
+            return;
+        }
+
+        if (written.resume_reading) {
+            self->readNextFrame();
+        }
+
+        self->writeNext();
+    };
+
+    // A record is sent whole or not at all, so a single send writes the complete frame
+    if constexpr (k_is_seqpacket_transport<Protocol>) {
+        m_socket.async_send(buffer, 0, std::move(on_written));
+    } else {
+        boost::asio::async_write(m_socket, buffer, std::move(on_written));
     }
+}
 
-    return {};
+template <typename Protocol>
+void SyncUnixDomainSession<Protocol>::close() {
+    boost::system::error_code ignored_error;
+    m_socket.shutdown(Protocol::socket::shutdown_both, ignored_error);
+    m_socket.close(ignored_error);
+
+    // The write in flight completes with an error and releases its request itself
+    releasePendingWrites();
+}
+
+template <typename Protocol>
+void SyncUnixDomainSession<Protocol>::releasePendingWrites() {
+    for (const auto& pending_write : m_pending_writes) {
+        if (pending_write.admitted_request_size.has_value()) {
+            m_admission_controller.releaseRequest(pending_write.admitted_request_size.value());
+        }
+    }
+    m_pending_writes.clear();
 }
 
-SyncUnixDomainServer::SyncUnixDomainServer(boost::asio::io_context& io_context,
-                                           const std::string& socket_path,
-                                           RequestHandler request_handler) :
-    m_io_context(io_context), m_acceptor(io_context, boost::asio::local::stream_protocol::endpoint(socket_path)),
-    m_request_handler(std::move(request_handler)), m_socket_path(socket_path) {
+template <typename Protocol>
+SyncUnixDomainServer<Protocol>::SyncUnixDomainServer(boost::asio::io_context& io_context,
+                                                     const std::string& socket_path,
+                                                     RequestHandler request_handler,
+                                                     RequestPriorityResolver priority_resolver,
+                                                     TrafficCaptureWriter* traffic_capture,
+                                                     const SyncServerOptions& server_options) :
+    m_io_context(io_context),
+    m_acceptor(io_context, typename Protocol::endpoint(boost::asio::local::stream_protocol::endpoint(socket_path))),
+    m_request_handler(std::move(request_handler)), m_priority_resolver(std::move(priority_resolver)),
+    m_traffic_capture(traffic_capture), m_socket_path(socket_path),
+    m_admission_controller(server_options.admission_limits),
+    m_subscription_options(server_options.subscriptions), m_request_pool(k_spare_request_buffers),
+    m_max_request_size(server_options.max_request_size), m_max_response_size(server_options.max_response_size),
+    m_busy_poller(server_options.busy_poll_budget) {
+    if constexpr (k_is_seqpacket_transport<Protocol>) {
+        m_record_buffer.resize(k_max_seqpacket_frame_size);
+    }
+
+    if (server_options.handler_threads > 0) {
+        m_handler_executor = std::make_unique<WorkStealingExecutor>(server_options.handler_threads);
+    }
 }
 
-UnixDomainServerResult<void> SyncUnixDomainServer::run() {
+template <typename Protocol>
+UnixDomainServerResult<void> SyncUnixDomainServer<Protocol>::run() {
     try {
         m_acceptor.listen();
-        while (true) {
-            boost::asio::local::stream_protocol::socket socket(m_io_context);
-            m_acceptor.accept(socket);
-
-            SyncUnixDomainSession session(std::move(socket), m_request_handler);
-            const auto session_result = session.start();
-            if (!session_result.has_value()) {
-                unlink(m_socket_path.c_str());
-                return std::unexpected(session_result.error());
-            }
+        acceptNextConnection();
 
-            std::this_thread::sleep_for(k_sync_server_loop_sleep_ms);
+        // All sessions are served concurrently by this loop, it only returns once accepting fails
+        if (m_busy_poller.isEnabled()) {
+            runBusyPolling();
+        } else {
+            m_io_context.run();
         }
     } catch (const boost::system::system_error& e) {
         // TODO: Maybe not general server error, be more specific
         unlink(m_socket_path.c_str());
         return std::unexpected(Error(UnixDomainServerError::GeneralServerError, e.what()));
     }
+
+    unlink(m_socket_path.c_str());
+    if (m_accept_error.has_value()) {
+        return std::unexpected(m_accept_error.value());
+    }
+
+    return {};
+}
+
+template <typename Protocol>
+ServerBackend SyncUnixDomainServer<Protocol>::getType() const {
+    return ServerBackend::Asio;
+}
+
+template <typename Protocol>
+BusyPollStatistics SyncUnixDomainServer<Protocol>::getBusyPollStatistics() const {
+    return m_busy_poller.getStatistics();
+}
+
+template <typename Protocol>
+void SyncUnixDomainServer<Protocol>::runBusyPolling() {
+    // poll never waits in the reactor, run_one only does once spinning found nothing within the budget
+    while (!m_io_context.stopped()) {
+        if (m_io_context.poll() > 0) {
+            continue;
+        }
+
+        if (!m_busy_poller.poll([this] { return m_io_context.poll() > 0; })) {
+            m_io_context.run_one();
+        }
+    }
+}
+
+template <typename Protocol>
+ProtocolMessageBuffer& SyncUnixDomainServer<Protocol>::getRecordBuffer() {
+    return m_record_buffer;
+}
+
+template <typename Protocol>
+std::size_t SyncUnixDomainServer<Protocol>::getMaxRequestSize() const {
+    return m_max_request_size;
+}
+
+template <typename Protocol>
+void SyncUnixDomainServer<Protocol>::captureRequest(const std::uint64_t connection_id,
+                                                    const FrameHeader& header,
+                                                    const std::string_view payload) {
+    if (m_traffic_capture != nullptr) {
+        m_traffic_capture->capture(connection_id, header, payload);
+    }
+}
+
+template <typename Protocol>
+void SyncUnixDomainServer<Protocol>::publish(SharedPublishedEvent event) {
+    boost::asio::post(m_io_context, [this, event = std::move(event)] { fanOutEvent(event); });
+}
+
+template <typename Protocol>
+void SyncUnixDomainServer<Protocol>::subscribe(SyncUnixDomainSession<Protocol>* session, const std::string& topic) {
+    m_subscribers[topic].insert(session);
+}
+
+template <typename Protocol>
+void SyncUnixDomainServer<Protocol>::unsubscribe(SyncUnixDomainSession<Protocol>* session,
+                                                 const std::string& topic) {
+    const auto it = m_subscribers.find(topic);
+    if (it == m_subscribers.end()) {
+        return;
+    }
+
+    it->second.erase(session);
+    if (it->second.empty()) {
+        m_subscribers.erase(it);
+    }
+}
+
+template <typename Protocol>
+void SyncUnixDomainServer<Protocol>::unsubscribeAll(SyncUnixDomainSession<Protocol>* session) {
+    for (auto it = m_subscribers.begin(); it != m_subscribers.end();) {
+        it->second.erase(session);
+        it = it->second.empty() ? m_subscribers.erase(it) : std::next(it);
+    }
+}
+
+template <typename Protocol>
+void SyncUnixDomainServer<Protocol>::fanOutEvent(const SharedPublishedEvent& event) {
+    const auto it = m_subscribers.find(event->topic);
+    if (it == m_subscribers.end()) {
+        return;
+    }
+
+    for (auto* session : it->second) {
+        session->publishEvent(event, m_subscription_options);
+    }
+}
+
+template <typename Protocol>
+void SyncUnixDomainServer<Protocol>::scheduleRequest(std::shared_ptr<SyncUnixDomainSession<Protocol> > session,
+                                                     const FrameHeader& header,
+                                                     const std::string_view payload) {
+    auto request = m_request_pool.take();
+    request.assign(payload);
+
+    const auto priority = resolveRequestPriority(header, request, m_priority_resolver);
+    m_scheduler.push(priority, ScheduledRequest{std::move(session), header, std::move(request)});
+
+    // Every scheduled request gets its own turn in the loop, but the turn serves whichever request has the
+    // highest priority by then. Reads completing in between can still overtake queued lower priority work.
+    boost::asio::post(m_io_context, [this] { runNextRequest(); });
+}
+
+template <typename Protocol>
+void SyncUnixDomainServer<Protocol>::runNextRequest() {
+    // Once the handler threads are saturated the next request is run by the completion of a dispatched one
+    if (m_handler_executor != nullptr &&
+        m_dispatched_requests >= m_handler_executor->getWorkerCount() * k_dispatched_requests_per_handler_thread) {
+        return;
+    }
+
+    // An expired request does not use up the turn, a completion runs only one turn and the requests behind the
+    // expired one would otherwise wait for new traffic
+    auto scheduled = m_scheduler.pop();
+    while (scheduled.has_value() && isDeadlineExpired(scheduled->header, std::chrono::steady_clock::now())) {
+        if (isOneWay(scheduled->header)) {
+            m_admission_controller.releaseRequest(scheduled->request.size());
+        } else {
+            scheduled->session->dropRequest(scheduled->request.size());
+        }
+        m_request_pool.recycle(std::move(scheduled->request));
+        scheduled = m_scheduler.pop();
+    }
+
+    if (!scheduled.has_value()) {
+        return;
+    }
+
+    if (m_handler_executor == nullptr) {
+        const auto response = callRequestHandler(scheduled.value());
+        if (response.has_value()) {
+            completeRequest(scheduled->session, scheduled->header, scheduled->request.size(), response.value());
+        }
+        m_request_pool.recycle(std::move(scheduled->request));
+        return;
+    }
+
+    ++m_dispatched_requests;
+    m_handler_executor->submit([this, shared_scheduled = std::make_shared<ScheduledRequest>(std::move(*scheduled))] {
+        std::optional<ProtocolMessage> response;
+        std::exception_ptr failure;
+        try {
+            response = callRequestHandler(*shared_scheduled);
+        } catch (...) {
+            failure = std::current_exception();
+        }
+
+        boost::asio::post(m_io_context, [this, shared_scheduled, response = std::move(response), failure] {
+            --m_dispatched_requests;
+
+            // Handler failures leave the loop the same way as when the handler runs on this thread
+            if (failure != nullptr) {
+                std::rethrow_exception(failure);
+            }
+
+            if (response.has_value()) {
+                completeRequest(shared_scheduled->session,
+                                shared_scheduled->header,
+                                shared_scheduled->request.size(),
+                                response.value());
+            }
+            m_request_pool.recycle(std::move(shared_scheduled->request));
+            runNextRequest();
+        });
+    });
+}
+
+template <typename Protocol>
+std::optional<ProtocolMessage> SyncUnixDomainServer<Protocol>::callRequestHandler(const ScheduledRequest& scheduled) {
+    LazyResponseDeferral deferral([this, &scheduled] {
+        return DeferredResponseCallback([this,
+                                         session = scheduled.session,
+                                         header = scheduled.header,
+                                         admitted_request_size = scheduled.request.size()](ProtocolMessage response) {
+            boost::asio::post(m_io_context,
+                              [this, session, header, admitted_request_size, response = std::move(response)] {
+                                  completeRequest(session, header, admitted_request_size, response);
+                              });
+        });
+    });
+
+    return m_request_handler(scheduled.request, deferral);
+}
+
+template <typename Protocol>
+void SyncUnixDomainServer<Protocol>::completeRequest(const std::shared_ptr<SyncUnixDomainSession<Protocol> >& session,
+                                                     const FrameHeader& header,
+                                                     const std::size_t admitted_request_size,
+                                                     const ProtocolMessage& response) {
+    // One-way messages are served even if their sender disconnected meanwhile, nothing has to be written back
+    if (isOneWay(header)) {
+        m_admission_controller.releaseRequest(admitted_request_size);
+        return;
+    }
+
+    if (response.size() > m_max_response_size) {
+        session->respond(header.request_id, getResponseTooLargeResponse(), admitted_request_size);
+        return;
+    }
+
+    session->respond(header.request_id, response, admitted_request_size);
 }
+
+template <typename Protocol>
+void SyncUnixDomainServer<Protocol>::acceptNextConnection() {
+    m_acceptor.async_accept([this](const boost::system::error_code& error, typename Protocol::socket socket) {
+        if (error) {
+            m_accept_error = Error(UnixDomainServerError::GeneralServerError, error.message());
+            m_io_context.stop();
+            return;
+        }
+
+        if constexpr (k_is_seqpacket_transport<Protocol>) {
+            // A response record has to fit into the send buffer, raise it as far as the kernel permits
+            boost::system::error_code ignored_error;
+            socket.set_option(boost::asio::socket_base::send_buffer_size(static_cast<int>(k_max_seqpacket_frame_size)),
+                              ignored_error);
+        }
+
+        const auto session = std::make_shared<SyncUnixDomainSession<Protocol> >(
+            std::move(socket), *this, m_admission_controller, m_next_connection_id++);
+        if (m_admission_controller.tryAdmitConnection()) {
+            session->start();
+        } else {
+            session->reject();
+        }
+
+        acceptNextConnection();
+    });
+}
+
+template class SyncUnixDomainServer<StreamTransportProtocol>;
+template class SyncUnixDomainServer<SeqPacketTransportProtocol>;
 }  // namespace ipcourier::_detail
@@ -18,61 +18,198 @@
 #ifndef INTER_PROCESS_COURIER_SYNCUNIXDOMAINSERVER_HPP
 #define INTER_PROCESS_COURIER_SYNCUNIXDOMAINSERVER_HPP
 
+#include "BufferPool.hpp"
+#include "BusyPoller.hpp"
+#include "FrameReader.hpp"
+#include "RequestScheduler.hpp"
+#include "ServerAdmissionController.hpp"
 #include "UnixDomainProtocol.hpp"
+#include "UnixDomainServerBackend.hpp"
+#include "WorkStealingExecutor.hpp"
 
-#include <expected>
-#include <functional>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
 #include <string>
-#include <vector>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 
-#include <InterProcessCourier/Error.hpp>
 #include <boost/asio.hpp>
 
 namespace ipcourier::_detail {
-enum class UnixDomainServerError {
-    UnknownError,
-    NotEnoughBytesReceived,
-    GeneralServerError,
-    GeneralServerSessionError,
-    UnableToSendMessage
-};
+// Socket protocols the Asio backend serves, chosen by SyncServerOptions::transport
+using StreamTransportProtocol = boost::asio::local::stream_protocol;
+using SeqPacketTransportProtocol = boost::asio::generic::seq_packet_protocol;
 
-using RequestHandler = std::function<ProtocolMessage(const ProtocolMessage&)>;
+template <typename Protocol>
+constexpr bool k_is_seqpacket_transport = std::is_same_v<Protocol, SeqPacketTransportProtocol>;
 
-template <typename SuccessType>
-using UnixDomainServerResult = std::expected<SuccessType, Error<UnixDomainServerError> >;
+template <typename Protocol>
+class SyncUnixDomainServer;
 
-class SyncUnixDomainSession {
+template <typename Protocol>
+class SyncUnixDomainSession : public std::enable_shared_from_this<SyncUnixDomainSession<Protocol> > {
 public:
-    SyncUnixDomainSession(boost::asio::local::stream_protocol::socket socket, RequestHandler request_handler);
+    SyncUnixDomainSession(typename Protocol::socket socket,
+                          SyncUnixDomainServer<Protocol>& server,
+                          ServerAdmissionController& admission_controller,
+                          std::uint64_t connection_id);
+
+    SyncUnixDomainSession(const SyncUnixDomainSession&) = delete;
+
+    SyncUnixDomainSession& operator=(const SyncUnixDomainSession&) = delete;
+
+    ~SyncUnixDomainSession();
+
+    void start();
 
-    UnixDomainServerResult<void> start();
+    void reject();
+
+    // Completes the scheduled request of this session, reading resumes once the response is written
+    void respond(std::uint64_t request_id, const ProtocolMessage& response, std::size_t admitted_request_size);
+
+    void dropRequest(std::size_t admitted_request_size);
+
+    void publishEvent(SharedPublishedEvent event, const SubscriptionOptions& subscription_options);
 
 private:
-    boost::asio::local::stream_protocol::socket m_socket;
-    RequestHandler m_request_handler;
+    // Either a response frame owned by this session or an event frame shared with the other subscribers
+    struct PendingWrite {
+        ProtocolMessageBuffer frame;
+        SharedPublishedEvent event = nullptr;
+        std::optional<std::size_t> admitted_request_size = std::nullopt;
+        bool resume_reading = false;
+        bool close_when_written = false;
+    };
+
+    typename Protocol::socket m_socket;
+    SyncUnixDomainServer<Protocol>& m_server;
+    ServerAdmissionController& m_admission_controller;
+    std::uint64_t m_connection_id;
+    bool m_admitted = false;
+
+    FrameReader m_frame_reader;
+
+    // The write in flight is kept apart, only writes that have not started yet may be conflated
+    std::deque<PendingWrite> m_pending_writes;
+    std::optional<PendingWrite> m_current_write;
+    BufferPool<ProtocolMessageBuffer> m_frame_pool;
+
+    // Serves the frames that are already buffered until one has to wait for its response to be written
+    void readNextFrame();
+
+    void readAvailable();
+
+    // A seqpacket frame arrives as one record, header and payload are received together
+    void receiveRecord();
+
+    // Returns whether the next frame may be handled right away
+    bool handleFrame(const FrameHeader& header, std::string_view payload);
+
+    // Answers a frame exceeding the maximum request size and closes the connection, nothing of its payload has been
+    // buffered. A one-way frame gets no answer, the connection is closed right away.
+    void rejectOversizedFrame(const FrameHeader& header);
+
+    void handleSubscriptionFrame(const FrameHeader& header, std::string_view payload);
+
+    void queueWrite(PendingWrite pending_write);
 
-    UnixDomainServerResult<std::uint32_t> readHeader();
+    void writeNext();
 
-    UnixDomainServerResult<ProtocolMessageBuffer> readBody(std::uint32_t msg_length);
+    void close();
 
-    UnixDomainServerResult<void> writeResponse(const ProtocolMessageBuffer& response);
+    // Responses that are never written still hold their admitted request size
+    void releasePendingWrites();
 };
 
-class SyncUnixDomainServer {
+template <typename Protocol>
+class SyncUnixDomainServer final : public UnixDomainServerBackend {
 public:
     SyncUnixDomainServer(boost::asio::io_context& io_context,
                          const std::string& socket_path,
-                         RequestHandler request_handler);
+                         RequestHandler request_handler,
+                         RequestPriorityResolver priority_resolver,
+                         TrafficCaptureWriter* traffic_capture,
+                         const SyncServerOptions& server_options);
 
-    UnixDomainServerResult<void> run();
+    UnixDomainServerResult<void> run() override;
+
+    ServerBackend getType() const override;
+
+    BusyPollStatistics getBusyPollStatistics() const override;
+
+    void publish(SharedPublishedEvent event) override;
+
+    void subscribe(SyncUnixDomainSession<Protocol>* session, const std::string& topic);
+
+    void unsubscribe(SyncUnixDomainSession<Protocol>* session, const std::string& topic);
+
+    void unsubscribeAll(SyncUnixDomainSession<Protocol>* session);
+
+    // The payload is copied into a pooled request buffer, it only has to stay valid for the call
+    void scheduleRequest(std::shared_ptr<SyncUnixDomainSession<Protocol> > session,
+                         const FrameHeader& header,
+                         std::string_view payload);
+
+    // Seqpacket sessions receive into this buffer, a record is handled completely before the next is received
+    ProtocolMessageBuffer& getRecordBuffer();
+
+    std::size_t getMaxRequestSize() const;
+
+    // Does nothing unless SyncServerOptions::traffic_capture is set
+    void captureRequest(std::uint64_t connection_id, const FrameHeader& header, std::string_view payload);
 
 private:
+    struct ScheduledRequest {
+        std::shared_ptr<SyncUnixDomainSession<Protocol> > session;
+        FrameHeader header;
+        ProtocolMessage request;
+    };
+
     boost::asio::io_context& m_io_context;
-    boost::asio::local::stream_protocol::acceptor m_acceptor;
+    boost::asio::basic_socket_acceptor<Protocol> m_acceptor;
     RequestHandler m_request_handler;
+    RequestPriorityResolver m_priority_resolver;
+    TrafficCaptureWriter* m_traffic_capture;
     std::string m_socket_path;
+    ServerAdmissionController m_admission_controller;
+    SubscriptionOptions m_subscription_options;
+    std::unordered_map<std::string, std::unordered_set<SyncUnixDomainSession<Protocol>*> > m_subscribers;
+    RequestScheduler<ScheduledRequest> m_scheduler;
+    std::optional<Error<UnixDomainServerError> > m_accept_error;
+    std::size_t m_dispatched_requests = 0;
+    std::uint64_t m_next_connection_id = 1;
+    ProtocolMessageBuffer m_record_buffer;
+    BufferPool<ProtocolMessage> m_request_pool;
+    std::size_t m_max_request_size;
+    std::size_t m_max_response_size;
+    BusyPoller m_busy_poller;
+
+    // Declared last, so the handler threads are joined before anything they post results to is destroyed
+    std::unique_ptr<WorkStealingExecutor> m_handler_executor;
+
+    void acceptNextConnection();
+
+    // Runs the loop like io_context::run, but spins for ready handlers before blocking in the reactor
+    void runBusyPolling();
+
+    void fanOutEvent(const SharedPublishedEvent& event);
+
+    void runNextRequest();
+
+    std::optional<ProtocolMessage> callRequestHandler(const ScheduledRequest& scheduled);
+
+    void completeRequest(const std::shared_ptr<SyncUnixDomainSession<Protocol> >& session,
+                         const FrameHeader& header,
+                         std::size_t admitted_request_size,
+                         const ProtocolMessage& response);
 };
+
+extern template class SyncUnixDomainServer<StreamTransportProtocol>;
+extern template class SyncUnixDomainServer<SeqPacketTransportProtocol>;
 }  // namespace ipcourier::_detail
 
 #endif  // INTER_PROCESS_COURIER_SYNCUNIXDOMAINSERVER_HPP
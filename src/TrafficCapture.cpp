@@ -0,0 +1,227 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "TrafficCaptureWriter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ipcourier::_detail {
+namespace {
+std::size_t alignRecordSize(const std::size_t size) {
+    return (size + k_capture_record_alignment - 1) / k_capture_record_alignment * k_capture_record_alignment;
+}
+}  // namespace
+
+TrafficCaptureResult<std::unique_ptr<TrafficCaptureWriter> > TrafficCaptureWriter::open(
+    const TrafficCaptureOptions& options) {
+    if (options.max_bytes < sizeof(CaptureFileHeader)) {
+        return std::unexpected(Error(TrafficCaptureError::UnableToOpenFile,
+                                     std::format("Capture size of {} bytes is too small", options.max_bytes)));
+    }
+
+    const auto fd = ::open(options.path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return std::unexpected(Error(TrafficCaptureError::UnableToOpenFile,
+                                     std::format("{}: {}", options.path, std::strerror(errno))));
+    }
+
+    if (::ftruncate(fd, static_cast<off_t>(options.max_bytes)) != 0) {
+        const auto error = errno;
+        ::close(fd);
+        return std::unexpected(Error(TrafficCaptureError::UnableToOpenFile,
+                                     std::format("{}: {}", options.path, std::strerror(error))));
+    }
+
+    auto* data = ::mmap(nullptr, options.max_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        const auto error = errno;
+        ::close(fd);
+        return std::unexpected(Error(TrafficCaptureError::UnableToOpenFile,
+                                     std::format("{}: {}", options.path, std::strerror(error))));
+    }
+
+    return std::unique_ptr<TrafficCaptureWriter>(
+        new TrafficCaptureWriter(fd, static_cast<char*>(data), options.max_bytes));
+}
+
+TrafficCaptureWriter::TrafficCaptureWriter(const int fd, char* data, const std::size_t size) :
+    m_fd(fd), m_data(data), m_size(size), m_start(std::chrono::steady_clock::now()) {
+    const auto start_time = std::chrono::system_clock::now().time_since_epoch();
+
+    CaptureFileHeader header;
+    header.magic = k_capture_file_magic;
+    header.version = k_capture_file_version;
+    header.header_size = sizeof(CaptureFileHeader);
+    header.start_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(start_time).count();
+    std::memcpy(m_data, &header, sizeof(header));
+}
+
+TrafficCaptureWriter::~TrafficCaptureWriter() {
+    ::munmap(m_data, m_size);
+    static_cast<void>(::ftruncate(m_fd, static_cast<off_t>(m_offset)));
+    ::close(m_fd);
+}
+
+void TrafficCaptureWriter::capture(const std::uint64_t connection_id,
+                                   const FrameHeader& header,
+                                   const std::string_view payload) {
+    const auto record_size = alignRecordSize(sizeof(CaptureRecordHeader) + payload.size());
+    if (m_size - m_offset < record_size) {
+        m_dropped_requests.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    CaptureRecordHeader record;
+    record.payload_length = static_cast<std::uint32_t>(payload.size());
+    record.timestamp_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+    record.connection_id = connection_id;
+    record.flags = header.flags;
+    record.priority = header.priority;
+
+    // The marker is written last, a record cut short by a crash stays invisible to readers
+    auto* record_begin = m_data + m_offset;
+    std::memcpy(record_begin + sizeof(CaptureRecordHeader), payload.data(), payload.size());
+    std::memcpy(record_begin, &record, sizeof(record));
+
+    // Keeps the compiler from moving the stores above past the marker, the page cache keeps their order
+    std::atomic_signal_fence(std::memory_order_release);
+    const auto marker = k_capture_record_marker;
+    std::memcpy(record_begin + offsetof(CaptureRecordHeader, marker), &marker, sizeof(marker));
+
+    m_offset += record_size;
+    m_captured_requests.fetch_add(1, std::memory_order_relaxed);
+}
+
+TrafficCaptureStatistics TrafficCaptureWriter::getStatistics() const {
+    return TrafficCaptureStatistics{.captured_requests = m_captured_requests.load(std::memory_order_relaxed),
+                                    .dropped_requests = m_dropped_requests.load(std::memory_order_relaxed)};
+}
+}  // namespace ipcourier::_detail
+
+namespace ipcourier {
+TrafficCaptureResult<TrafficCaptureReader> TrafficCaptureReader::open(const std::string& path) {
+    const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return std::unexpected(
+            Error(TrafficCaptureError::UnableToOpenFile, std::format("{}: {}", path, std::strerror(errno))));
+    }
+
+    struct stat file_status {};
+    if (::fstat(fd, &file_status) != 0) {
+        const auto error = errno;
+        ::close(fd);
+        return std::unexpected(
+            Error(TrafficCaptureError::UnableToOpenFile, std::format("{}: {}", path, std::strerror(error))));
+    }
+
+    const auto size = static_cast<std::size_t>(file_status.st_size);
+    if (size < sizeof(_detail::CaptureFileHeader)) {
+        ::close(fd);
+        return std::unexpected(Error(TrafficCaptureError::InvalidFileFormat, "File is shorter than the header"));
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    auto* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return std::unexpected(
+            Error(TrafficCaptureError::UnableToOpenFile, std::format("{}: {}", path, std::strerror(errno))));
+    }
+
+    _detail::CaptureFileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != _detail::k_capture_file_magic || header.version != _detail::k_capture_file_version ||
+        header.header_size < sizeof(header) || header.header_size > size) {
+        ::munmap(data, size);
+        return std::unexpected(Error(TrafficCaptureError::InvalidFileFormat,
+                                     std::format("Not a version {} capture", _detail::k_capture_file_version)));
+    }
+
+    TrafficCaptureReader reader(static_cast<const char*>(data), size);
+    reader.m_offset = header.header_size;
+    const auto start_time = std::chrono::nanoseconds(header.start_time_ns);
+    reader.m_start_time = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(start_time));
+    return reader;
+}
+
+TrafficCaptureReader::TrafficCaptureReader(const char* data, const std::size_t size) : m_data(data), m_size(size) {
+}
+
+TrafficCaptureReader::TrafficCaptureReader(TrafficCaptureReader&& other) noexcept :
+    m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)),
+    m_offset(std::exchange(other.m_offset, 0)), m_start_time(other.m_start_time) {
+}
+
+TrafficCaptureReader& TrafficCaptureReader::operator=(TrafficCaptureReader&& other) noexcept {
+    if (this != &other) {
+        if (m_data != nullptr) {
+            ::munmap(const_cast<char*>(m_data), m_size);
+        }
+
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_offset = std::exchange(other.m_offset, 0);
+        m_start_time = other.m_start_time;
+    }
+
+    return *this;
+}
+
+TrafficCaptureReader::~TrafficCaptureReader() {
+    if (m_data != nullptr) {
+        ::munmap(const_cast<char*>(m_data), m_size);
+    }
+}
+
+std::optional<CapturedRequest> TrafficCaptureReader::next() {
+    if (m_size - m_offset < sizeof(_detail::CaptureRecordHeader)) {
+        return std::nullopt;
+    }
+
+    _detail::CaptureRecordHeader record;
+    std::memcpy(&record, m_data + m_offset, sizeof(record));
+    const auto payload_offset = m_offset + sizeof(record);
+    if (record.marker != _detail::k_capture_record_marker || m_size - payload_offset < record.payload_length) {
+        return std::nullopt;
+    }
+
+    m_offset = std::min(m_size, m_offset + _detail::alignRecordSize(sizeof(record) + record.payload_length));
+    return CapturedRequest{.timestamp = std::chrono::nanoseconds(record.timestamp_ns),
+                           .connection_id = record.connection_id,
+                           .one_way = (record.flags & _detail::k_frame_flag_one_way) != 0,
+                           .priority = _detail::decodeRequestPriority(record.priority),
+                           .payload = std::string_view(m_data + payload_offset, record.payload_length)};
+}
+
+std::chrono::system_clock::time_point TrafficCaptureReader::getStartTime() const {
+    return m_start_time;
+}
+}  // namespace ipcourier
@@ -0,0 +1,96 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef INTER_PROCESS_COURIER_TRAFFIC_CAPTURE_WRITER_HPP
+#define INTER_PROCESS_COURIER_TRAFFIC_CAPTURE_WRITER_HPP
+
+#include "UnixDomainProtocol.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include <InterProcessCourier/TrafficCapture.hpp>
+
+namespace ipcourier::_detail {
+/*
+ * Capture file layout, all in host byte order: a CaptureFileHeader followed by one record per request, each a
+ * CaptureRecordHeader and the payload padded to k_capture_record_alignment. The mapped file starts out zeroed,
+ * so a record whose marker is not set ends the capture.
+ */
+struct CaptureFileHeader {
+    std::uint64_t magic = 0;
+    std::uint32_t version = 0;
+    std::uint32_t header_size = 0;
+    std::int64_t start_time_ns = 0;
+};
+
+struct CaptureRecordHeader {
+    std::uint32_t marker = 0;
+    std::uint32_t payload_length = 0;
+    std::int64_t timestamp_ns = 0;
+    std::uint64_t connection_id = 0;
+    std::uint8_t flags = 0;
+    std::uint8_t priority = 0;
+    std::uint16_t reserved = 0;
+    std::uint32_t reserved_2 = 0;
+};
+
+// "IPCCAPT" and a format version byte
+constexpr std::uint64_t k_capture_file_magic = 0x0154504143435049;
+constexpr std::uint32_t k_capture_file_version = 1;
+constexpr std::uint32_t k_capture_record_marker = 0x43455252;
+constexpr std::size_t k_capture_record_alignment = alignof(CaptureRecordHeader);
+
+/*
+ * Appends received requests to a memory-mapped capture file. Writing a request is two copies into the mapping,
+ * the kernel writes the pages back in the background. Only the thread running the backend captures, the
+ * statistics may be read from any thread.
+ */
+class TrafficCaptureWriter {
+public:
+    static TrafficCaptureResult<std::unique_ptr<TrafficCaptureWriter> > open(const TrafficCaptureOptions& options);
+
+    TrafficCaptureWriter(const TrafficCaptureWriter&) = delete;
+
+    TrafficCaptureWriter& operator=(const TrafficCaptureWriter&) = delete;
+
+    // Truncates the file to the captured records
+    ~TrafficCaptureWriter();
+
+    void capture(std::uint64_t connection_id, const FrameHeader& header, std::string_view payload);
+
+    TrafficCaptureStatistics getStatistics() const;
+
+private:
+    int m_fd;
+    char* m_data;
+    std::size_t m_size;
+    std::size_t m_offset = sizeof(CaptureFileHeader);
+    std::chrono::steady_clock::time_point m_start;
+    std::atomic<std::uint64_t> m_captured_requests = 0;
+    std::atomic<std::uint64_t> m_dropped_requests = 0;
+
+    TrafficCaptureWriter(int fd, char* data, std::size_t size);
+};
+}  // namespace ipcourier::_detail
+
+#endif  // INTER_PROCESS_COURIER_TRAFFIC_CAPTURE_WRITER_HPP
@@ -18,14 +18,111 @@
 #ifndef INTER_PROCESS_COURIER_UNIX_DOMAIN_CLIENT_HPP
 #define INTER_PROCESS_COURIER_UNIX_DOMAIN_CLIENT_HPP
 
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <optional>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#include <InterProcessCourier/SyncCommons.hpp>
+
 namespace ipcourier::_detail {
 using ProtocolMessage = std::string;
 using ProtocolMessageBuffer = std::vector<char>;
 
-constexpr std::size_t k_payload_length_header_size = 4;
+/*
+ * Fixed size header in front of every payload, encoded in host byte order since both ends share the host.
+ * deadline_ns is a steady_clock (CLOCK_MONOTONIC) timestamp, which is system-wide and comparable between
+ * the client and the server process. A deadline of 0 means the request never expires.
+ * Responses echo the request_id of the request they answer, frames with request_id 0 concern the connection
+ * as a whole (e.g. rejecting it) rather than a particular request.
+ * priority holds a RequestPriority chosen by the client offset by one, 0 leaves the choice to the server.
+ * flags is a combination of the k_frame_flag_* bits.
+ */
+struct FrameHeader {
+    std::uint32_t payload_length = 0;
+    std::uint8_t priority = 0;
+    std::uint8_t flags = 0;
+    std::uint16_t reserved = 0;
+    std::uint64_t request_id = 0;
+    std::int64_t deadline_ns = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<FrameHeader>);
+
+constexpr std::size_t k_frame_header_size = sizeof(FrameHeader);
+
+constexpr std::uint64_t k_connection_request_id = 0;
+
+constexpr std::int64_t k_no_deadline = 0;
+
+constexpr std::uint8_t k_unspecified_priority = 0;
+
+// The sender does not wait for a reply, the server never writes one, not even an error
+constexpr std::uint8_t k_frame_flag_one_way = 1U << 0U;
+
+// Subscription control, the payload is the topic and the server acknowledges with an empty payload
+constexpr std::uint8_t k_frame_flag_subscribe = 1U << 1U;
+constexpr std::uint8_t k_frame_flag_unsubscribe = 1U << 2U;
+
+// Published by the server without a request, the payload is the serialized message of the topic
+constexpr std::uint8_t k_frame_flag_event = 1U << 3U;
+
+constexpr std::size_t k_request_priority_count = 3;
+
+// Reused connection buffers that grew beyond this size for an exceptionally large message are released once
+// drained, so a single large message does not pin its memory for the lifetime of the connection
+constexpr std::size_t k_retained_buffer_size = 256 * 1024;
+
+// With Transport::SeqPacket every frame travels as one record and is received into a buffer of this size.
+// Larger frames cannot be sent, the kernel may refuse smaller ones already if its send buffer limit is lower.
+constexpr std::size_t k_max_seqpacket_frame_size = 1024 * 1024;
+
+inline void encodeFrameHeader(const FrameHeader& header, char* destination) {
+    std::memcpy(destination, &header, k_frame_header_size);
+}
+
+inline FrameHeader decodeFrameHeader(const char* source) {
+    FrameHeader header;
+    std::memcpy(&header, source, k_frame_header_size);
+    return header;
+}
+
+inline std::int64_t toDeadlineNs(const std::chrono::steady_clock::time_point deadline) {
+    if (deadline == std::chrono::steady_clock::time_point::max()) {
+        return k_no_deadline;
+    }
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+}
+
+inline std::uint8_t encodeRequestPriority(const std::optional<RequestPriority> priority) {
+    return priority.has_value() ? static_cast<std::uint8_t>(static_cast<std::uint8_t>(priority.value()) + 1)
+                                : k_unspecified_priority;
+}
+
+inline std::optional<RequestPriority> decodeRequestPriority(const std::uint8_t encoded_priority) {
+    if (encoded_priority == k_unspecified_priority || encoded_priority > k_request_priority_count) {
+        return std::nullopt;
+    }
+
+    return static_cast<RequestPriority>(encoded_priority - 1);
+}
+
+inline bool hasFrameFlag(const FrameHeader& header, const std::uint8_t flag) {
+    return (header.flags & flag) != 0;
+}
+
+inline bool isOneWay(const FrameHeader& header) {
+    return hasFrameFlag(header, k_frame_flag_one_way);
+}
+
+inline bool isDeadlineExpired(const FrameHeader& header, const std::chrono::steady_clock::time_point now) {
+    return header.deadline_ns != k_no_deadline &&
+           std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count() >= header.deadline_ns;
+}
 }  // namespace ipcourier::_detail
 
 #endif  // INTER_PROCESS_COURIER_UNIX_DOMAIN_CLIENT_HPP
@@ -0,0 +1,106 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "UnixDomainServerBackend.hpp"
+
+#include "IoUringUnixDomainServer.hpp"
+#include "SyncUnixDomainServer.hpp"
+
+#include <cstring>
+
+#include <InterProcessCourier/detail/ProtobufTools.hpp>
+
+#include "InternalRequests.pb.h"
+
+namespace ipcourier::_detail {
+ProtocolMessage makeErrorResponse(const SyncServerError error_type, const std::string_view message) {
+    internal_request_proto::IPCInternal_ErrorResponse error_response;
+    error_response.set_error_type(static_cast<std::int32_t>(error_type));
+    error_response.set_message(std::string(message));
+    return makePayloadFromProto(error_response);
+}
+
+SharedPublishedEvent makePublishedEvent(std::string topic, const ProtocolMessage& payload) {
+    const FrameHeader header{.payload_length = static_cast<std::uint32_t>(payload.length()),
+                             .flags = k_frame_flag_event,
+                             .request_id = k_connection_request_id};
+
+    auto event = std::make_shared<PublishedEvent>();
+    event->topic = std::move(topic);
+    event->frame.resize(k_frame_header_size + payload.length());
+    encodeFrameHeader(header, event->frame.data());
+    std::memcpy(event->frame.data() + k_frame_header_size, payload.data(), payload.length());
+    return event;
+}
+
+const ProtocolMessage& getRequestTooLargeResponse() {
+    static const auto response =
+        makeErrorResponse(SyncServerError::MessageTooLarge, "Request exceeds the maximum request size");
+    return response;
+}
+
+const ProtocolMessage& getResponseTooLargeResponse() {
+    static const auto response =
+        makeErrorResponse(SyncServerError::MessageTooLarge, "Response exceeds the maximum response size");
+    return response;
+}
+
+RequestPriority resolveRequestPriority(const FrameHeader& header,
+                                       const ProtocolMessage& request,
+                                       const RequestPriorityResolver& priority_resolver) {
+    const auto requested_priority = decodeRequestPriority(header.priority);
+    if (requested_priority.has_value()) {
+        return requested_priority.value();
+    }
+
+    return priority_resolver(request);
+}
+
+std::unique_ptr<UnixDomainServerBackend> makeUnixDomainServerBackend(boost::asio::io_context& io_context,
+                                                                     const std::string& socket_path,
+                                                                     RequestHandler request_handler,
+                                                                     RequestPriorityResolver priority_resolver,
+                                                                     TrafficCaptureWriter* traffic_capture,
+                                                                     const SyncServerOptions& server_options) {
+#if INTER_PROCESS_COURIER_IO_URING_AVAILABLE
+    // Receives land in fixed size provided buffers, which would truncate seqpacket records
+    if (server_options.backend == ServerBackend::IoUring && server_options.transport == Transport::Stream) {
+        auto io_uring_server = IoUringUnixDomainServer::create(
+            socket_path, request_handler, priority_resolver, traffic_capture, server_options);
+        if (io_uring_server.has_value()) {
+            return std::move(io_uring_server.value());
+        }
+    }
+#endif
+
+    if (server_options.transport == Transport::SeqPacket) {
+        return std::make_unique<SyncUnixDomainServer<SeqPacketTransportProtocol> >(io_context,
+                                                                                   socket_path,
+                                                                                   std::move(request_handler),
+                                                                                   std::move(priority_resolver),
+                                                                                   traffic_capture,
+                                                                                   server_options);
+    }
+
+    return std::make_unique<SyncUnixDomainServer<StreamTransportProtocol> >(io_context,
+                                                                         socket_path,
+                                                                         std::move(request_handler),
+                                                                         std::move(priority_resolver),
+                                                                         traffic_capture,
+                                                                         server_options);
+}
+}  // namespace ipcourier::_detail
@@ -0,0 +1,158 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef INTER_PROCESS_COURIER_UNIXDOMAINSERVERBACKEND_HPP
+#define INTER_PROCESS_COURIER_UNIXDOMAINSERVERBACKEND_HPP
+
+#include "TrafficCaptureWriter.hpp"
+#include "UnixDomainProtocol.hpp"
+
+#include <expected>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <InterProcessCourier/Error.hpp>
+#include <InterProcessCourier/Responder.hpp>
+#include <InterProcessCourier/SyncServer.hpp>
+#include <InterProcessCourier/detail/ThirdPartyFwd.hpp>
+
+namespace ipcourier::_detail {
+enum class UnixDomainServerError {
+    UnknownError,
+    NotEnoughBytesReceived,
+    GeneralServerError,
+    GeneralServerSessionError,
+    UnableToSendMessage
+};
+
+// Returns nothing if the handler took the request over through the deferral, it is completed by the callback then
+using RequestHandler = std::function<std::optional<ProtocolMessage>(const ProtocolMessage&, ResponseDeferral&)>;
+
+// Builds the completion callback only for handlers that actually defer, synchronous ones never pay for it
+template <typename MakeCallback>
+class LazyResponseDeferral final : public ResponseDeferral {
+public:
+    explicit LazyResponseDeferral(MakeCallback make_callback) : m_make_callback(std::move(make_callback)) {
+    }
+
+    DeferredResponseCallback defer() override {
+        return m_make_callback();
+    }
+
+private:
+    MakeCallback m_make_callback;
+};
+
+// Priority of requests whose frame leaves the choice to the server, usually derived from the request type
+using RequestPriorityResolver = std::function<RequestPriority(const ProtocolMessage&)>;
+
+template <typename SuccessType>
+using UnixDomainServerResult = std::expected<SuccessType, Error<UnixDomainServerError> >;
+
+// Complete event frame, serialized once and shared by the write queues of all subscribers
+struct PublishedEvent {
+    std::string topic;
+    ProtocolMessage frame;
+};
+
+using SharedPublishedEvent = std::shared_ptr<const PublishedEvent>;
+
+// Requests handed to the handler threads at a time per thread, the others wait in the priority queue so that
+// higher priority requests arriving meanwhile still overtake them
+constexpr std::size_t k_dispatched_requests_per_handler_thread = 2;
+
+class UnixDomainServerBackend {
+public:
+    virtual ~UnixDomainServerBackend() = default;
+
+    virtual UnixDomainServerResult<void> run() = 0;
+
+    virtual ServerBackend getType() const = 0;
+
+    // May be called from any thread
+    virtual BusyPollStatistics getBusyPollStatistics() const = 0;
+
+    // May be called from any thread, the event is handed over to the thread running the backend
+    virtual void publish(SharedPublishedEvent event) = 0;
+};
+
+SharedPublishedEvent makePublishedEvent(std::string topic, const ProtocolMessage& payload);
+
+/*
+ * Appends event to the pending writes of a subscriber, each entry of which holds a SharedPublishedEvent
+ * member named event that is empty for responses. Returns false if the subscriber has to be disconnected.
+ */
+template <typename PendingWrites>
+bool queueEventForSubscriber(PendingWrites& pending_writes,
+                             SharedPublishedEvent event,
+                             const SubscriptionOptions& subscription_options) {
+    std::size_t queued_events = 0;
+    auto oldest_event = pending_writes.end();
+    auto oldest_event_of_topic = pending_writes.end();
+    for (auto it = pending_writes.begin(); it != pending_writes.end(); ++it) {
+        if (it->event == nullptr) {
+            continue;
+        }
+
+        ++queued_events;
+        if (oldest_event == pending_writes.end()) {
+            oldest_event = it;
+        }
+        if (oldest_event_of_topic == pending_writes.end() && it->event->topic == event->topic) {
+            oldest_event_of_topic = it;
+        }
+    }
+
+    const auto limit = subscription_options.max_queued_events;
+    if (limit != 0 && queued_events >= limit) {
+        if (subscription_options.slow_subscriber_policy == SlowSubscriberPolicy::Disconnect) {
+            return false;
+        }
+
+        pending_writes.erase(oldest_event_of_topic != pending_writes.end() ? oldest_event_of_topic : oldest_event);
+    }
+
+    pending_writes.emplace_back().event = std::move(event);
+    return true;
+}
+
+// Payload of an error response, which clients receive as the SyncClientError matching error_type
+ProtocolMessage makeErrorResponse(SyncServerError error_type, std::string_view message);
+
+// Error payloads sent in place of the response if the request exceeded SyncServerOptions::max_request_size or
+// the response exceeded SyncServerOptions::max_response_size
+const ProtocolMessage& getRequestTooLargeResponse();
+
+const ProtocolMessage& getResponseTooLargeResponse();
+
+// The priority chosen by the client takes precedence over the one registered for the request type
+RequestPriority resolveRequestPriority(const FrameHeader& header,
+                                       const ProtocolMessage& request,
+                                       const RequestPriorityResolver& priority_resolver);
+
+std::unique_ptr<UnixDomainServerBackend> makeUnixDomainServerBackend(boost::asio::io_context& io_context,
+                                                                     const std::string& socket_path,
+                                                                     RequestHandler request_handler,
+                                                                     RequestPriorityResolver priority_resolver,
+                                                                     TrafficCaptureWriter* traffic_capture,
+                                                                     const SyncServerOptions& server_options);
+}  // namespace ipcourier::_detail
+
+#endif  // INTER_PROCESS_COURIER_UNIXDOMAINSERVERBACKEND_HPP
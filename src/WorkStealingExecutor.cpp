@@ -0,0 +1,140 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "WorkStealingExecutor.hpp"
+
+namespace ipcourier::_detail {
+namespace {
+struct CurrentWorker {
+    const WorkStealingExecutor* executor = nullptr;
+    std::size_t index = 0;
+};
+
+thread_local CurrentWorker current_worker;
+
+// Rounds of looking through all deques before an idle worker parks, a task submitted meanwhile is picked up
+// without waking a parked thread
+constexpr int k_idle_spin_rounds = 64;
+}  // namespace
+
+WorkStealingExecutor::WorkStealingExecutor(const std::size_t worker_count) {
+    for (std::size_t i = 0; i < worker_count; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+
+    for (std::size_t i = 0; i < worker_count; ++i) {
+        m_threads.emplace_back([this, i] { runWorker(i); });
+    }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+    {
+        std::lock_guard lock(m_park_mutex);
+        m_stopping = true;
+    }
+    m_task_submitted.notify_all();
+
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void WorkStealingExecutor::submit(Task task) {
+    const auto worker_index = current_worker.executor == this
+                                  ? current_worker.index
+                                  : m_next_worker.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+
+    {
+        auto& worker = *m_workers[worker_index];
+        std::lock_guard lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+
+    // Either the parking worker sees the task in m_queued_tasks or this sees the worker in m_parked_workers, both
+    // are sequentially consistent
+    m_queued_tasks.fetch_add(1);
+    if (m_parked_workers.load() > 0) {
+        // Locked so the notification cannot fall between the check and the wait of a parking worker
+        std::lock_guard lock(m_park_mutex);
+        m_task_submitted.notify_one();
+    }
+}
+
+std::size_t WorkStealingExecutor::getWorkerCount() const {
+    return m_workers.size();
+}
+
+void WorkStealingExecutor::runWorker(const std::size_t worker_index) {
+    current_worker = CurrentWorker{.executor = this, .index = worker_index};
+
+    int idle_rounds = 0;
+    while (true) {
+        if (auto task = tryTakeTask(worker_index); task) {
+            idle_rounds = 0;
+            task();
+            continue;
+        }
+
+        // Queued tasks are run before stopping
+        if (m_stopping.load()) {
+            return;
+        }
+
+        if (++idle_rounds < k_idle_spin_rounds) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        idle_rounds = 0;
+        park();
+    }
+}
+
+WorkStealingExecutor::Task WorkStealingExecutor::tryTakeTask(const std::size_t worker_index) {
+    {
+        auto& own_worker = *m_workers[worker_index];
+        std::lock_guard lock(own_worker.mutex);
+        if (!own_worker.tasks.empty()) {
+            auto task = std::move(own_worker.tasks.front());
+            own_worker.tasks.pop_front();
+            m_queued_tasks.fetch_sub(1);
+            return task;
+        }
+    }
+
+    for (std::size_t offset = 1; offset < m_workers.size(); ++offset) {
+        auto& victim = *m_workers[(worker_index + offset) % m_workers.size()];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            auto task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            m_queued_tasks.fetch_sub(1);
+            return task;
+        }
+    }
+
+    return {};
+}
+
+void WorkStealingExecutor::park() {
+    std::unique_lock lock(m_park_mutex);
+    m_parked_workers.fetch_add(1);
+    m_task_submitted.wait(lock, [this] { return m_queued_tasks.load() > 0 || m_stopping.load(); });
+    m_parked_workers.fetch_sub(1);
+}
+}  // namespace ipcourier::_detail
@@ -0,0 +1,83 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef INTER_PROCESS_COURIER_WORKSTEALINGEXECUTOR_HPP
+#define INTER_PROCESS_COURIER_WORKSTEALINGEXECUTOR_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ipcourier::_detail {
+// Runs tasks on a fixed set of worker threads. Every worker owns a deque and serves it oldest first, a worker
+// whose deque ran dry steals the newest task of another one, so a single slow task never holds up the tasks
+// queued behind it while other workers are idle. Submitting only locks the deque it pushes to, a worker that
+// found nothing for a while parks until a task is submitted.
+class WorkStealingExecutor {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingExecutor(std::size_t worker_count);
+
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+    // Runs all tasks that are still queued before joining the workers
+    ~WorkStealingExecutor();
+
+    // Tasks submitted by a worker go to its own deque, others are spread round-robin
+    void submit(Task task);
+
+    std::size_t getWorkerCount() const;
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker> > m_workers;
+    std::atomic<std::size_t> m_next_worker = 0;
+
+    // Counted after the push and before the pop, so it is briefly negative when a task is taken right away
+    std::atomic<std::ptrdiff_t> m_queued_tasks = 0;
+    std::atomic<std::size_t> m_parked_workers = 0;
+    std::atomic<bool> m_stopping = false;
+    std::mutex m_park_mutex;
+    std::condition_variable m_task_submitted;
+
+    std::vector<std::thread> m_threads;
+
+    void runWorker(std::size_t worker_index);
+
+    // Empty if all deques are empty
+    Task tryTakeTask(std::size_t worker_index);
+
+    // Returns once a task may be queued or the executor stops
+    void park();
+};
+}  // namespace ipcourier::_detail
+
+#endif  // INTER_PROCESS_COURIER_WORKSTEALINGEXECUTOR_HPP
@@ -0,0 +1,62 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "BufferPool.hpp"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+using ipcourier::_detail::BufferPool;
+
+TEST(BufferPool, take_ReturnsRecycledBufferWithItsCapacity) {
+    BufferPool<std::string> pool(2);
+
+    std::string buffer(1000, 'x');
+    const auto* data = buffer.data();
+    pool.recycle(std::move(buffer));
+    ASSERT_EQ(pool.getSpareCount(), 1);
+
+    const auto reused = pool.take();
+    ASSERT_TRUE(reused.empty());
+    ASSERT_GE(reused.capacity(), 1000);
+    ASSERT_EQ(reused.data(), data);
+    ASSERT_EQ(pool.getSpareCount(), 0);
+}
+
+TEST(BufferPool, take_ReturnsEmptyBufferWhenNoneIsSpare) {
+    BufferPool<std::string> pool(2);
+
+    ASSERT_TRUE(pool.take().empty());
+}
+
+TEST(BufferPool, recycle_KeepsAtMostMaxSpareCount) {
+    BufferPool<std::string> pool(2);
+
+    for (int i = 0; i < 5; ++i) {
+        pool.recycle(std::string(100, 'x'));
+    }
+    ASSERT_EQ(pool.getSpareCount(), 2);
+}
+
+TEST(BufferPool, recycle_ReleasesBuffersAboveRetainedSize) {
+    BufferPool<std::string> pool(2);
+
+    pool.recycle(std::string(ipcourier::_detail::k_retained_buffer_size + 1, 'x'));
+    ASSERT_EQ(pool.getSpareCount(), 0);
+}
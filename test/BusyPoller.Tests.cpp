@@ -0,0 +1,72 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "BusyPoller.hpp"
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+using ipcourier::_detail::BusyPoller;
+
+TEST(BusyPoller, isEnabled_FalseForZeroBudget) {
+    ASSERT_FALSE(BusyPoller(std::chrono::microseconds(0)).isEnabled());
+    ASSERT_TRUE(BusyPoller(std::chrono::microseconds(1)).isEnabled());
+}
+
+TEST(BusyPoller, poll_CountsReadinessWithinTheBudgetAsHit) {
+    BusyPoller poller(std::chrono::seconds(10));
+
+    int checks = 0;
+    ASSERT_TRUE(poller.poll([&checks] { return ++checks == 3; }));
+    ASSERT_EQ(checks, 3);
+
+    const auto statistics = poller.getStatistics();
+    ASSERT_EQ(statistics.spin_hits, 1);
+    ASSERT_EQ(statistics.spin_misses, 0);
+}
+
+TEST(BusyPoller, poll_GivesUpOnceTheBudgetIsUsedUp) {
+    BusyPoller poller(std::chrono::microseconds(200));
+
+    const auto started_at = std::chrono::steady_clock::now();
+    ASSERT_FALSE(poller.poll([] { return false; }));
+    ASSERT_GE(std::chrono::steady_clock::now() - started_at, std::chrono::microseconds(200));
+
+    const auto statistics = poller.getStatistics();
+    ASSERT_EQ(statistics.spin_hits, 0);
+    ASSERT_EQ(statistics.spin_misses, 1);
+}
+
+TEST(BusyPoller, poll_SkipsSpinningAfterARunOfMisses) {
+    BusyPoller poller(std::chrono::microseconds(1));
+    for (unsigned i = 0; i < ipcourier::_detail::k_busy_poll_misses_before_backoff; ++i) {
+        ASSERT_FALSE(poller.poll([] { return false; }));
+    }
+
+    bool checked = false;
+    ASSERT_FALSE(poller.poll([&checked] { return checked = true; }));
+    ASSERT_FALSE(checked);
+    ASSERT_EQ(poller.getStatistics().spins_skipped, 1);
+
+    for (unsigned i = 1; i < ipcourier::_detail::k_busy_poll_backoff_waits; ++i) {
+        poller.poll([] { return true; });
+    }
+    ASSERT_TRUE(poller.poll([] { return true; }));
+    ASSERT_EQ(poller.getStatistics().spin_hits, 1);
+}
@@ -0,0 +1,172 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "TestServer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <InterProcessCourier/CoalescingSyncClient.hpp>
+#include <InterProcessCourier/SyncServer.hpp>
+#include <gtest/gtest.h>
+
+#include "ProtoForTests.pb.h"
+
+#include <unistd.h>
+
+using ipcourier::CoalescingSyncClient;
+using ipcourier::SyncClientError;
+using ipcourier::SyncServer;
+using ipcourier::test::makeSocketPath;
+using ipcourier::test::runServer;
+using HelloWorld = ipcourier::test_proto::HelloWorld;
+
+namespace {
+class CoalescingSyncClientTest : public ::testing::Test {
+protected:
+    std::string socket_path = std::format("/tmp/ipcourier-coalescing-test-{}.sock", getpid());
+
+    void SetUp() override {
+        unlink(socket_path.c_str());
+    }
+};
+
+// Holds every request in its handler until released, so the test decides how long a request is in flight
+class BlockingServer {
+public:
+    explicit BlockingServer(const std::string& socket_path) {
+        ipcourier::SyncServerOptions options;
+        options.handler_threads = 1;
+        auto server = std::make_unique<SyncServer>(socket_path, options);
+        server->registerHandler<HelloWorld, HelloWorld>(
+            [this, released = m_released.get_future().share()](const HelloWorld& request) {
+                if (m_handler_calls.fetch_add(1) == 0) {
+                    m_entered.set_value();
+                }
+                released.wait();
+                return request;
+            });
+        runServer(std::move(server));
+    }
+
+    void waitUntilEntered() {
+        m_entered.get_future().wait();
+    }
+
+    void release() {
+        m_released.set_value();
+    }
+
+    int getHandlerCalls() const {
+        return m_handler_calls.load();
+    }
+
+private:
+    std::promise<void> m_entered;
+    std::promise<void> m_released;
+    std::atomic<int> m_handler_calls = 0;
+};
+
+HelloWorld makeHelloWorld(const std::string& message) {
+    HelloWorld hello_world;
+    hello_world.set_message(message);
+    return hello_world;
+}
+}  // namespace
+
+TEST_F(CoalescingSyncClientTest, connect_ReturnsUnableToConnectToServer_WhenServerIsNotListening) {
+    CoalescingSyncClient client(socket_path, {});
+
+    const auto result = client.connect();
+
+    ASSERT_FALSE(result.has_value());
+    ASSERT_EQ(result.error().type, SyncClientError::UnableToConnectToServer);
+}
+
+TEST_F(CoalescingSyncClientTest, sendRequest_ReturnsConnectionError_ForCoalescibleType) {
+    CoalescingSyncClient client(socket_path, {});
+    client.registerCoalescible<HelloWorld>();
+
+    const auto result = client.sendRequest<HelloWorld, HelloWorld>(HelloWorld{});
+
+    ASSERT_FALSE(result.has_value());
+    ASSERT_EQ(result.error().type, SyncClientError::UnableToConnectToServer);
+    ASSERT_EQ(client.getCoalescedRequestCount(), 0);
+}
+
+TEST(CoalescingSyncClient, sendRequest_SharesOneCallBetweenConcurrentIdenticalRequests) {
+    const auto socket_path = makeSocketPath("coalescing-shared");
+    // Leaked with the server it serves
+    auto& server = *new BlockingServer(socket_path);
+
+    CoalescingSyncClient client(socket_path, {});
+    client.registerCoalescible<HelloWorld>();
+
+    constexpr int k_requests = 4;
+    std::vector<std::future<ipcourier::SyncClientResult<HelloWorld> > > responses;
+    const auto send = [&client] { return client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld("shared")); };
+    responses.push_back(std::async(std::launch::async, send));
+    server.waitUntilEntered();
+
+    for (int i = 1; i < k_requests; ++i) {
+        responses.push_back(std::async(std::launch::async, send));
+    }
+    while (client.getCoalescedRequestCount() < k_requests - 1) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    server.release();
+
+    for (auto& response : responses) {
+        const auto result = response.get();
+        ASSERT_TRUE(result.has_value()) << result.error().message;
+        ASSERT_EQ(result->message(), "shared");
+    }
+    ASSERT_EQ(server.getHandlerCalls(), 1);
+}
+
+TEST(CoalescingSyncClient, sendRequest_StopsWaitingAtOwnEarlierDeadline) {
+    const auto socket_path = makeSocketPath("coalescing-deadline");
+    auto& server = *new BlockingServer(socket_path);
+
+    CoalescingSyncClient client(socket_path, {});
+    client.registerCoalescible<HelloWorld>();
+
+    auto first = std::async(std::launch::async, [&client] {
+        return client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld("shared"));
+    });
+    server.waitUntilEntered();
+
+    ipcourier::RequestOptions impatient;
+    impatient.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(50);
+    const auto joined = client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld("shared"), impatient);
+    ASSERT_FALSE(joined.has_value());
+    ASSERT_EQ(joined.error().type, SyncClientError::DeadlineExceeded);
+    ASSERT_EQ(client.getCoalescedRequestCount(), 1);
+
+    server.release();
+    const auto result = first.get();
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+    ASSERT_EQ(result->message(), "shared");
+    ASSERT_EQ(server.getHandlerCalls(), 1);
+}
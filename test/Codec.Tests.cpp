@@ -0,0 +1,225 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include <InterProcessCourier/Codec.hpp>
+#include <gtest/gtest.h>
+
+#include "ProtoForTests.pb.h"
+
+namespace {
+struct Position {
+    static constexpr std::string_view courier_type_name = "test.Position";
+
+    std::uint64_t timestamp_ns;
+    double x;
+    double y;
+};
+
+// Same name and size as Position, but a different field count
+struct SinglePrecisionPosition {
+    static constexpr std::string_view courier_type_name = "test.Position";
+
+    std::uint64_t timestamp_ns;
+    float x;
+    float y;
+    float z;
+    float w;
+};
+
+struct VersionedPosition {
+    static constexpr std::string_view courier_type_name = "test.Position";
+    static constexpr std::uint32_t courier_layout_version = 1;
+
+    std::uint64_t timestamp_ns;
+    double x;
+    double y;
+};
+
+// Same name, size and field count as Position, but different field types
+struct SwappedPosition {
+    static constexpr std::string_view courier_type_name = "test.Position";
+
+    double timestamp_ns;
+    std::uint64_t x;
+    double y;
+};
+
+struct PaddedSample {
+    static constexpr std::string_view courier_type_name = "test.PaddedSample";
+
+    struct Channel {
+        std::uint8_t id;
+        std::uint32_t value;
+    };
+
+    std::uint8_t flags;
+    std::uint64_t timestamp_ns;
+    Channel channels[2];
+};
+
+// Fields cannot be enumerated, so the version identifies the layout
+class OpaqueCounter {
+public:
+    static constexpr std::string_view courier_type_name = "test.OpaqueCounter";
+    static constexpr std::uint32_t courier_layout_version = 1;
+
+    OpaqueCounter() = default;
+
+    explicit OpaqueCounter(const std::uint64_t count) : m_count(count) {}
+
+    std::uint64_t getCount() const {
+        return m_count;
+    }
+
+private:
+    std::uint64_t m_count = 0;
+};
+
+PaddedSample makePaddedSample(const unsigned char padding) {
+    PaddedSample sample;
+    std::memset(&sample, padding, sizeof(sample));
+    sample.flags = 1;
+    sample.timestamp_ns = 7;
+    sample.channels[0] = {.id = 2, .value = 20};
+    sample.channels[1] = {.id = 3, .value = 30};
+    return sample;
+}
+
+struct NotNamed {
+    int value;
+};
+}  // namespace
+
+static_assert(ipcourier::IsCourierMessage<ipcourier::test_proto::HelloWorld>);
+static_assert(ipcourier::IsCourierMessage<Position>);
+static_assert(ipcourier::IsCourierMessage<OpaqueCounter>);
+static_assert(!ipcourier::IsCourierMessage<NotNamed>);
+static_assert(!ipcourier::IsCourierMessage<std::string>);
+
+TEST(Codec, makePayloadFromMessage_MatchesProtoPayload) {
+    ipcourier::test_proto::HelloWorld message;
+    message.set_message("Test Message");
+    message.set_integer(42);
+
+    ASSERT_EQ(ipcourier::_detail::makePayloadFromMessage(message), ipcourier::_detail::makePayloadFromProto(message));
+}
+
+TEST(Codec, makeMessageFromPayload_DecodesProtoMessage) {
+    ipcourier::test_proto::HelloWorld message;
+    message.set_message("Test Message");
+    message.set_integer(42);
+
+    const auto result = ipcourier::_detail::makeMessageFromPayload<ipcourier::test_proto::HelloWorld>(
+        ipcourier::_detail::makePayloadFromMessage(message));
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->message(), "Test Message");
+    ASSERT_EQ(result->integer(), 42);
+}
+
+TEST(Codec, makeMessageFromBody_ReturnsDeserializationFailedError_WhenCorruptProtoData) {
+    const auto result = ipcourier::_detail::makeMessageFromBody<ipcourier::test_proto::HelloWorld>("\xff\xff\xff");
+
+    ASSERT_FALSE(result.has_value());
+    ASSERT_EQ(result.error().type, ipcourier::_detail::ProtoPayloadParseError::DeserializationFailed);
+    ASSERT_EQ(result.error().message, "Unable to deserialize as ipcourier.test_proto.HelloWorld");
+}
+
+TEST(Codec, makePayloadFromMessage_CopiesTrivialMessageBytes) {
+    const Position position{.timestamp_ns = 7, .x = 1.5, .y = -2.5};
+
+    const auto payload = ipcourier::_detail::makePayloadFromMessage(position);
+    const auto type_name = ipcourier::_detail::getMessageTypeName<Position>();
+
+    ASSERT_EQ(payload.size(), type_name.size() + 1 + sizeof(Position));
+    ASSERT_TRUE(payload.starts_with(std::string(type_name) + ":"));
+}
+
+TEST(Codec, makeMessageFromPayload_DecodesTrivialMessage) {
+    const Position position{.timestamp_ns = 7, .x = 1.5, .y = -2.5};
+
+    const auto result =
+        ipcourier::_detail::makeMessageFromPayload<Position>(ipcourier::_detail::makePayloadFromMessage(position));
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->timestamp_ns, 7);
+    ASSERT_EQ(result->x, 1.5);
+    ASSERT_EQ(result->y, -2.5);
+}
+
+TEST(Codec, makeMessageFromBody_RejectsTrivialMessageOfWrongSize) {
+    const auto result = ipcourier::_detail::makeMessageFromBody<Position>("short");
+
+    ASSERT_FALSE(result.has_value());
+    ASSERT_EQ(result.error().type, ipcourier::_detail::ProtoPayloadParseError::DeserializationFailed);
+}
+
+TEST(Codec, getMessageTypeName_CarriesLayoutHash) {
+    const auto type_name = ipcourier::_detail::getMessageTypeName<Position>();
+
+    ASSERT_TRUE(type_name.starts_with("test.Position#"));
+    ASSERT_EQ(type_name.size(), std::string_view("test.Position#").size() + 16);
+}
+
+TEST(Codec, getMessageTypeName_DiffersForDifferentLayouts) {
+    const auto type_name = ipcourier::_detail::getMessageTypeName<Position>();
+
+    ASSERT_NE(type_name, ipcourier::_detail::getMessageTypeName<SinglePrecisionPosition>());
+    ASSERT_NE(type_name, ipcourier::_detail::getMessageTypeName<VersionedPosition>());
+}
+
+TEST(Codec, getMessageTypeName_DiffersForDifferentFieldTypes) {
+    ASSERT_NE(ipcourier::_detail::getMessageTypeName<Position>(),
+              ipcourier::_detail::getMessageTypeName<SwappedPosition>());
+}
+
+TEST(Codec, makePayloadFromMessage_ZeroesPadding) {
+    const auto payload = ipcourier::_detail::makePayloadFromMessage(makePaddedSample(0x00));
+
+    ASSERT_EQ(payload, ipcourier::_detail::makePayloadFromMessage(makePaddedSample(0xff)));
+
+    const auto result = ipcourier::_detail::makeMessageFromPayload<PaddedSample>(payload);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->flags, 1);
+    ASSERT_EQ(result->timestamp_ns, 7);
+    ASSERT_EQ(result->channels[1].id, 3);
+    ASSERT_EQ(result->channels[1].value, 30);
+}
+
+TEST(Codec, makeMessageFromPayload_DecodesVersionedOpaqueMessage) {
+    const auto result = ipcourier::_detail::makeMessageFromPayload<OpaqueCounter>(
+        ipcourier::_detail::makePayloadFromMessage(OpaqueCounter(42)));
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->getCount(), 42);
+}
+
+TEST(Codec, makeMessageFromPayload_ReturnsTypeMismatchError_WhenLayoutDiffers) {
+    const Position position{.timestamp_ns = 7, .x = 1.5, .y = -2.5};
+
+    const auto result = ipcourier::_detail::makeMessageFromPayload<VersionedPosition>(
+        ipcourier::_detail::makePayloadFromMessage(position));
+
+    ASSERT_FALSE(result.has_value());
+    ASSERT_EQ(result.error().type, ipcourier::_detail::ProtoPayloadParseError::TypeMismatch);
+}
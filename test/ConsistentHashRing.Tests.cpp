@@ -0,0 +1,74 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "ConsistentHashRing.hpp"
+
+#include <format>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using ipcourier::_detail::ConsistentHashRing;
+
+TEST(ConsistentHashRing, getNode_IsStableForTheSameKey) {
+    const std::vector<std::string> nodes{"shard-a", "shard-b", "shard-c"};
+    const ConsistentHashRing ring(nodes);
+    const ConsistentHashRing other_ring(nodes);
+
+    for (int i = 0; i < 100; ++i) {
+        const auto key = std::format("key-{}", i);
+        ASSERT_EQ(ring.getNode(key), other_ring.getNode(key));
+    }
+}
+
+TEST(ConsistentHashRing, getNode_SpreadsKeysEvenly) {
+    const std::vector<std::string> nodes{"shard-a", "shard-b", "shard-c", "shard-d"};
+    const ConsistentHashRing ring(nodes);
+
+    std::vector<int> counts(nodes.size());
+    constexpr int key_count = 40000;
+    for (int i = 0; i < key_count; ++i) {
+        ++counts[ring.getNode(std::format("key-{}", i))];
+    }
+
+    for (const auto count : counts) {
+        ASSERT_GT(count, key_count / 4 * 8 / 10);
+        ASSERT_LT(count, key_count / 4 * 12 / 10);
+    }
+}
+
+TEST(ConsistentHashRing, getNode_OnlyMovesKeysOfAddedNode) {
+    const ConsistentHashRing ring(std::vector<std::string>{"shard-a", "shard-b", "shard-c"});
+    const ConsistentHashRing grown_ring(std::vector<std::string>{"shard-a", "shard-b", "shard-c", "shard-d"});
+
+    for (int i = 0; i < 10000; ++i) {
+        const auto key = std::format("key-{}", i);
+        const auto node = grown_ring.getNode(key);
+        if (node != 3) {
+            ASSERT_EQ(node, ring.getNode(key));
+        }
+    }
+}
+
+TEST(ConsistentHashRing, getNode_ReturnsOnlyNode) {
+    const ConsistentHashRing ring(std::vector<std::string>{"shard-a"});
+
+    ASSERT_EQ(ring.getNodeCount(), 1);
+    ASSERT_EQ(ring.getNode("anything"), 0);
+}
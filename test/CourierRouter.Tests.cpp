@@ -0,0 +1,173 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <future>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "TestServer.hpp"
+
+#include <InterProcessCourier/CourierRouter.hpp>
+#include <InterProcessCourier/TrafficCapture.hpp>
+#include <gtest/gtest.h>
+
+#include "InternalRequests.pb.h"
+#include "ProtoForTests.pb.h"
+
+#include <unistd.h>
+
+namespace {
+class CourierRouterTest : public ::testing::Test {
+protected:
+    std::string router_path = std::format("/tmp/ipcourier-router-test-{}.sock", getpid());
+    std::string backend_path = std::format("/tmp/ipcourier-router-test-backend-{}.sock", getpid());
+
+    // The router binds its socket on construction, a file left behind would make that fail
+    void SetUp() override {
+        unlink(router_path.c_str());
+        unlink(backend_path.c_str());
+    }
+
+    void TearDown() override {
+        unlink(router_path.c_str());
+    }
+};
+
+struct Tick {
+    static constexpr std::string_view courier_type_name = "test.Tick";
+
+    std::uint64_t sequence;
+};
+}  // namespace
+
+TEST_F(CourierRouterTest, getRoute_ReturnsNothing_BeforeRoutesAreDiscovered) {
+    const ipcourier::CourierRouter router(router_path, {backend_path}, {});
+
+    ASSERT_FALSE(router.getRoute("ipcourier.test_proto.HelloWorld").has_value());
+}
+
+TEST_F(CourierRouterTest, discoverRoutes_ReturnsUnableToReachBackend_WhenBackendIsNotListening) {
+    ipcourier::CourierRouter router(router_path, {backend_path}, {});
+
+    const auto result = router.discoverRoutes();
+
+    ASSERT_FALSE(result.has_value());
+    ASSERT_EQ(result.error().type, ipcourier::CourierRouterError::UnableToReachBackend);
+    ASSERT_TRUE(result.error().message.str().starts_with(std::format("Backend {}:", backend_path)));
+}
+
+TEST_F(CourierRouterTest, discoverRoutes_Succeeds_WithoutBackends) {
+    ipcourier::CourierRouter router(router_path, {}, {});
+
+    ASSERT_TRUE(router.discoverRoutes().has_value());
+}
+
+TEST_F(CourierRouterTest, discoverRoutes_LeavesTheBackendsHelloToTheRouter) {
+    using HelloWorld = ipcourier::test_proto::HelloWorld;
+
+    const auto live_backend_path = ipcourier::test::makeSocketPath("router-hello-backend");
+    auto backend = std::make_unique<ipcourier::SyncServer>(live_backend_path, ipcourier::SyncServerOptions{});
+    backend->registerHandler<HelloWorld, HelloWorld>([](const HelloWorld& request) { return request; });
+    ipcourier::test::runServer(std::move(backend));
+
+    // A backend advertising its hello made the first registration throw
+    ipcourier::CourierRouterOptions options;
+    options.server_options.duplicate_registration_strategy =
+        ipcourier::DuplicateRequestResponsePairRegistrationStrategy::Throw;
+    ipcourier::CourierRouter router(router_path, {live_backend_path}, options);
+
+    const auto result = router.discoverRoutes();
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+    ASSERT_EQ(router.getRoute("ipcourier.test_proto.HelloWorld"), live_backend_path);
+    ASSERT_FALSE(router.getRoute("ipcourier.internal.Hello").has_value());
+}
+
+TEST_F(CourierRouterTest, start_ForwardsToBackendsOverPooledConnections) {
+    using HelloWorld = ipcourier::test_proto::HelloWorld;
+    using MappingReflectionRequest =
+        ipcourier::internal_request_proto::IPCInternal_GetRequestResponseMappingPairsRequest;
+    using MappingReflectionResponse =
+        ipcourier::internal_request_proto::IPCInternal_GetRequestResponseMappingPairsResponse;
+
+    // The capture tells which connection every request arrived on
+    const auto request_backend_path = ipcourier::test::makeSocketPath("router-request-backend");
+    const auto capture_path = std::format("/tmp/ipcourier-router-test-capture-{}.bin", getpid());
+    ipcourier::SyncServerOptions request_backend_options;
+    request_backend_options.traffic_capture = ipcourier::TrafficCaptureOptions{};
+    request_backend_options.traffic_capture->path = capture_path;
+    auto request_backend = std::make_unique<ipcourier::SyncServer>(request_backend_path, request_backend_options);
+    request_backend->registerHandler<HelloWorld, HelloWorld>([](const HelloWorld& request) { return request; });
+    ipcourier::test::runServer(std::move(request_backend));
+
+    const auto post_backend_path = ipcourier::test::makeSocketPath("router-post-backend");
+    auto posted = std::make_shared<std::promise<std::uint64_t> >();
+    auto post_backend = std::make_unique<ipcourier::SyncServer>(post_backend_path, ipcourier::SyncServerOptions{});
+    post_backend->registerHandler<Tick>([posted](const Tick& tick) { posted->set_value(tick.sequence); });
+    ipcourier::test::runServer(std::move(post_backend));
+
+    // Leaked like the backends, a router cannot be stopped either
+    auto& router = *new ipcourier::CourierRouter(router_path, {request_backend_path, post_backend_path}, {});
+    const auto discover_result = router.discoverRoutes();
+    ASSERT_TRUE(discover_result.has_value()) << discover_result.error().message;
+    std::thread([&router] { static_cast<void>(router.start()); }).detach();
+
+    ipcourier::SyncClient client(router_path, {});
+    ASSERT_TRUE(client.connect().has_value());
+
+    const auto mappings = client.sendRequest<MappingReflectionRequest, MappingReflectionResponse>({});
+    ASSERT_TRUE(mappings.has_value()) << mappings.error().message;
+    ASSERT_TRUE(mappings->mappings().contains("ipcourier.test_proto.HelloWorld"));
+    ASSERT_TRUE(mappings->mappings().contains(std::string(ipcourier::_detail::getMessageTypeName<Tick>())));
+
+    for (int i = 0; i < 3; ++i) {
+        HelloWorld request;
+        request.set_message(std::format("forwarded {}", i));
+        const auto response = client.sendRequest<HelloWorld, HelloWorld>(request);
+        ASSERT_TRUE(response.has_value()) << response.error().message;
+        ASSERT_EQ(response->message(), request.message());
+    }
+
+    ASSERT_TRUE(client.post(Tick{.sequence = 7}).has_value());
+    auto posted_sequence = posted->get_future();
+    ASSERT_EQ(posted_sequence.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    ASSERT_EQ(posted_sequence.get(), 7);
+
+    // The reflection of the discovery and all forwarded requests share the connection kept in the pool
+    auto capture = ipcourier::TrafficCaptureReader::open(capture_path);
+    unlink(capture_path.c_str());
+    ASSERT_TRUE(capture.has_value()) << capture.error().message;
+    std::vector<std::uint64_t> connection_ids;
+    while (const auto captured = capture->next()) {
+        connection_ids.push_back(captured->connection_id);
+    }
+    ASSERT_EQ(connection_ids.size(), 4);
+    ASSERT_EQ(std::ranges::count(connection_ids, connection_ids.front()), 4);
+}
+
+TEST(CourierRouter, Formatter_FormatsCourierRouterError) {
+    const ipcourier::Error error(ipcourier::CourierRouterError::UnableToReflectRoutes, "no mappings");
+
+    ASSERT_EQ(std::format("{}", error), "Error: Type Unable to reflect routes, Message: \"no mappings\"");
+}
@@ -15,6 +15,7 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
  ***************************************************************************/
 
+#include <cstring>
 #include <format>
 #include <string>
 #include <type_traits>
@@ -143,3 +144,64 @@ TEST(Error, FormatsError_WhenErrorTypeIsZeroValue) {
     const std::string formatted_string = std::format("{}", error);
     ASSERT_EQ(formatted_string, "Error: Type None, Message: \"Default error.\"");
 }
+
+TEST(ErrorMessage, format_FormatsWhenRead) {
+    const std::string type_name = "ipcourier.test_proto.HelloWorld";
+    const auto message = ipcourier::ErrorMessage::format("No handler for {} registered, {} bytes", type_name, 42U);
+
+    ASSERT_EQ(message.str(), "No handler for ipcourier.test_proto.HelloWorld registered, 42 bytes");
+    ASSERT_EQ(message, "No handler for ipcourier.test_proto.HelloWorld registered, 42 bytes");
+    ASSERT_FALSE(message.empty());
+}
+
+TEST(ErrorMessage, format_CopiesTextArguments) {
+    std::string type_name = "first.Type";
+    const auto message = ipcourier::ErrorMessage::format("Received {} but expected {}", type_name, -1);
+    type_name = "other.Type";
+
+    ASSERT_EQ(message, "Received first.Type but expected -1");
+}
+
+TEST(ErrorMessage, format_HandlesTextLongerThanInlineStorage) {
+    const std::string long_text(ipcourier::ErrorMessage::k_max_inline_text_size + 10, 'x');
+    const auto message = ipcourier::ErrorMessage::format("[{}]", long_text);
+
+    ASSERT_EQ(message, std::format("[{}]", long_text));
+}
+
+TEST(ErrorMessage, format_HandlesMoreArgumentsThanKeptInline) {
+    const auto message = ipcourier::ErrorMessage::format("{} {} {}", 1, "two", 3.5);
+
+    ASSERT_EQ(message, "1 two 3.5");
+}
+
+TEST(ErrorMessage, Literal_EndsAtFirstNullCharacter) {
+    const ipcourier::ErrorMessage message("Short\0hidden");
+
+    ASSERT_EQ(message, "Short");
+}
+
+TEST(ErrorMessage, Buffer_IsCopied) {
+    char buffer[32] = "Broken pipe";
+    const ipcourier::ErrorMessage message(buffer);
+    std::strcpy(buffer, "Overwritten");
+
+    ASSERT_EQ(message, "Broken pipe");
+    ASSERT_EQ(message.str(), "Broken pipe");
+}
+
+TEST(ErrorMessage, Copy_KeepsMessage) {
+    auto message = ipcourier::ErrorMessage(std::string("Owned text"));
+    const auto copy = message;
+    message = ipcourier::ErrorMessage();
+
+    ASSERT_EQ(copy, "Owned text");
+    ASSERT_TRUE(message.empty());
+}
+
+TEST(Error, FormatsError_WithDeferredMessage) {
+    const auto error = ipcourier::Error<TestErrorType>(TestErrorType::NetworkError,
+                                                       ipcourier::ErrorMessage::format("Host {} unreachable", "a"));
+    const std::string formatted_string = std::format("{}", error);
+    ASSERT_EQ(formatted_string, "Error: Type NetworkError, Message: \"Host a unreachable\"");
+}
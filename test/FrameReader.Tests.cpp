@@ -0,0 +1,174 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "FrameReader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using ipcourier::_detail::FrameHeader;
+using ipcourier::_detail::FrameReader;
+using ipcourier::_detail::k_frame_header_size;
+
+namespace {
+std::string makeFrame(const std::uint64_t request_id, const std::string& payload) {
+    const FrameHeader header{.payload_length = static_cast<std::uint32_t>(payload.size()), .request_id = request_id};
+
+    std::string frame(k_frame_header_size, '\0');
+    ipcourier::_detail::encodeFrameHeader(header, frame.data());
+    return frame + payload;
+}
+
+void receive(FrameReader& reader, const std::string& bytes) {
+    const auto space = reader.prepare(bytes.size());
+    ASSERT_GE(space.size(), bytes.size());
+    std::memcpy(space.data(), bytes.data(), bytes.size());
+    reader.commit(bytes.size());
+}
+}  // namespace
+
+TEST(FrameReader, next_ParsesAllFramesOfOneRead) {
+    FrameReader reader;
+    receive(reader, makeFrame(1, "first") + makeFrame(2, "") + makeFrame(3, "third"));
+
+    const auto first = reader.next();
+    ASSERT_TRUE(first.has_value());
+    ASSERT_EQ(first->header.request_id, 1);
+    ASSERT_EQ(first->payload, "first");
+
+    const auto second = reader.next();
+    ASSERT_TRUE(second.has_value());
+    ASSERT_EQ(second->header.request_id, 2);
+    ASSERT_TRUE(second->payload.empty());
+
+    const auto third = reader.next();
+    ASSERT_TRUE(third.has_value());
+    ASSERT_EQ(third->payload, "third");
+
+    ASSERT_FALSE(reader.next().has_value());
+    ASSERT_EQ(reader.getBufferedSize(), 0);
+}
+
+TEST(FrameReader, next_WaitsForTheRestOfAPartialFrame) {
+    FrameReader reader;
+    const auto frame = makeFrame(7, "payload");
+
+    receive(reader, frame.substr(0, 3));
+    ASSERT_FALSE(reader.next().has_value());
+
+    receive(reader, frame.substr(3, k_frame_header_size));
+    ASSERT_FALSE(reader.next().has_value());
+
+    receive(reader, frame.substr(3 + k_frame_header_size));
+    const auto parsed = reader.next();
+    ASSERT_TRUE(parsed.has_value());
+    ASSERT_EQ(parsed->header.request_id, 7);
+    ASSERT_EQ(parsed->payload, "payload");
+}
+
+TEST(FrameReader, prepare_MakesRoomForTheRestOfAPartialFrame) {
+    FrameReader reader;
+    const auto frame = makeFrame(1, std::string(100000, 'x'));
+
+    receive(reader, frame.substr(0, 100));
+    ASSERT_GE(reader.prepare(16).size(), frame.size() - 100);
+}
+
+TEST(FrameReader, prepare_GrowsNoLargerThanTheLargestAcceptedFrame) {
+    FrameReader reader(1000);
+    const auto frame = makeFrame(1, std::string(1000, 'x'));
+
+    receive(reader, frame.substr(0, k_frame_header_size + 500));
+    ASSERT_GE(reader.prepare(16).size(), 500);
+    ASSERT_EQ(reader.getCapacity(), frame.size());
+}
+
+TEST(FrameReader, prepare_KeepsUnparsedBytesWhenCompacting) {
+    FrameReader reader;
+    const auto complete = makeFrame(1, std::string(1000, 'a'));
+    const auto partial = makeFrame(2, "second");
+
+    receive(reader, complete + partial.substr(0, 5));
+    ASSERT_TRUE(reader.next().has_value());
+
+    receive(reader, partial.substr(5));
+    const auto parsed = reader.next();
+    ASSERT_TRUE(parsed.has_value());
+    ASSERT_EQ(parsed->header.request_id, 2);
+    ASSERT_EQ(parsed->payload, "second");
+}
+
+TEST(FrameReader, prepare_ReleasesBufferGrownForALargeFrame) {
+    FrameReader reader;
+    const auto large_frame = makeFrame(1, std::string(ipcourier::_detail::k_retained_buffer_size * 2, 'x'));
+
+    receive(reader, large_frame);
+    ASSERT_TRUE(reader.next().has_value());
+    ASSERT_GT(reader.getCapacity(), ipcourier::_detail::k_retained_buffer_size);
+
+    reader.prepare(1024);
+    ASSERT_LE(reader.getCapacity(), ipcourier::_detail::k_retained_buffer_size);
+}
+
+TEST(FrameReader, prepare_ReusesBufferOnceDrained) {
+    FrameReader reader;
+    const auto frame = makeFrame(1, "payload");
+
+    receive(reader, frame);
+    ASSERT_TRUE(reader.next().has_value());
+    const auto capacity = reader.getCapacity();
+
+    for (int i = 0; i < 100; ++i) {
+        receive(reader, frame);
+        ASSERT_TRUE(reader.next().has_value());
+    }
+    ASSERT_EQ(reader.getCapacity(), capacity);
+}
+
+TEST(FrameReader, next_StopsAtAFrameExceedingTheMaximum) {
+    FrameReader reader(16);
+    const auto oversized = makeFrame(2, std::string(17, 'x'));
+    receive(reader, makeFrame(1, "fits") + oversized.substr(0, k_frame_header_size + 4));
+
+    ASSERT_TRUE(reader.next().has_value());
+    ASSERT_FALSE(reader.next().has_value());
+
+    const auto oversized_header = reader.getOversizedFrameHeader();
+    ASSERT_TRUE(oversized_header.has_value());
+    ASSERT_EQ(oversized_header->request_id, 2);
+    ASSERT_EQ(oversized_header->payload_length, 17);
+}
+
+TEST(FrameReader, prepare_DoesNotGrowForAFrameExceedingTheMaximum) {
+    FrameReader reader(1024);
+    const auto oversized = makeFrame(1, std::string(ipcourier::_detail::k_retained_buffer_size * 4, 'x'));
+
+    receive(reader, oversized.substr(0, k_frame_header_size));
+    ASSERT_LT(reader.prepare(16).size(), ipcourier::_detail::k_retained_buffer_size);
+    ASSERT_LE(reader.getCapacity(), ipcourier::_detail::k_retained_buffer_size);
+}
+
+TEST(FrameReader, getOversizedFrameHeader_IgnoresFramesWithinTheMaximum) {
+    FrameReader reader(16);
+    receive(reader, makeFrame(1, std::string(16, 'x')).substr(0, k_frame_header_size));
+
+    ASSERT_FALSE(reader.getOversizedFrameHeader().has_value());
+}
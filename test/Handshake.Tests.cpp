@@ -0,0 +1,96 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "Handshake.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using ipcourier::_detail::decodeHello;
+using ipcourier::_detail::encodeHello;
+using ipcourier::_detail::Hello;
+
+TEST(Handshake, decodeHello_RestoresEncodedHello) {
+    Hello hello;
+    hello.protocol_version = 3;
+    hello.features = 0b1011;
+    hello.max_request_size = 1024;
+    hello.max_response_size = 4096;
+    hello.library_version = "1.2.3";
+    hello.wants_mappings = true;
+    hello.mappings.emplace();
+    hello.mappings->emplace("test.Request", "test.Response");
+    hello.mappings->emplace("test.OneWay", "");
+
+    const auto decoded = decodeHello(encodeHello(hello));
+    ASSERT_TRUE(decoded.has_value());
+    ASSERT_EQ(decoded->protocol_version, 3);
+    ASSERT_EQ(decoded->features, 0b1011);
+    ASSERT_EQ(decoded->max_request_size, 1024);
+    ASSERT_EQ(decoded->max_response_size, 4096);
+    ASSERT_EQ(decoded->library_version, "1.2.3");
+    ASSERT_TRUE(decoded->wants_mappings);
+    ASSERT_EQ(decoded->mappings, hello.mappings);
+}
+
+TEST(Handshake, decodeHello_KeepsMappingsAbsent_WhenNoneWereSent) {
+    Hello hello;
+    hello.library_version = "1.0.0";
+
+    const auto decoded = decodeHello(encodeHello(hello));
+    ASSERT_TRUE(decoded.has_value());
+    ASSERT_FALSE(decoded->wants_mappings);
+    ASSERT_FALSE(decoded->mappings.has_value());
+}
+
+TEST(Handshake, decodeHello_SkipsFieldsAppendedByLaterVersions) {
+    Hello hello;
+    hello.features = 0b1;
+    hello.library_version = "9.9.9";
+    auto encoded = encodeHello(hello);
+
+    // A later version appends to the header and announces the longer header size right after the magic
+    constexpr std::size_t header_size_offset = 4;
+    const std::uint16_t header_size = encoded.size() - std::string("9.9.9").size() + 8;
+    encoded.insert(header_size - 8, 8, '\xff');
+    std::memcpy(encoded.data() + header_size_offset, &header_size, sizeof(header_size));
+
+    const auto decoded = decodeHello(encoded);
+    ASSERT_TRUE(decoded.has_value());
+    ASSERT_EQ(decoded->features, 0b1);
+    ASSERT_EQ(decoded->library_version, "9.9.9");
+}
+
+TEST(Handshake, decodeHello_ReturnsNothing_ForTruncatedOrForeignData) {
+    Hello hello;
+    hello.library_version = "1.0.0";
+    hello.mappings.emplace();
+    hello.mappings->emplace("test.Request", "test.Response");
+    const auto encoded = encodeHello(hello);
+
+    for (std::size_t size = 0; size < encoded.size(); ++size) {
+        ASSERT_FALSE(decodeHello(std::string_view(encoded).substr(0, size)).has_value()) << size;
+    }
+
+    auto foreign = encoded;
+    foreign[0] = 'X';
+    ASSERT_FALSE(decodeHello(foreign).has_value());
+}
@@ -0,0 +1,88 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "HdrHistogram.hpp"
+
+#include <gtest/gtest.h>
+
+using ipcourier::bench::HdrHistogram;
+
+TEST(HdrHistogram, getValueAtPercentile_ExactForSmallValues) {
+    HdrHistogram histogram;
+    for (std::uint64_t value = 1; value <= 100; ++value) {
+        histogram.record(value);
+    }
+
+    ASSERT_EQ(histogram.getTotalCount(), 100);
+    ASSERT_EQ(histogram.getMin(), 1);
+    ASSERT_EQ(histogram.getMax(), 100);
+    ASSERT_EQ(histogram.getValueAtPercentile(50), 50);
+    ASSERT_EQ(histogram.getValueAtPercentile(99), 99);
+    ASSERT_EQ(histogram.getValueAtPercentile(100), 100);
+    ASSERT_DOUBLE_EQ(histogram.getMean(), 50.5);
+}
+
+TEST(HdrHistogram, getValueAtPercentile_KeepsThreeSignificantDigitsForLargeValues) {
+    HdrHistogram histogram;
+    histogram.record(1'000);
+    histogram.record(123'456'789);
+    histogram.record(5'000'000'000);
+
+    const auto median = histogram.getValueAtPercentile(50);
+    ASSERT_GE(median, 123'456'789);
+    ASSERT_LE(median, 123'456'789 + 123'456'789 / 1000);
+    ASSERT_EQ(histogram.getValueAtPercentile(100), 5'000'000'000);
+}
+
+TEST(HdrHistogram, record_ClampsToTheMaximum) {
+    HdrHistogram histogram(1'000'000);
+    histogram.record(5'000'000);
+
+    ASSERT_EQ(histogram.getMax(), 1'000'000);
+    ASSERT_EQ(histogram.getValueAtPercentile(100), 1'000'000);
+}
+
+TEST(HdrHistogram, merge_CombinesSamples) {
+    HdrHistogram first;
+    HdrHistogram second;
+    first.record(10);
+    second.record(30);
+    second.record(20);
+
+    first.merge(second);
+    ASSERT_EQ(first.getTotalCount(), 3);
+    ASSERT_EQ(first.getMin(), 10);
+    ASSERT_EQ(first.getMax(), 30);
+    ASSERT_EQ(first.getValueAtPercentile(50), 20);
+}
+
+TEST(HdrHistogram, decode_RestoresEncodedHistogram) {
+    HdrHistogram histogram;
+    histogram.record(42);
+    histogram.record(7'000'000);
+
+    const auto decoded = HdrHistogram::decode(histogram.encode());
+    ASSERT_TRUE(decoded.has_value());
+    ASSERT_EQ(decoded->getTotalCount(), 2);
+    ASSERT_EQ(decoded->getMin(), 42);
+    ASSERT_EQ(decoded->getMax(), 7'000'000);
+    ASSERT_EQ(decoded->getValueAtPercentile(50), 42);
+    ASSERT_DOUBLE_EQ(decoded->getMean(), histogram.getMean());
+
+    ASSERT_FALSE(HdrHistogram::decode("broken").has_value());
+}
@@ -0,0 +1,109 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "IoUring.hpp"
+
+#if INTER_PROCESS_COURIER_IO_URING_AVAILABLE
+
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+class IoUringTest : public ::testing::Test {
+protected:
+    std::unique_ptr<ipcourier::_detail::IoUring> ring;
+    int sockets[2] = {-1, -1};
+
+    void SetUp() override {
+        auto ring_result = ipcourier::_detail::IoUring::create(8);
+        if (!ring_result.has_value()) {
+            GTEST_SKIP() << "io_uring is not available: " << ring_result.error().message;
+        }
+
+        ring = std::move(ring_result.value());
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+    }
+
+    void TearDown() override {
+        for (const auto socket : sockets) {
+            if (socket >= 0) {
+                close(socket);
+            }
+        }
+    }
+};
+}  // namespace
+
+TEST_F(IoUringTest, ProvidedBufferRing_ReceivesIntoKernelSelectedBuffer) {
+    auto buffer_ring_result = ipcourier::_detail::ProvidedBufferRing::create(*ring, 3, 4, 64);
+    if (!buffer_ring_result.has_value()) {
+        GTEST_SKIP() << "Provided buffer rings are not available: " << buffer_ring_result.error().message;
+    }
+    const auto& buffer_ring = buffer_ring_result.value();
+
+    ASSERT_EQ(write(sockets[1], "courier", 7), 7);
+
+    auto* entry = ring->getSubmissionEntry().value();
+    entry->opcode = IORING_OP_RECV;
+    entry->fd = sockets[0];
+    entry->flags = IOSQE_BUFFER_SELECT;
+    entry->buf_group = buffer_ring->getGroupId();
+    entry->user_data = 42;
+    ASSERT_TRUE(ring->submitAndWait(1).has_value());
+
+    std::vector<io_uring_cqe> completions;
+    ring->forEachCompletion([&completions](const io_uring_cqe& completion) { completions.push_back(completion); });
+
+    ASSERT_EQ(completions.size(), 1);
+    ASSERT_EQ(completions[0].user_data, 42);
+    ASSERT_EQ(completions[0].res, 7);
+    ASSERT_NE(completions[0].flags & IORING_CQE_F_BUFFER, 0);
+
+    const auto buffer_id = static_cast<std::uint16_t>(completions[0].flags >> IORING_CQE_BUFFER_SHIFT);
+    const auto received = buffer_ring->getBuffer(buffer_id, 7);
+    ASSERT_EQ(std::string_view(received.data(), received.size()), "courier");
+    buffer_ring->recycleBuffer(buffer_id);
+}
+
+TEST_F(IoUringTest, ProvidedBufferRing_RejectsBufferCountNotPowerOfTwo) {
+    const auto buffer_ring_result = ipcourier::_detail::ProvidedBufferRing::create(*ring, 0, 3, 64);
+    ASSERT_FALSE(buffer_ring_result.has_value());
+    ASSERT_EQ(buffer_ring_result.error().type, ipcourier::_detail::IoUringError::RegistrationFailed);
+}
+
+TEST_F(IoUringTest, GetSubmissionEntry_SubmitsWhenQueueIsFull) {
+    const auto initial_free = ring->getFreeSubmissionEntries();
+    for (unsigned i = 0; i < initial_free + 1; ++i) {
+        auto* entry = ring->getSubmissionEntry().value();
+        entry->opcode = IORING_OP_NOP;
+        entry->user_data = i;
+    }
+    ASSERT_TRUE(ring->submitAndWait(initial_free + 1).has_value());
+
+    unsigned completed = 0;
+    ring->forEachCompletion([&completed](const io_uring_cqe& completion) {
+        ASSERT_EQ(completion.res, 0);
+        ++completed;
+    });
+    ASSERT_EQ(completed, initial_free + 1);
+}
+
+#endif  // INTER_PROCESS_COURIER_IO_URING_AVAILABLE
@@ -128,8 +128,8 @@ TEST(ProtobufTools, makeProtoFromPayload_ReturnsInvalidFormatError_WhenLongPaylo
 
     ASSERT_FALSE(result.has_value());
     ASSERT_EQ(result.error().type, ipcourier::_detail::ProtoPayloadParseError::InvalidFormat);
-    ASSERT_TRUE(result.error().message.rfind("Received message: ipcourier.test_proto.HelloWorldA", 0) == 0);
-    ASSERT_TRUE(result.error().message.find("...") != std::string::npos);
+    ASSERT_TRUE(result.error().message.str().rfind("Received message: ipcourier.test_proto.HelloWorldA", 0) == 0);
+    ASSERT_TRUE(result.error().message.str().find("...") != std::string::npos);
 }
 
 TEST(ProtobufTools, makeProtoFromPayload_ReturnsTypeMismatchError_WhenExpectedTypeDiffers) {
@@ -237,8 +237,8 @@ TEST(ProtobufTools, makeBaseProtoFromPayload_ReturnsDeserializationFailedError_W
 
     ASSERT_FALSE(result.has_value());
     ASSERT_EQ(result.error().type, ipcourier::_detail::ProtoPayloadParseError::DeserializationFailed);
-    ASSERT_TRUE(result.error().message.rfind("Unable to deserialize as ipcourier.test_proto.HelloWorld. Message:", 0) ==
-                0);
+    ASSERT_TRUE(result.error().message.str().starts_with(
+        "Unable to deserialize as ipcourier.test_proto.HelloWorld. Message:"));
 }
 
 TEST(ProtobufTools, makeBaseProtoFromPayload_ReturnsDeserializationFailedError_WhenEmptyBinaryDataForNonEmptyMessage) {
@@ -255,3 +255,15 @@ TEST(ProtobufTools, makeBaseProtoFromPayload_ReturnsDeserializationFailedError_W
     ASSERT_TRUE(deserialized_msg->message().empty());
     ASSERT_EQ(deserialized_msg->integer(), 0);
 }
+
+TEST(ProtobufTools, splitProtoPayload_SplitsAtFirstDelimiter) {
+    const auto parts = ipcourier::_detail::splitProtoPayload("my.package.MyMessage:a:b");
+
+    ASSERT_TRUE(parts.has_value());
+    ASSERT_EQ(parts->type_name, "my.package.MyMessage");
+    ASSERT_EQ(parts->body, "a:b");
+}
+
+TEST(ProtobufTools, splitProtoPayload_ReturnsNothing_WhenNoDelimiter) {
+    ASSERT_FALSE(ipcourier::_detail::splitProtoPayload("my.package.MyMessage").has_value());
+}
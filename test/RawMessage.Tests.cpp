@@ -0,0 +1,73 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include <string>
+
+#include <InterProcessCourier/RawMessage.hpp>
+#include <gtest/gtest.h>
+
+#include "ProtoForTests.pb.h"
+
+TEST(RawMessage, Constructor_KeepsTypeNameAndBody) {
+    const ipcourier::RawMessage message("my.package.MyMessage", std::string("\x08\x01:\x10", 4));
+
+    ASSERT_EQ(message.getTypeName(), "my.package.MyMessage");
+    ASSERT_EQ(message.getBody(), std::string("\x08\x01:\x10", 4));
+}
+
+TEST(RawMessage, fromMessage_SerializesMessage) {
+    ipcourier::test_proto::HelloWorld hello_world;
+    hello_world.set_message("Test Message");
+    hello_world.set_integer(42);
+
+    const auto message = ipcourier::RawMessage::fromMessage(hello_world);
+
+    ASSERT_EQ(message.getTypeName(), ipcourier::test_proto::HelloWorld::descriptor()->full_name());
+    ASSERT_EQ(message.getBody(), hello_world.SerializeAsString());
+}
+
+TEST(RawMessage, parse_ReturnsMessage_WhenTypeMatches) {
+    ipcourier::test_proto::HelloWorld hello_world;
+    hello_world.set_message("Test Message");
+    hello_world.set_integer(42);
+
+    const auto parsed = ipcourier::RawMessage::fromMessage(hello_world).parse<ipcourier::test_proto::HelloWorld>();
+
+    ASSERT_TRUE(parsed.has_value());
+    ASSERT_EQ(parsed->message(), "Test Message");
+    ASSERT_EQ(parsed->integer(), 42);
+}
+
+TEST(RawMessage, parse_ReturnsNothing_WhenTypeDiffers) {
+    const ipcourier::RawMessage message("other.Message", "");
+
+    ASSERT_FALSE(message.parse<ipcourier::test_proto::HelloWorld>().has_value());
+}
+
+TEST(RawMessage, makeRawMessage_SplitsPayloadAtFirstDelimiter) {
+    auto message = ipcourier::_detail::makeRawMessage("my.package.MyMessage:a:b");
+
+    ASSERT_TRUE(message.has_value());
+    ASSERT_EQ(message->getTypeName(), "my.package.MyMessage");
+    ASSERT_EQ(message->getBody(), "a:b");
+    ASSERT_EQ(ipcourier::_detail::takeRawMessagePayload(std::move(message.value())), "my.package.MyMessage:a:b");
+}
+
+TEST(RawMessage, makeRawMessage_ReturnsNothing_WhenNoDelimiter) {
+    ASSERT_FALSE(ipcourier::_detail::makeRawMessage("my.package.MyMessage").has_value());
+}
@@ -0,0 +1,88 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "RequestScheduler.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using ipcourier::RequestPriority;
+
+TEST(RequestScheduler, pop_EmptyReturnsNothing) {
+    ipcourier::_detail::RequestScheduler<int> scheduler;
+
+    ASSERT_TRUE(scheduler.empty());
+    ASSERT_FALSE(scheduler.pop().has_value());
+}
+
+TEST(RequestScheduler, pop_ServesHigherPriorityFirst) {
+    ipcourier::_detail::RequestScheduler<int> scheduler;
+    scheduler.push(RequestPriority::Low, 1);
+    scheduler.push(RequestPriority::Normal, 2);
+    scheduler.push(RequestPriority::High, 3);
+
+    ASSERT_EQ(scheduler.size(), 3);
+    ASSERT_EQ(scheduler.pop(), 3);
+    ASSERT_EQ(scheduler.pop(), 2);
+    ASSERT_EQ(scheduler.pop(), 1);
+    ASSERT_TRUE(scheduler.empty());
+}
+
+TEST(RequestScheduler, pop_KeepsArrivalOrderWithinPriority) {
+    ipcourier::_detail::RequestScheduler<int> scheduler;
+    scheduler.push(RequestPriority::Normal, 1);
+    scheduler.push(RequestPriority::Normal, 2);
+    scheduler.push(RequestPriority::Normal, 3);
+
+    ASSERT_EQ(scheduler.pop(), 1);
+    ASSERT_EQ(scheduler.pop(), 2);
+    ASSERT_EQ(scheduler.pop(), 3);
+}
+
+TEST(RequestScheduler, pop_ServesStarvedLowerPriority) {
+    constexpr std::size_t starvation_limit = 2;
+    ipcourier::_detail::RequestScheduler<int> scheduler(starvation_limit);
+    scheduler.push(RequestPriority::Low, 0);
+    for (int i = 1; i <= 5; ++i) {
+        scheduler.push(RequestPriority::High, i);
+    }
+
+    std::vector<int> order;
+    while (!scheduler.empty()) {
+        order.push_back(scheduler.pop().value());
+    }
+
+    ASSERT_EQ(order, (std::vector<int>{1, 2, 0, 3, 4, 5}));
+}
+
+TEST(RequestScheduler, pop_StarvationCounterResetsWhenLaneDrains) {
+    constexpr std::size_t starvation_limit = 1;
+    ipcourier::_detail::RequestScheduler<int> scheduler(starvation_limit);
+    scheduler.push(RequestPriority::Low, 0);
+    scheduler.push(RequestPriority::High, 1);
+    scheduler.push(RequestPriority::High, 2);
+
+    ASSERT_EQ(scheduler.pop(), 1);
+    ASSERT_EQ(scheduler.pop(), 0);
+    ASSERT_EQ(scheduler.pop(), 2);
+
+    scheduler.push(RequestPriority::Low, 3);
+    scheduler.push(RequestPriority::High, 4);
+    ASSERT_EQ(scheduler.pop(), 4);
+    ASSERT_EQ(scheduler.pop(), 3);
+}
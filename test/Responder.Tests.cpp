@@ -0,0 +1,69 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <InterProcessCourier/Responder.hpp>
+#include <InterProcessCourier/SyncServer.hpp>
+#include <gtest/gtest.h>
+
+#include "InternalRequests.pb.h"
+#include "ProtoForTests.pb.h"
+
+using ipcourier::_detail::DeferredResponse;
+using ipcourier::_detail::SerializedProtoPayload;
+
+TEST(Responder, respond_CompletesOnlyOnce) {
+    std::vector<SerializedProtoPayload> completions;
+    auto deferred_response = std::make_shared<DeferredResponse>(
+        [&completions](SerializedProtoPayload payload) { completions.push_back(std::move(payload)); });
+
+    ipcourier::test_proto::HelloWorld first;
+    first.set_integer(1);
+    ipcourier::test_proto::HelloWorld second;
+    second.set_integer(2);
+
+    {
+        const ipcourier::Responder<ipcourier::test_proto::HelloWorld> responder(deferred_response);
+        const auto responder_copy = responder;
+        deferred_response.reset();
+
+        responder.respond(first);
+        responder_copy.respond(second);
+    }
+
+    ASSERT_EQ(completions.size(), 1);
+    ASSERT_EQ(completions.front(), ipcourier::_detail::makePayloadFromProto(first));
+}
+
+TEST(Responder, destroy_AbandonedResponseCompletesWithError) {
+    std::vector<SerializedProtoPayload> completions;
+    {
+        const ipcourier::Responder<ipcourier::test_proto::HelloWorld> responder(std::make_shared<DeferredResponse>(
+            [&completions](SerializedProtoPayload payload) { completions.push_back(std::move(payload)); }));
+    }
+
+    ASSERT_EQ(completions.size(), 1);
+    const auto error_response =
+        ipcourier::_detail::makeProtoFromPayload<ipcourier::internal_request_proto::IPCInternal_ErrorResponse>(
+            completions.front());
+    ASSERT_TRUE(error_response.has_value());
+    ASSERT_EQ(error_response->error_type(), static_cast<std::int32_t>(ipcourier::SyncServerError::RuntimeError));
+}
@@ -0,0 +1,90 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "ResponseCache.hpp"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+using ipcourier::ResponseCacheOptions;
+using ipcourier::_detail::ResponseCache;
+
+TEST(ResponseCache, find_ReturnsInsertedResponse) {
+    ResponseCache cache(ResponseCacheOptions{});
+
+    cache.insert("request", "Type:response");
+
+    const auto response = cache.find("request");
+    ASSERT_NE(response, nullptr);
+    ASSERT_EQ(*response, "Type:response");
+    ASSERT_EQ(cache.find("other request"), nullptr);
+}
+
+TEST(ResponseCache, find_SharesResponseBetweenHits) {
+    ResponseCache cache(ResponseCacheOptions{});
+
+    cache.insert("request", "Type:response");
+
+    ASSERT_EQ(cache.find("request"), cache.find("request"));
+}
+
+TEST(ResponseCache, insert_EvictsLeastRecentlyUsedEntry_WhenMaxEntriesExceeded) {
+    ResponseCacheOptions options;
+    options.max_entries = 2;
+    ResponseCache cache(options);
+
+    cache.insert("a", "response a");
+    cache.insert("b", "response b");
+    ASSERT_NE(cache.find("a"), nullptr);
+    cache.insert("c", "response c");
+
+    ASSERT_EQ(cache.getEntryCount(), 2);
+    ASSERT_NE(cache.find("a"), nullptr);
+    ASSERT_EQ(cache.find("b"), nullptr);
+    ASSERT_NE(cache.find("c"), nullptr);
+}
+
+TEST(ResponseCache, insert_EvictsUntilWithinMaxBytes) {
+    ResponseCacheOptions options;
+    options.max_entries = 0;
+    options.max_bytes = 20;
+    ResponseCache cache(options);
+
+    cache.insert("a", std::string(9, 'x'));
+    cache.insert("b", std::string(9, 'y'));
+    ASSERT_EQ(cache.getByteCount(), 20);
+    cache.insert("c", std::string(4, 'z'));
+
+    ASSERT_EQ(cache.getEntryCount(), 2);
+    ASSERT_EQ(cache.getByteCount(), 15);
+    ASSERT_EQ(cache.find("a"), nullptr);
+}
+
+TEST(ResponseCache, insert_SkipsEntriesLargerThanMaxBytes) {
+    ResponseCacheOptions options;
+    options.max_bytes = 8;
+    ResponseCache cache(options);
+
+    cache.insert("small", "r");
+    cache.insert("large", std::string(16, 'x'));
+
+    ASSERT_EQ(cache.getEntryCount(), 1);
+    ASSERT_NE(cache.find("small"), nullptr);
+    ASSERT_EQ(cache.find("large"), nullptr);
+}
@@ -0,0 +1,90 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "ServerAdmissionController.hpp"
+
+#include <InterProcessCourier/detail/ProtobufTools.hpp>
+#include <gtest/gtest.h>
+
+#include "InternalRequests.pb.h"
+
+TEST(ServerAdmissionController, tryAdmitConnection_AdmitsUpToLimit) {
+    ipcourier::_detail::ServerAdmissionController controller({.max_connections = 2});
+
+    ASSERT_TRUE(controller.tryAdmitConnection());
+    ASSERT_TRUE(controller.tryAdmitConnection());
+    ASSERT_FALSE(controller.tryAdmitConnection());
+    ASSERT_EQ(controller.getConnectionCount(), 2);
+
+    controller.releaseConnection();
+    ASSERT_TRUE(controller.tryAdmitConnection());
+}
+
+TEST(ServerAdmissionController, tryAdmitConnection_UnlimitedWhenLimitIsZero) {
+    ipcourier::_detail::ServerAdmissionController controller({});
+
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(controller.tryAdmitConnection());
+    }
+    ASSERT_EQ(controller.getConnectionCount(), 1000);
+}
+
+TEST(ServerAdmissionController, tryAdmitRequest_RejectsAboveInFlightLimit) {
+    ipcourier::_detail::ServerAdmissionController controller({.max_in_flight_requests = 1});
+
+    ASSERT_TRUE(controller.tryAdmitRequest(10));
+    ASSERT_FALSE(controller.tryAdmitRequest(10));
+    ASSERT_EQ(controller.getInFlightRequestCount(), 1);
+    ASSERT_EQ(controller.getQueuedBytes(), 10);
+
+    controller.releaseRequest(10);
+    ASSERT_TRUE(controller.tryAdmitRequest(10));
+}
+
+TEST(ServerAdmissionController, tryAdmitRequest_RejectsAboveQueuedBytesLimit) {
+    ipcourier::_detail::ServerAdmissionController controller({.max_queued_bytes = 100});
+
+    ASSERT_TRUE(controller.tryAdmitRequest(60));
+    ASSERT_FALSE(controller.tryAdmitRequest(60));
+    ASSERT_EQ(controller.getInFlightRequestCount(), 1);
+    ASSERT_EQ(controller.getQueuedBytes(), 60);
+
+    ASSERT_TRUE(controller.tryAdmitRequest(40));
+    ASSERT_EQ(controller.getQueuedBytes(), 100);
+}
+
+TEST(ServerAdmissionController, tryAdmitRequest_AdmitsOversizedRequestWhenNothingIsQueued) {
+    ipcourier::_detail::ServerAdmissionController controller({.max_queued_bytes = 100});
+
+    ASSERT_TRUE(controller.tryAdmitRequest(500));
+    ASSERT_FALSE(controller.tryAdmitRequest(1));
+
+    controller.releaseRequest(500);
+    ASSERT_EQ(controller.getQueuedBytes(), 0);
+    ASSERT_EQ(controller.getInFlightRequestCount(), 0);
+}
+
+TEST(ServerAdmissionController, getOverloadedResponse_ContainsServerOverloadedError) {
+    const ipcourier::_detail::ServerAdmissionController controller({});
+
+    using ErrorResponse = ipcourier::internal_request_proto::IPCInternal_ErrorResponse;
+    const auto result = ipcourier::_detail::makeProtoFromPayload<ErrorResponse>(controller.getOverloadedResponse());
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(static_cast<ipcourier::SyncServerError>(result->error_type()),
+              ipcourier::SyncServerError::ServerOverloaded);
+}
@@ -0,0 +1,110 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "TestServer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <InterProcessCourier/ShardedSyncClient.hpp>
+#include <InterProcessCourier/ShardedSyncServer.hpp>
+#include <gtest/gtest.h>
+
+#include "ProtoForTests.pb.h"
+
+using ipcourier::ShardedSyncClient;
+using ipcourier::ShardedSyncServer;
+using ipcourier::SyncClientError;
+using ipcourier::test::makeSocketPath;
+using HelloWorld = ipcourier::test_proto::HelloWorld;
+
+namespace {
+std::vector<std::string> makeShardSocketPaths(const std::string& name, const std::size_t shard_count) {
+    std::vector<std::string> socket_paths;
+    for (std::size_t i = 0; i < shard_count; ++i) {
+        socket_paths.push_back(makeSocketPath(std::format("{}-{}", name, i)));
+    }
+    return socket_paths;
+}
+
+// Every shard answers with its own index, the server keeps running until the test binary exits
+void runShardedServer(const std::vector<std::string>& socket_paths) {
+    auto& server = *new ShardedSyncServer(socket_paths, {});
+    server.forEachShard([](ipcourier::SyncServer& shard, const std::size_t shard_index) {
+        shard.registerHandler<HelloWorld, HelloWorld>([shard_index](const HelloWorld& request) {
+            auto response = request;
+            response.set_integer(static_cast<std::int32_t>(shard_index));
+            return response;
+        });
+    });
+    std::thread([&server] { static_cast<void>(server.start()); }).detach();
+}
+
+HelloWorld makeHelloWorld(const std::string& message) {
+    HelloWorld hello;
+    hello.set_message(message);
+    return hello;
+}
+}  // namespace
+
+TEST(ShardedSyncClient, sendRequest_RoutesEveryKeyToItsShard) {
+    const auto socket_paths = makeShardSocketPaths("sharded-routing", 3);
+    runShardedServer(socket_paths);
+
+    ShardedSyncClient client(socket_paths, {});
+    ASSERT_TRUE(client.connect().has_value());
+    client.registerShardKey<HelloWorld>([](const HelloWorld& request) { return request.message(); });
+
+    std::set<std::int32_t> used_shards;
+    for (int i = 0; i < 32; ++i) {
+        const auto key = std::format("key {}", i);
+        const auto expected_shard = static_cast<std::int32_t>(client.getShardIndex(key));
+
+        // The same key keeps going to the same shard
+        for (int repeat = 0; repeat < 2; ++repeat) {
+            const auto response = client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld(key));
+            ASSERT_TRUE(response.has_value()) << response.error().message;
+            ASSERT_EQ(response->integer(), expected_shard) << key;
+        }
+        used_shards.insert(expected_shard);
+    }
+
+    ASSERT_EQ(used_shards.size(), 3);
+}
+
+TEST(ShardedSyncClient, sendRequest_ReturnsShardKeyNotRegistered_WithoutKeyExtractor) {
+    const auto socket_paths = makeShardSocketPaths("sharded-unregistered", 2);
+    runShardedServer(socket_paths);
+
+    ShardedSyncClient client(socket_paths, {});
+    ASSERT_TRUE(client.connect().has_value());
+
+    const auto response = client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld("key"));
+    ASSERT_FALSE(response.has_value());
+    ASSERT_EQ(response.error().type, SyncClientError::ShardKeyNotRegistered);
+
+    const auto posted = client.post(makeHelloWorld("key"));
+    ASSERT_FALSE(posted.has_value());
+    ASSERT_EQ(posted.error().type, SyncClientError::ShardKeyNotRegistered);
+}
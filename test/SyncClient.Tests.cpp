@@ -0,0 +1,164 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "TestServer.hpp"
+#include "UnixDomainProtocol.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <InterProcessCourier/SyncClient.hpp>
+#include <InterProcessCourier/SyncServer.hpp>
+#include <gtest/gtest.h>
+
+#include "ProtoForTests.pb.h"
+
+using ipcourier::SyncClient;
+using ipcourier::SyncClientOptions;
+using ipcourier::SyncServer;
+using ipcourier::SyncServerOptions;
+using ipcourier::Transport;
+using ipcourier::test::makeSocketPath;
+using ipcourier::test::runServer;
+using HelloWorld = ipcourier::test_proto::HelloWorld;
+
+namespace {
+struct Tick {
+    static constexpr std::string_view courier_type_name = "test.Tick";
+
+    std::uint64_t sequence;
+};
+
+// Long enough that no test reaches the end of a cork window by waiting
+constexpr auto k_endless_cork_window = std::chrono::hours(1);
+
+// Time given to a held back post to arrive, were it sent
+constexpr auto k_arrival_time = std::chrono::milliseconds(50);
+
+// Serves HelloWorld requests and records the sequence numbers of posted ticks in their order of arrival
+class TickServer {
+public:
+    TickServer(const std::string& socket_path, const Transport transport) {
+        SyncServerOptions options;
+        options.transport = transport;
+        auto server = std::make_unique<SyncServer>(socket_path, options);
+        server->registerHandler<HelloWorld, HelloWorld>([](const HelloWorld& request) { return request; });
+        server->registerHandler<Tick>([this](const Tick& tick) {
+            const std::lock_guard lock(m_mutex);
+            m_sequences.push_back(tick.sequence);
+            m_received.notify_all();
+        });
+        runServer(std::move(server));
+    }
+
+    // Returns early once `count` ticks arrived
+    std::vector<std::uint64_t> waitForTicks(const std::size_t count,
+                                            const std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+        std::unique_lock lock(m_mutex);
+        m_received.wait_for(lock, timeout, [this, count] { return m_sequences.size() >= count; });
+        return m_sequences;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_received;
+    std::vector<std::uint64_t> m_sequences;
+};
+
+SyncClientOptions makeCorkingOptions(const Transport transport = Transport::Stream) {
+    SyncClientOptions options;
+    options.transport = transport;
+    options.cork_window = k_endless_cork_window;
+    return options;
+}
+
+std::size_t getTickFrameSize() {
+    return ipcourier::_detail::k_frame_header_size + ipcourier::_detail::makePayloadFromMessage(Tick{}).size();
+}
+}  // namespace
+
+TEST(SyncClient, corkedPost_LeavesWithNextRequest) {
+    const auto socket_path = makeSocketPath("sync-client-cork-request");
+    // Leaked with the server it records for
+    auto& server = *new TickServer(socket_path, Transport::Stream);
+
+    SyncClient client(socket_path, makeCorkingOptions());
+    ASSERT_TRUE(client.connect().has_value());
+    ASSERT_TRUE(client.post(Tick{.sequence = 1}).has_value());
+    ASSERT_TRUE(server.waitForTicks(1, k_arrival_time).empty());
+
+    const auto response = client.sendRequest<HelloWorld, HelloWorld>(HelloWorld{});
+    ASSERT_TRUE(response.has_value()) << response.error().message;
+    ASSERT_EQ(server.waitForTicks(1), std::vector<std::uint64_t>{1});
+}
+
+TEST(SyncClient, corkedPost_LeavesOnFlush) {
+    const auto socket_path = makeSocketPath("sync-client-cork-flush");
+    auto& server = *new TickServer(socket_path, Transport::Stream);
+
+    SyncClient client(socket_path, makeCorkingOptions());
+    ASSERT_TRUE(client.connect().has_value());
+    ASSERT_TRUE(client.post(Tick{.sequence = 1}).has_value());
+    ASSERT_TRUE(client.post(Tick{.sequence = 2}).has_value());
+    ASSERT_TRUE(server.waitForTicks(1, k_arrival_time).empty());
+
+    ASSERT_TRUE(client.flush().has_value());
+    ASSERT_EQ(server.waitForTicks(2), (std::vector<std::uint64_t>{1, 2}));
+}
+
+TEST(SyncClient, corkedPost_LeavesAtByteThreshold) {
+    const auto socket_path = makeSocketPath("sync-client-cork-bytes");
+    auto& server = *new TickServer(socket_path, Transport::Stream);
+
+    auto options = makeCorkingOptions();
+    options.cork_max_bytes = 3 * getTickFrameSize();
+    SyncClient client(socket_path, options);
+    ASSERT_TRUE(client.connect().has_value());
+    ASSERT_TRUE(client.post(Tick{.sequence = 1}).has_value());
+    ASSERT_TRUE(client.post(Tick{.sequence = 2}).has_value());
+    ASSERT_TRUE(server.waitForTicks(1, k_arrival_time).empty());
+
+    ASSERT_TRUE(client.post(Tick{.sequence = 3}).has_value());
+    ASSERT_EQ(server.waitForTicks(3), (std::vector<std::uint64_t>{1, 2, 3}));
+}
+
+TEST(SyncClient, corkedSeqPacketBurst_ArrivesCompleteAndInOrder) {
+    const auto socket_path = makeSocketPath("sync-client-cork-seqpacket");
+    auto& server = *new TickServer(socket_path, Transport::SeqPacket);
+
+    // More records than one sendmmsg call takes
+    constexpr std::uint64_t k_burst_size = 150;
+    SyncClient client(socket_path, makeCorkingOptions(Transport::SeqPacket));
+    ASSERT_TRUE(client.connect().has_value());
+
+    std::vector<std::uint64_t> expected;
+    for (std::uint64_t sequence = 0; sequence < k_burst_size; ++sequence) {
+        ASSERT_TRUE(client.post(Tick{.sequence = sequence}).has_value());
+        expected.push_back(sequence);
+    }
+    ASSERT_TRUE(client.flush().has_value());
+
+    ASSERT_EQ(server.waitForTicks(k_burst_size), expected);
+}
@@ -0,0 +1,916 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "TestServer.hpp"
+#include "UnixDomainProtocol.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <InterProcessCourier/SyncClient.hpp>
+#include <InterProcessCourier/SyncServer.hpp>
+#include <gtest/gtest.h>
+
+#include "InternalRequests.pb.h"
+#include "ProtoForTests.pb.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using ipcourier::SyncClient;
+using ipcourier::SyncClientOptions;
+using ipcourier::SyncServer;
+using ipcourier::SyncServerOptions;
+using ipcourier::test::makeSocketPath;
+using ipcourier::test::runServer;
+using HelloWorld = ipcourier::test_proto::HelloWorld;
+
+namespace {
+// Speaks the frame protocol directly, so the test decides when the server's writes are read
+class RawConnection {
+public:
+    explicit RawConnection(const std::string& socket_path) : m_fd(socket(AF_UNIX, SOCK_STREAM, 0)) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+
+        // ServerBackend::IoUring only listens once the server runs
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!(m_connected = connect(m_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0) &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        // A server that stopped answering fails the test instead of hanging it
+        const timeval receive_timeout{.tv_sec = 10, .tv_usec = 0};
+        setsockopt(m_fd, SOL_SOCKET, SO_RCVTIMEO, &receive_timeout, sizeof(receive_timeout));
+    }
+
+    RawConnection(const RawConnection&) = delete;
+
+    RawConnection& operator=(const RawConnection&) = delete;
+
+    ~RawConnection() {
+        close(m_fd);
+    }
+
+    bool isConnected() const {
+        return m_connected;
+    }
+
+    bool sendFrame(ipcourier::_detail::FrameHeader header, const std::string_view payload) {
+        header.payload_length = static_cast<std::uint32_t>(payload.size());
+        std::string frame(ipcourier::_detail::k_frame_header_size, '\0');
+        ipcourier::_detail::encodeFrameHeader(header, frame.data());
+        frame.append(payload);
+        return send(m_fd, frame.data(), frame.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(frame.size());
+    }
+
+    // Announces a payload that never follows
+    bool sendHeader(const ipcourier::_detail::FrameHeader& header) {
+        char encoded[ipcourier::_detail::k_frame_header_size];
+        ipcourier::_detail::encodeFrameHeader(header, encoded);
+        return send(m_fd, encoded, sizeof(encoded), MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(encoded));
+    }
+
+    std::optional<ipcourier::_detail::FrameHeader> receiveHeader() {
+        char header[ipcourier::_detail::k_frame_header_size];
+        if (recv(m_fd, header, sizeof(header), MSG_WAITALL) != static_cast<ssize_t>(sizeof(header))) {
+            return std::nullopt;
+        }
+
+        return ipcourier::_detail::decodeFrameHeader(header);
+    }
+
+    void shutdownWrite() {
+        shutdown(m_fd, SHUT_WR);
+    }
+
+    bool skip(std::size_t size) {
+        char buffer[4096];
+        while (size > 0) {
+            const auto received = recv(m_fd, buffer, std::min(size, sizeof(buffer)), 0);
+            if (received <= 0) {
+                return false;
+            }
+            size -= static_cast<std::size_t>(received);
+        }
+
+        return true;
+    }
+
+    // Bytes received until the server closed the connection, a reset counts as closing as well
+    std::size_t readUntilClosed() {
+        std::size_t total = 0;
+        char buffer[4096];
+        ssize_t received = 0;
+        while ((received = recv(m_fd, buffer, sizeof(buffer), 0)) > 0) {
+            total += static_cast<std::size_t>(received);
+        }
+
+        return total;
+    }
+
+private:
+    int m_fd;
+    bool m_connected = false;
+};
+
+HelloWorld makeHelloWorld(const std::string& message) {
+    HelloWorld hello_world;
+    hello_world.set_message(message);
+    return hello_world;
+}
+
+// A connection only sends its next request once the previous one is answered, so queued requests need one each
+class ConnectionPool {
+public:
+    // Connected up front, the hello of a later connect would queue behind the requests under test
+    ConnectionPool(const std::string& socket_path, const std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i) {
+            auto& client = m_clients.emplace_back(std::make_unique<SyncClient>(socket_path, SyncClientOptions{}));
+            m_connected = m_connected && client->connect().has_value();
+        }
+    }
+
+    bool isConnected() const {
+        return m_connected;
+    }
+
+    // Sends on the next unused connection, the pool has to outlive the returned future
+    std::future<ipcourier::SyncClientResult<HelloWorld> > sendAsync(const std::string& message,
+                                                                    const ipcourier::RequestOptions& options = {}) {
+        auto& client = *m_clients.at(m_next_client++);
+        return std::async(std::launch::async, [&client, message, options] {
+            return client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld(message), options);
+        });
+    }
+
+private:
+    std::vector<std::unique_ptr<SyncClient> > m_clients;
+    std::size_t m_next_client = 0;
+    bool m_connected = true;
+};
+
+// Holds requests whose message is "block" in their handler until released
+class BlockingHandler {
+public:
+    explicit BlockingHandler(SyncServer& server) {
+        server.registerHandler<HelloWorld, HelloWorld>(
+            [this, released = m_released.get_future().share()](const HelloWorld& request) {
+                if (request.message() == "block") {
+                    m_blocked.fetch_add(1);
+                    released.wait();
+                }
+                {
+                    const std::lock_guard lock(m_mutex);
+                    m_served.push_back(request.message());
+                }
+                return request;
+            });
+    }
+
+    int getBlockedCount() const {
+        return m_blocked.load();
+    }
+
+    void release() {
+        m_released.set_value();
+    }
+
+    std::vector<std::string> getServed() {
+        const std::lock_guard lock(m_mutex);
+        return m_served;
+    }
+
+private:
+    std::promise<void> m_released;
+    std::atomic<int> m_blocked = 0;
+    std::mutex m_mutex;
+    std::vector<std::string> m_served;
+};
+}  // namespace
+
+TEST(SyncServer, disconnectedSubscriber_ReleasesAdmissionOfQueuedResponse) {
+    const auto socket_path = makeSocketPath("sync-server-subscriber");
+
+    SyncServerOptions options;
+    options.handler_threads = 1;
+    options.admission_limits.max_in_flight_requests = 1;
+    options.subscriptions.max_queued_events = 2;
+    options.subscriptions.slow_subscriber_policy = ipcourier::SlowSubscriberPolicy::Disconnect;
+    auto owned_server = std::make_unique<SyncServer>(socket_path, options);
+
+    std::promise<void> handler_entered;
+    std::promise<void> handler_released;
+    auto released = handler_released.get_future().share();
+    owned_server->registerHandler<HelloWorld, HelloWorld>([&handler_entered, released](const HelloWorld& request) {
+        if (request.message() == "slow") {
+            handler_entered.set_value();
+            released.wait();
+        }
+        return request;
+    });
+    auto& server = runServer(std::move(owned_server));
+
+    // The subscriber never reads its events, so the response to its request queues up behind them
+    RawConnection subscriber(socket_path);
+    ASSERT_TRUE(subscriber.isConnected());
+    ipcourier::_detail::FrameHeader subscribe;
+    subscribe.flags = ipcourier::_detail::k_frame_flag_subscribe;
+    subscribe.request_id = 1;
+    ASSERT_TRUE(subscriber.sendFrame(subscribe, "ipcourier.test_proto.HelloWorld"));
+    ASSERT_TRUE(subscriber.receiveHeader().has_value());
+
+    ipcourier::_detail::FrameHeader request;
+    request.request_id = 2;
+    ASSERT_TRUE(subscriber.sendFrame(request, ipcourier::_detail::makePayloadFromMessage(makeHelloWorld("slow"))));
+    handler_entered.get_future().wait();
+
+    // More than the socket buffer holds, the first event stays in flight and the second one waits
+    const auto event = makeHelloWorld(std::string(1024 * 1024, 'e'));
+    server.publish(event);
+    server.publish(event);
+    handler_released.set_value();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // Queued behind the response, the last one exceeds the limit and disconnects the subscriber
+    server.publish(event);
+    server.publish(event);
+
+    SyncClient client(socket_path, {});
+    ASSERT_TRUE(client.connect().has_value());
+    const auto response = client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld("after"));
+    ASSERT_TRUE(response.has_value()) << response.error().message;
+    ASSERT_EQ(response->message(), "after");
+}
+
+TEST(SyncServer, reflectedMappings_LeaveOutTheHello) {
+    using MappingReflectionRequest =
+        ipcourier::internal_request_proto::IPCInternal_GetRequestResponseMappingPairsRequest;
+    using MappingReflectionResponse =
+        ipcourier::internal_request_proto::IPCInternal_GetRequestResponseMappingPairsResponse;
+
+    const auto socket_path = makeSocketPath("sync-server-mappings");
+    auto owned_server = std::make_unique<SyncServer>(socket_path, SyncServerOptions{});
+    owned_server->registerHandler<HelloWorld, HelloWorld>([](const HelloWorld& request) { return request; });
+    runServer(std::move(owned_server));
+
+    ipcourier::SyncClientOptions options;
+    options.validate_req_res_pair_strategy = ipcourier::ValidateRequestResponsePairStrategy::NoValidation;
+    SyncClient client(socket_path, options);
+    ASSERT_TRUE(client.connect().has_value());
+
+    const auto mappings = client.sendRequest<MappingReflectionRequest, MappingReflectionResponse>({});
+    ASSERT_TRUE(mappings.has_value()) << mappings.error().message;
+    ASSERT_TRUE(mappings->mappings().contains("ipcourier.test_proto.HelloWorld"));
+    ASSERT_FALSE(mappings->mappings().contains("ipcourier.internal.Hello"));
+}
+
+TEST(SyncServer, connect_ExchangesHelloOnlyInPlaceOfReflection) {
+    const auto socket_path = makeSocketPath("sync-server-hello");
+    auto owned_server = std::make_unique<SyncServer>(socket_path, SyncServerOptions{});
+    owned_server->registerHandler<HelloWorld, HelloWorld>([](const HelloWorld& request) { return request; });
+    runServer(std::move(owned_server));
+
+    ipcourier::SyncClientOptions manual_options;
+    manual_options.validate_req_res_pair_strategy = ipcourier::ValidateRequestResponsePairStrategy::ManualRegistration;
+    SyncClient manual_client(socket_path, manual_options);
+    ASSERT_TRUE(manual_client.connect().has_value());
+    ASSERT_FALSE(manual_client.getConnectionCapabilities().has_value());
+
+    SyncClient reflecting_client(socket_path, {});
+    ASSERT_TRUE(reflecting_client.connect().has_value());
+    ASSERT_TRUE(reflecting_client.getConnectionCapabilities().has_value());
+
+    const auto response = reflecting_client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld("reflected"));
+    ASSERT_TRUE(response.has_value()) << response.error().message;
+    ASSERT_EQ(response->message(), "reflected");
+}
+
+TEST(SyncServer, seqPacketRequest_IsAnswered) {
+    const auto socket_path = makeSocketPath("sync-server-seqpacket");
+    SyncServerOptions options;
+    options.transport = ipcourier::Transport::SeqPacket;
+    auto owned_server = std::make_unique<SyncServer>(socket_path, options);
+    owned_server->registerHandler<HelloWorld, HelloWorld>([](const HelloWorld& request) { return request; });
+    runServer(std::move(owned_server));
+
+    ipcourier::SyncClientOptions client_options;
+    client_options.transport = ipcourier::Transport::SeqPacket;
+    SyncClient client(socket_path, client_options);
+    ASSERT_TRUE(client.connect().has_value());
+
+    // Close to the record limit, so the whole frame has to travel as one record
+    const auto large_message = std::string(ipcourier::_detail::k_max_seqpacket_frame_size / 2, 'l');
+    for (const auto& message : {std::string("small"), large_message}) {
+        const auto response = client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld(message));
+        ASSERT_TRUE(response.has_value()) << response.error().message;
+        ASSERT_EQ(response->message(), message);
+    }
+}
+
+TEST(SyncServer, oversizedSeqPacketRecord_IsRejectedAndConnectionKept) {
+    const auto socket_path = makeSocketPath("sync-server-seqpacket-oversized");
+    SyncServerOptions options;
+    options.transport = ipcourier::Transport::SeqPacket;
+    options.max_request_size = 1024;
+    auto owned_server = std::make_unique<SyncServer>(socket_path, options);
+    owned_server->registerHandler<HelloWorld, HelloWorld>([](const HelloWorld& request) { return request; });
+    runServer(std::move(owned_server));
+
+    ipcourier::SyncClientOptions client_options;
+    client_options.transport = ipcourier::Transport::SeqPacket;
+    client_options.validate_req_res_pair_strategy = ipcourier::ValidateRequestResponsePairStrategy::NoValidation;
+    SyncClient client(socket_path, client_options);
+    ASSERT_TRUE(client.connect().has_value());
+
+    const auto rejected = client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld(std::string(4096, 'o')));
+    ASSERT_FALSE(rejected.has_value());
+    ASSERT_EQ(rejected.error().type, ipcourier::SyncClientError::MessageTooLarge);
+
+    // Records are delimited by the kernel, the server reads on after the oversized one
+    const auto response = client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld("after"));
+    ASSERT_TRUE(response.has_value()) << response.error().message;
+    ASSERT_EQ(response->message(), "after");
+}
+
+TEST(SyncServer, seqPacketClient_RejectsFrameAboveRecordLimit) {
+    const auto socket_path = makeSocketPath("sync-server-seqpacket-limit");
+    SyncServerOptions options;
+    options.transport = ipcourier::Transport::SeqPacket;
+    auto owned_server = std::make_unique<SyncServer>(socket_path, options);
+    owned_server->registerHandler<HelloWorld, HelloWorld>([](const HelloWorld& request) { return request; });
+    runServer(std::move(owned_server));
+
+    ipcourier::SyncClientOptions client_options;
+    client_options.transport = ipcourier::Transport::SeqPacket;
+    SyncClient client(socket_path, client_options);
+    ASSERT_TRUE(client.connect().has_value());
+
+    const auto message = std::string(ipcourier::_detail::k_max_seqpacket_frame_size, 'o');
+    const auto rejected = client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld(message));
+    ASSERT_FALSE(rejected.has_value());
+    ASSERT_EQ(rejected.error().type, ipcourier::SyncClientError::MessageTooLarge);
+
+    const auto response = client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld("after"));
+    ASSERT_TRUE(response.has_value()) << response.error().message;
+}
+
+TEST(SyncServer, oversizedFrame_IsAnsweredUnlessOneWay) {
+    for (const auto backend : {ipcourier::ServerBackend::Asio, ipcourier::ServerBackend::IoUring}) {
+        const auto socket_path = makeSocketPath(std::format("sync-server-oversized-{}", static_cast<int>(backend)));
+        SyncServerOptions options;
+        options.backend = backend;
+        options.max_request_size = 1024;
+        auto owned_server = std::make_unique<SyncServer>(socket_path, options);
+        owned_server->registerHandler<HelloWorld, HelloWorld>([](const HelloWorld& request) { return request; });
+        runServer(std::move(owned_server));
+
+        const std::string oversized_payload(4096, 'o');
+
+        RawConnection requester(socket_path);
+        ASSERT_TRUE(requester.isConnected());
+        ipcourier::_detail::FrameHeader request;
+        request.request_id = 1;
+        ASSERT_TRUE(requester.sendFrame(request, oversized_payload));
+        const auto answer = requester.receiveHeader();
+        ASSERT_TRUE(answer.has_value());
+        ASSERT_EQ(answer->request_id, 1);
+        ASSERT_EQ(requester.readUntilClosed(), answer->payload_length);
+
+        // Closed without writing anything back
+        RawConnection poster(socket_path);
+        ASSERT_TRUE(poster.isConnected());
+        ipcourier::_detail::FrameHeader one_way;
+        one_way.flags = ipcourier::_detail::k_frame_flag_one_way;
+        one_way.request_id = 2;
+        ASSERT_TRUE(poster.sendFrame(one_way, oversized_payload));
+        ASSERT_EQ(poster.readUntilClosed(), 0);
+    }
+}
+
+TEST(SyncServer, oversizedFrame_IsAnsweredAfterResponseStillBeingWritten) {
+    for (const auto backend : {ipcourier::ServerBackend::Asio, ipcourier::ServerBackend::IoUring}) {
+        const auto socket_path =
+            makeSocketPath(std::format("sync-server-oversized-pipelined-{}", static_cast<int>(backend)));
+        SyncServerOptions options;
+        options.backend = backend;
+        options.max_request_size = 8 * 1024 * 1024;
+        auto owned_server = std::make_unique<SyncServer>(socket_path, options);
+        owned_server->registerHandler<HelloWorld, HelloWorld>([](const HelloWorld& request) { return request; });
+        runServer(std::move(owned_server));
+
+        // The echo is far larger than the socket buffer, so its write is still in flight while nothing is read
+        RawConnection connection(socket_path);
+        ASSERT_TRUE(connection.isConnected());
+        ipcourier::_detail::FrameHeader request;
+        request.request_id = 1;
+        const auto large_request =
+            ipcourier::_detail::makePayloadFromMessage(makeHelloWorld(std::string(4 * 1024 * 1024, 'l')));
+        ASSERT_TRUE(connection.sendFrame(request, large_request));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        ipcourier::_detail::FrameHeader oversized;
+        oversized.request_id = 2;
+        oversized.payload_length = 16 * 1024 * 1024;
+        ASSERT_TRUE(connection.sendHeader(oversized));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        const auto response = connection.receiveHeader();
+        ASSERT_TRUE(response.has_value());
+        ASSERT_EQ(response->request_id, 1);
+        ASSERT_TRUE(connection.skip(response->payload_length));
+
+        const auto answer = connection.receiveHeader();
+        ASSERT_TRUE(answer.has_value());
+        ASSERT_EQ(answer->request_id, 2);
+        ASSERT_EQ(connection.readUntilClosed(), answer->payload_length);
+    }
+}
+
+TEST(SyncServer, halfClosedConnection_IsAnsweredBeforeClosing) {
+    for (const auto backend : {ipcourier::ServerBackend::Asio, ipcourier::ServerBackend::IoUring}) {
+        const auto socket_path = makeSocketPath(std::format("sync-server-half-closed-{}", static_cast<int>(backend)));
+        SyncServerOptions options;
+        options.backend = backend;
+        options.handler_threads = 1;
+        auto owned_server = std::make_unique<SyncServer>(socket_path, options);
+        owned_server->registerHandler<HelloWorld, HelloWorld>([](const HelloWorld& request) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            return request;
+        });
+        runServer(std::move(owned_server));
+
+        // The handler is still running when the server reads the end of the stream
+        RawConnection connection(socket_path);
+        ASSERT_TRUE(connection.isConnected());
+        ipcourier::_detail::FrameHeader request;
+        request.request_id = 1;
+        ASSERT_TRUE(connection.sendFrame(request, ipcourier::_detail::makePayloadFromMessage(makeHelloWorld("late"))));
+        connection.shutdownWrite();
+
+        const auto response = connection.receiveHeader();
+        ASSERT_TRUE(response.has_value());
+        ASSERT_EQ(response->request_id, 1);
+        ASSERT_EQ(connection.readUntilClosed(), response->payload_length);
+    }
+}
+
+TEST(SyncServer, handlerThrowingNonStandardException_IsAnsweredWithError) {
+    for (const std::size_t handler_threads : {0, 1}) {
+        const auto socket_path = makeSocketPath(std::format("sync-server-throw-{}", handler_threads));
+        SyncServerOptions options;
+        options.handler_threads = handler_threads;
+        auto owned_server = std::make_unique<SyncServer>(socket_path, options);
+        owned_server->registerHandler<HelloWorld, HelloWorld>([](const HelloWorld& request) {
+            if (request.message() == "throw") {
+                throw 42;
+            }
+            return request;
+        });
+        runServer(std::move(owned_server));
+
+        SyncClient client(socket_path, {});
+        ASSERT_TRUE(client.connect().has_value());
+
+        const auto failed = client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld("throw"));
+        ASSERT_FALSE(failed.has_value());
+        ASSERT_EQ(failed.error().type, ipcourier::SyncClientError::HandlerFailed);
+
+        const auto response = client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld("after"));
+        ASSERT_TRUE(response.has_value()) << response.error().message;
+        ASSERT_EQ(response->message(), "after");
+    }
+}
+
+TEST(SyncServer, expiredRequestsQueuedBehindSaturatedHandlers_DoNotStallLiveOnes) {
+    const auto socket_path = makeSocketPath("sync-server-expired-queue");
+    SyncServerOptions options;
+    options.handler_threads = 1;
+    auto owned_server = std::make_unique<SyncServer>(socket_path, options);
+    // Leaked with the server its handler belongs to
+    auto& handler = *new BlockingHandler(*owned_server);
+    runServer(std::move(owned_server));
+
+    ConnectionPool connections(socket_path, 8);
+    ASSERT_TRUE(connections.isConnected());
+
+    // One blocked handler runs and one waits in the executor, which saturates the single handler thread
+    auto running = connections.sendAsync("block");
+    while (handler.getBlockedCount() == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto dispatched = connections.sendAsync("block");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    ipcourier::RequestOptions short_deadline;
+    short_deadline.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+    std::vector<std::future<ipcourier::SyncClientResult<HelloWorld> > > expiring;
+    for (int i = 0; i < 3; ++i) {
+        expiring.push_back(connections.sendAsync(std::format("expiring {}", i), short_deadline));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // Bounded as well, so a stalled queue fails the test instead of hanging it
+    ipcourier::RequestOptions long_deadline;
+    long_deadline.deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    std::vector<std::future<ipcourier::SyncClientResult<HelloWorld> > > live;
+    for (int i = 0; i < 3; ++i) {
+        live.push_back(connections.sendAsync(std::format("live {}", i), long_deadline));
+    }
+
+    for (auto& request : expiring) {
+        const auto result = request.get();
+        ASSERT_FALSE(result.has_value());
+        ASSERT_EQ(result.error().type, ipcourier::SyncClientError::DeadlineExceeded);
+    }
+    handler.release();
+
+    for (auto& request : live) {
+        const auto result = request.get();
+        ASSERT_TRUE(result.has_value()) << result.error().message;
+    }
+    ASSERT_TRUE(running.get().has_value());
+    ASSERT_TRUE(dispatched.get().has_value());
+    for (const auto& served : handler.getServed()) {
+        ASSERT_FALSE(served.starts_with("expiring"));
+    }
+}
+
+TEST(SyncServer, publishedEvent_IsDispatchedToEverySubscriber) {
+    for (const auto backend : {ipcourier::ServerBackend::Asio, ipcourier::ServerBackend::IoUring}) {
+        const auto socket_path = makeSocketPath(std::format("sync-server-events-{}", static_cast<int>(backend)));
+        SyncServerOptions options;
+        options.backend = backend;
+        auto& server = runServer(std::make_unique<SyncServer>(socket_path, options));
+        // Waits until the server listens
+        ASSERT_TRUE(RawConnection(socket_path).isConnected());
+
+        // The event is framed once and the same frame is queued for every subscriber
+        std::vector<std::unique_ptr<SyncClient> > subscribers;
+        std::vector<std::vector<std::string> > received(3);
+        for (auto& messages : received) {
+            subscribers.push_back(std::make_unique<SyncClient>(socket_path, SyncClientOptions{}));
+            auto& subscriber = *subscribers.back();
+            ASSERT_TRUE(subscriber.connect().has_value());
+            ASSERT_TRUE(subscriber
+                            .subscribe<HelloWorld>(
+                                [&messages](const HelloWorld& event) { messages.push_back(event.message()); })
+                            .has_value());
+        }
+
+        server.publish(makeHelloWorld("news"));
+
+        for (std::size_t i = 0; i < subscribers.size(); ++i) {
+            const auto dispatched =
+                subscribers[i]->dispatchEvents(std::chrono::steady_clock::now() + std::chrono::seconds(5));
+            ASSERT_TRUE(dispatched.has_value());
+            ASSERT_EQ(dispatched.value(), 1);
+            ASSERT_EQ(received[i], std::vector<std::string>{"news"});
+        }
+    }
+}
+
+TEST(SyncServer, unsubscribedClient_NoLongerReceivesEvents) {
+    for (const auto backend : {ipcourier::ServerBackend::Asio, ipcourier::ServerBackend::IoUring}) {
+        const auto socket_path = makeSocketPath(std::format("sync-server-unsubscribe-{}", static_cast<int>(backend)));
+        SyncServerOptions options;
+        options.backend = backend;
+        auto& server = runServer(std::make_unique<SyncServer>(socket_path, options));
+        // Waits until the server listens
+        ASSERT_TRUE(RawConnection(socket_path).isConnected());
+
+        std::size_t kept_events = 0;
+        SyncClient kept(socket_path, {});
+        ASSERT_TRUE(kept.connect().has_value());
+        ASSERT_TRUE(kept.subscribe<HelloWorld>([&kept_events](const HelloWorld&) { ++kept_events; }).has_value());
+
+        std::size_t dropped_events = 0;
+        SyncClient dropped(socket_path, {});
+        ASSERT_TRUE(dropped.connect().has_value());
+        ASSERT_TRUE(
+            dropped.subscribe<HelloWorld>([&dropped_events](const HelloWorld&) { ++dropped_events; }).has_value());
+        ASSERT_TRUE(dropped.unsubscribe<HelloWorld>().has_value());
+
+        server.publish(makeHelloWorld("news"));
+
+        // Once the remaining subscriber has the event, it would have been written to the other one as well
+        const auto kept_dispatched = kept.dispatchEvents(std::chrono::steady_clock::now() + std::chrono::seconds(5));
+        ASSERT_TRUE(kept_dispatched.has_value());
+        ASSERT_EQ(kept_dispatched.value(), 1);
+        ASSERT_EQ(kept_events, 1);
+
+        const auto dropped_dispatched =
+            dropped.dispatchEvents(std::chrono::steady_clock::now() + std::chrono::milliseconds(100));
+        ASSERT_TRUE(dropped_dispatched.has_value());
+        ASSERT_EQ(dropped_dispatched.value(), 0);
+        ASSERT_EQ(dropped_events, 0);
+    }
+}
+
+TEST(SyncServer, deferredHandler_RespondsAfterReturning) {
+    for (const auto backend : {ipcourier::ServerBackend::Asio, ipcourier::ServerBackend::IoUring}) {
+        const auto socket_path = makeSocketPath(std::format("sync-server-deferred-{}", static_cast<int>(backend)));
+        SyncServerOptions options;
+        options.backend = backend;
+        auto owned_server = std::make_unique<SyncServer>(socket_path, options);
+
+        // Held responders outlive the test, the server keeps running until the test binary exits
+        auto* held_mutex = new std::mutex;
+        auto* held = new std::vector<ipcourier::Responder<HelloWorld> >;
+        owned_server->registerHandler<HelloWorld, HelloWorld>(
+            [held_mutex, held](const HelloWorld& request, ipcourier::Responder<HelloWorld> responder) {
+                if (request.message() == "hold") {
+                    std::lock_guard lock(*held_mutex);
+                    held->push_back(std::move(responder));
+                } else if (request.message() != "drop") {
+                    responder.respond(request);
+                }
+            });
+        runServer(std::move(owned_server));
+        ASSERT_TRUE(RawConnection(socket_path).isConnected());
+
+        ConnectionPool connections(socket_path, 3);
+        ASSERT_TRUE(connections.isConnected());
+        auto holding = connections.sendAsync("hold");
+        const auto is_held = [held_mutex, held] {
+            std::lock_guard lock(*held_mutex);
+            return !held->empty();
+        };
+        while (!is_held()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        // The server goes on serving while the held request waits for its response
+        const auto immediate = connections.sendAsync("now").get();
+        ASSERT_TRUE(immediate.has_value()) << immediate.error().message;
+        ASSERT_EQ(immediate->message(), "now");
+
+        // Whichever thread calls respond completes the request
+        std::thread([held_mutex, held] {
+            std::lock_guard lock(*held_mutex);
+            held->front().respond(makeHelloWorld("held"));
+        }).join();
+        const auto held_response = holding.get();
+        ASSERT_TRUE(held_response.has_value()) << held_response.error().message;
+        ASSERT_EQ(held_response->message(), "held");
+
+        // A responder destroyed without responding answers with an error
+        const auto dropped = connections.sendAsync("drop").get();
+        ASSERT_FALSE(dropped.has_value());
+        ASSERT_EQ(dropped.error().type, ipcourier::SyncClientError::HandlerFailed);
+    }
+}
+
+TEST(SyncServer, coroutineHandler_RespondsWithReturnedValue) {
+    // Resumes the coroutine on another thread, like the completion of an asynchronous operation would
+    struct ResumeOnOtherThread {
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        void await_suspend(const std::coroutine_handle<> handle) const {
+            std::thread([handle] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                handle.resume();
+            }).detach();
+        }
+
+        void await_resume() const noexcept {
+        }
+    };
+
+    for (const auto backend : {ipcourier::ServerBackend::Asio, ipcourier::ServerBackend::IoUring}) {
+        const auto socket_path = makeSocketPath(std::format("sync-server-coroutine-{}", static_cast<int>(backend)));
+        SyncServerOptions options;
+        options.backend = backend;
+        auto owned_server = std::make_unique<SyncServer>(socket_path, options);
+        owned_server->registerHandler<HelloWorld, HelloWorld>(
+            [](const HelloWorld& request) -> ipcourier::Task<HelloWorld> {
+                // The request is only valid until the first suspension
+                auto response = request;
+                co_await ResumeOnOtherThread{};
+                if (response.message() == "throw") {
+                    throw std::runtime_error("Failed after resuming");
+                }
+                response.set_integer(response.integer() + 1);
+                co_return response;
+            });
+        runServer(std::move(owned_server));
+
+        SyncClient client(socket_path, {});
+        ASSERT_TRUE(RawConnection(socket_path).isConnected());
+        ASSERT_TRUE(client.connect().has_value());
+
+        auto request = makeHelloWorld("resumed");
+        request.set_integer(41);
+        const auto response = client.sendRequest<HelloWorld, HelloWorld>(request);
+        ASSERT_TRUE(response.has_value()) << response.error().message;
+        ASSERT_EQ(response->message(), "resumed");
+        ASSERT_EQ(response->integer(), 42);
+
+        const auto failed = client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld("throw"));
+        ASSERT_FALSE(failed.has_value());
+        ASSERT_EQ(failed.error().type, ipcourier::SyncClientError::HandlerFailed);
+    }
+}
+
+TEST(SyncServer, expiredRequest_IsDroppedWithoutCallingHandler) {
+    for (const auto backend : {ipcourier::ServerBackend::Asio, ipcourier::ServerBackend::IoUring}) {
+        const auto socket_path = makeSocketPath(std::format("sync-server-expired-{}", static_cast<int>(backend)));
+        SyncServerOptions options;
+        options.backend = backend;
+        auto owned_server = std::make_unique<SyncServer>(socket_path, options);
+        // Leaked with the server its handler belongs to
+        auto& handler = *new BlockingHandler(*owned_server);
+        runServer(std::move(owned_server));
+
+        // Nothing is written back for the expired frame, the next response belongs to the live one
+        RawConnection connection(socket_path);
+        ASSERT_TRUE(connection.isConnected());
+        ipcourier::_detail::FrameHeader expired;
+        expired.request_id = 1;
+        expired.deadline_ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        ASSERT_TRUE(
+            connection.sendFrame(expired, ipcourier::_detail::makePayloadFromMessage(makeHelloWorld("expired"))));
+        ipcourier::_detail::FrameHeader live;
+        live.request_id = 2;
+        ASSERT_TRUE(connection.sendFrame(live, ipcourier::_detail::makePayloadFromMessage(makeHelloWorld("live"))));
+
+        const auto response = connection.receiveHeader();
+        ASSERT_TRUE(response.has_value());
+        ASSERT_EQ(response->request_id, 2);
+
+        SyncClient client(socket_path, {});
+        ASSERT_TRUE(client.connect().has_value());
+        ipcourier::RequestOptions passed_deadline;
+        passed_deadline.deadline = std::chrono::steady_clock::now();
+        const auto result = client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld("expired"), passed_deadline);
+        ASSERT_FALSE(result.has_value());
+        ASSERT_EQ(result.error().type, ipcourier::SyncClientError::DeadlineExceeded);
+
+        const auto after = client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld("after"));
+        ASSERT_TRUE(after.has_value()) << after.error().message;
+        ASSERT_EQ(handler.getServed(), (std::vector<std::string>{"live", "after"}));
+    }
+}
+
+TEST(SyncServer, queuedHighPriorityRequests_AreServedBeforeLowPriorityOnes) {
+    for (const auto backend : {ipcourier::ServerBackend::Asio, ipcourier::ServerBackend::IoUring}) {
+        const auto socket_path = makeSocketPath(std::format("sync-server-priority-{}", static_cast<int>(backend)));
+        SyncServerOptions options;
+        options.backend = backend;
+        options.handler_threads = 1;
+        auto owned_server = std::make_unique<SyncServer>(socket_path, options);
+        // Leaked with the server its handler belongs to
+        auto& handler = *new BlockingHandler(*owned_server);
+        runServer(std::move(owned_server));
+        ASSERT_TRUE(RawConnection(socket_path).isConnected());
+
+        ConnectionPool connections(socket_path, 6);
+        ASSERT_TRUE(connections.isConnected());
+
+        // One blocked handler runs and one waits in the executor, the requests sent afterwards stay queued
+        auto running = connections.sendAsync("block");
+        while (handler.getBlockedCount() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        auto dispatched = connections.sendAsync("block");
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        ipcourier::RequestOptions low;
+        low.priority = ipcourier::RequestPriority::Low;
+        ipcourier::RequestOptions high;
+        high.priority = ipcourier::RequestPriority::High;
+        std::vector<std::future<ipcourier::SyncClientResult<HelloWorld> > > queued;
+        queued.push_back(connections.sendAsync("low 0", low));
+        queued.push_back(connections.sendAsync("low 1", low));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queued.push_back(connections.sendAsync("high 0", high));
+        queued.push_back(connections.sendAsync("high 1", high));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        handler.release();
+        ASSERT_TRUE(running.get().has_value());
+        ASSERT_TRUE(dispatched.get().has_value());
+        for (auto& request : queued) {
+            const auto result = request.get();
+            ASSERT_TRUE(result.has_value()) << result.error().message;
+        }
+
+        const auto served = handler.getServed();
+        ASSERT_EQ(served.size(), 6);
+        for (std::size_t i = 2; i < 4; ++i) {
+            ASSERT_TRUE(served[i].starts_with("high")) << served[i];
+        }
+    }
+}
+
+TEST(SyncServer, cachedHandler_IsNotCalledForRepeatedRequest) {
+    const auto socket_path = makeSocketPath("sync-server-cached");
+    auto owned_server = std::make_unique<SyncServer>(socket_path, SyncServerOptions{});
+    // Leaked with the server its handler belongs to
+    auto& calls = *new std::atomic<int>(0);
+    owned_server->registerCachedHandler<HelloWorld, HelloWorld>(
+        [&calls](const HelloWorld& request) {
+            calls.fetch_add(1);
+            auto response = request;
+            response.set_integer(static_cast<std::int32_t>(request.message().size()));
+            return response;
+        },
+        ipcourier::ResponseCacheOptions{});
+    runServer(std::move(owned_server));
+
+    SyncClient client(socket_path, {});
+    ASSERT_TRUE(client.connect().has_value());
+
+    for (const auto* message : {"cached", "cached", "other", "cached", "other"}) {
+        const auto response = client.sendRequest<HelloWorld, HelloWorld>(makeHelloWorld(message));
+        ASSERT_TRUE(response.has_value()) << response.error().message;
+        ASSERT_EQ(response->message(), message);
+        ASSERT_EQ(response->integer(), static_cast<std::int32_t>(std::string_view(message).size()));
+    }
+
+    ASSERT_EQ(calls.load(), 2);
+}
+
+TEST(SyncServer, pipelinedRequestsBeyondInputLimit_AreAllAnswered) {
+    for (const auto backend : {ipcourier::ServerBackend::Asio, ipcourier::ServerBackend::IoUring}) {
+        const auto socket_path = makeSocketPath(std::format("sync-server-input-limit-{}", static_cast<int>(backend)));
+        SyncServerOptions options;
+        options.backend = backend;
+        options.handler_threads = 1;
+        options.max_request_size = 1024;
+        auto owned_server = std::make_unique<SyncServer>(socket_path, options);
+        // Leaked with the server its handler belongs to
+        auto& handler = *new BlockingHandler(*owned_server);
+        runServer(std::move(owned_server));
+
+        RawConnection connection(socket_path);
+        ASSERT_TRUE(connection.isConnected());
+        constexpr std::uint64_t k_request_count = 50;
+        const auto send_requests = [&connection](const std::uint64_t first_id, const std::uint64_t last_id) {
+            for (auto request_id = first_id; request_id <= last_id; ++request_id) {
+                ipcourier::_detail::FrameHeader request;
+                request.request_id = request_id;
+                const auto message = request_id == 1 ? std::string("block") : std::string(900, 'p');
+                const auto payload = ipcourier::_detail::makePayloadFromMessage(makeHelloWorld(message));
+                ASSERT_TRUE(connection.sendFrame(request, payload));
+            }
+        };
+
+        // The requests behind the blocked one exceed what the server buffers per connection, so the later ones
+        // are only read once the earlier ones are answered
+        send_requests(1, k_request_count / 2);
+        while (handler.getBlockedCount() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        send_requests(k_request_count / 2 + 1, k_request_count);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        handler.release();
+
+        std::vector<bool> answered(k_request_count + 1, false);
+        for (std::uint64_t i = 0; i < k_request_count; ++i) {
+            const auto response = connection.receiveHeader();
+            ASSERT_TRUE(response.has_value());
+            ASSERT_LE(response->request_id, k_request_count);
+            answered[response->request_id] = true;
+            ASSERT_TRUE(connection.skip(response->payload_length));
+        }
+        ASSERT_EQ(std::count(answered.begin() + 1, answered.end(), true), k_request_count);
+    }
+}
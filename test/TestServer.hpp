@@ -0,0 +1,52 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef INTER_PROCESS_COURIER_TEST_TESTSERVER_HPP
+#define INTER_PROCESS_COURIER_TEST_TESTSERVER_HPP
+
+#include <format>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <InterProcessCourier/SyncServer.hpp>
+
+#include <unistd.h>
+
+namespace ipcourier::test {
+// Unique per test process, a file left behind by an earlier run is removed
+inline std::string makeSocketPath(const std::string_view name) {
+    auto path = std::format("/tmp/ipcourier-{}-test-{}.sock", name, getpid());
+    unlink(path.c_str());
+    return path;
+}
+
+/*
+ * Serves on a detached thread. A SyncServer cannot be stopped, so it keeps running until the test binary exits and
+ * its socket path must not be reused by another test. The socket is bound on construction, clients may connect
+ * right away.
+ */
+inline SyncServer& runServer(std::unique_ptr<SyncServer> server) {
+    auto& running = *server.release();
+    std::thread([&running] { static_cast<void>(running.start()); }).detach();
+    return running;
+}
+}  // namespace ipcourier::test
+
+#endif  // INTER_PROCESS_COURIER_TEST_TESTSERVER_HPP
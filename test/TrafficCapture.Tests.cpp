@@ -0,0 +1,132 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "TestServer.hpp"
+#include "TrafficCaptureWriter.hpp"
+
+#include <format>
+#include <fstream>
+#include <string>
+
+#include <InterProcessCourier/ShardedSyncServer.hpp>
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+using ipcourier::RequestPriority;
+using ipcourier::TrafficCaptureError;
+using ipcourier::TrafficCaptureOptions;
+using ipcourier::TrafficCaptureReader;
+using ipcourier::test::makeSocketPath;
+using ipcourier::_detail::FrameHeader;
+using ipcourier::_detail::TrafficCaptureWriter;
+
+namespace {
+class TrafficCaptureTest : public ::testing::Test {
+protected:
+    std::string capture_path = std::format("/tmp/ipcourier-capture-test-{}.cap", getpid());
+
+    void TearDown() override {
+        unlink(capture_path.c_str());
+    }
+
+    TrafficCaptureOptions makeOptions(const std::size_t max_bytes) const {
+        TrafficCaptureOptions options;
+        options.path = capture_path;
+        options.max_bytes = max_bytes;
+        return options;
+    }
+};
+}  // namespace
+
+TEST_F(TrafficCaptureTest, Reader_ReturnsCapturedRequestsInOrder) {
+    {
+        auto writer = TrafficCaptureWriter::open(makeOptions(4096));
+        ASSERT_TRUE(writer.has_value()) << writer.error().message;
+
+        FrameHeader header;
+        header.request_id = 1;
+        writer.value()->capture(7, header, "test.Request:abc");
+
+        header.flags = ipcourier::_detail::k_frame_flag_one_way;
+        header.priority = ipcourier::_detail::encodeRequestPriority(RequestPriority::High);
+        writer.value()->capture(8, header, "test.OneWay:");
+
+        ASSERT_EQ(writer.value()->getStatistics().captured_requests, 2);
+    }
+
+    auto reader = TrafficCaptureReader::open(capture_path);
+    ASSERT_TRUE(reader.has_value()) << reader.error().message;
+
+    const auto first = reader->next();
+    ASSERT_TRUE(first.has_value());
+    ASSERT_EQ(first->connection_id, 7);
+    ASSERT_EQ(first->payload, "test.Request:abc");
+    ASSERT_FALSE(first->one_way);
+    ASSERT_FALSE(first->priority.has_value());
+
+    const auto second = reader->next();
+    ASSERT_TRUE(second.has_value());
+    ASSERT_EQ(second->connection_id, 8);
+    ASSERT_EQ(second->payload, "test.OneWay:");
+    ASSERT_TRUE(second->one_way);
+    ASSERT_EQ(second->priority, RequestPriority::High);
+    ASSERT_GE(second->timestamp, first->timestamp);
+
+    ASSERT_FALSE(reader->next().has_value());
+}
+
+TEST_F(TrafficCaptureTest, capture_DropsRequests_WhenFileIsFull) {
+    auto writer = TrafficCaptureWriter::open(makeOptions(128));
+    ASSERT_TRUE(writer.has_value()) << writer.error().message;
+
+    writer.value()->capture(1, FrameHeader{}, std::string(32, 'x'));
+    writer.value()->capture(1, FrameHeader{}, std::string(64, 'x'));
+
+    const auto statistics = writer.value()->getStatistics();
+    ASSERT_EQ(statistics.captured_requests, 1);
+    ASSERT_EQ(statistics.dropped_requests, 1);
+}
+
+TEST_F(TrafficCaptureTest, Reader_ReturnsInvalidFileFormat_ForOtherFiles) {
+    std::ofstream(capture_path) << std::string(64, 'x');
+
+    const auto reader = TrafficCaptureReader::open(capture_path);
+
+    ASSERT_FALSE(reader.has_value());
+    ASSERT_EQ(reader.error().type, TrafficCaptureError::InvalidFileFormat);
+}
+
+TEST_F(TrafficCaptureTest, ShardedSyncServer_CapturesEveryShardToItsOwnFile) {
+    ipcourier::SyncServerOptions options;
+    options.traffic_capture = makeOptions(4096);
+
+    {
+        const ipcourier::ShardedSyncServer server(
+            {makeSocketPath("capture-shard-0"), makeSocketPath("capture-shard-1")}, options);
+
+        for (const auto* suffix : {".0", ".1"}) {
+            const auto shard_capture_path = capture_path + suffix;
+            ASSERT_TRUE(TrafficCaptureReader::open(shard_capture_path).has_value()) << shard_capture_path;
+        }
+        ASSERT_FALSE(TrafficCaptureReader::open(capture_path).has_value());
+    }
+
+    unlink((capture_path + ".0").c_str());
+    unlink((capture_path + ".1").c_str());
+}
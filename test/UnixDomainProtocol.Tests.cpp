@@ -0,0 +1,79 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "UnixDomainProtocol.hpp"
+
+#include <array>
+
+#include <gtest/gtest.h>
+
+TEST(UnixDomainProtocol, FrameHeader_EncodeDecodeRoundtrip) {
+    const ipcourier::_detail::FrameHeader header{.payload_length = 42, .request_id = 7, .deadline_ns = 123456789};
+
+    std::array<char, ipcourier::_detail::k_frame_header_size> encoded{};
+    ipcourier::_detail::encodeFrameHeader(header, encoded.data());
+    const auto decoded = ipcourier::_detail::decodeFrameHeader(encoded.data());
+
+    ASSERT_EQ(decoded.payload_length, 42);
+    ASSERT_EQ(decoded.request_id, 7);
+    ASSERT_EQ(decoded.deadline_ns, 123456789);
+}
+
+TEST(UnixDomainProtocol, toDeadlineNs_MaxMeansNoDeadline) {
+    ASSERT_EQ(ipcourier::_detail::toDeadlineNs(std::chrono::steady_clock::time_point::max()),
+              ipcourier::_detail::k_no_deadline);
+}
+
+TEST(UnixDomainProtocol, isDeadlineExpired_ComparesAgainstNow) {
+    const auto now = std::chrono::steady_clock::now();
+
+    const ipcourier::_detail::FrameHeader past{.deadline_ns =
+                                                   ipcourier::_detail::toDeadlineNs(now - std::chrono::seconds(1))};
+    const ipcourier::_detail::FrameHeader future{.deadline_ns =
+                                                     ipcourier::_detail::toDeadlineNs(now + std::chrono::seconds(1))};
+
+    ASSERT_TRUE(ipcourier::_detail::isDeadlineExpired(past, now));
+    ASSERT_FALSE(ipcourier::_detail::isDeadlineExpired(future, now));
+}
+
+TEST(UnixDomainProtocol, isDeadlineExpired_NeverForNoDeadline) {
+    const ipcourier::_detail::FrameHeader header{};
+
+    ASSERT_FALSE(ipcourier::_detail::isDeadlineExpired(header, std::chrono::steady_clock::time_point::max()));
+}
+
+TEST(UnixDomainProtocol, RequestPriority_EncodeDecodeRoundtrip) {
+    using ipcourier::RequestPriority;
+
+    for (const auto priority : {RequestPriority::Low, RequestPriority::Normal, RequestPriority::High}) {
+        const auto encoded = ipcourier::_detail::encodeRequestPriority(priority);
+        ASSERT_NE(encoded, ipcourier::_detail::k_unspecified_priority);
+        ASSERT_EQ(ipcourier::_detail::decodeRequestPriority(encoded), priority);
+    }
+
+    ASSERT_EQ(ipcourier::_detail::encodeRequestPriority(std::nullopt), ipcourier::_detail::k_unspecified_priority);
+    ASSERT_FALSE(ipcourier::_detail::decodeRequestPriority(ipcourier::_detail::k_unspecified_priority).has_value());
+    ASSERT_FALSE(ipcourier::_detail::decodeRequestPriority(200).has_value());
+}
+
+TEST(UnixDomainProtocol, isOneWay_ChecksFlag) {
+    const ipcourier::_detail::FrameHeader request{};
+    const ipcourier::_detail::FrameHeader one_way{.flags = ipcourier::_detail::k_frame_flag_one_way};
+
+    ASSERT_FALSE(ipcourier::_detail::isOneWay(request));
+    ASSERT_TRUE(ipcourier::_detail::isOneWay(one_way));
+}
@@ -0,0 +1,145 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "UnixDomainServerBackend.hpp"
+
+#include <deque>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "InternalRequests.pb.h"
+
+using ipcourier::SlowSubscriberPolicy;
+using ipcourier::SubscriptionOptions;
+
+namespace {
+struct PendingWrite {
+    std::string response;
+    ipcourier::_detail::SharedPublishedEvent event;
+};
+
+PendingWrite makeResponse(std::string response) {
+    return PendingWrite{.response = std::move(response), .event = nullptr};
+}
+}  // namespace
+
+TEST(UnixDomainServerBackend, makePublishedEvent_FramesPayloadAsEvent) {
+    const auto event = ipcourier::_detail::makePublishedEvent("topic", "payload");
+
+    ASSERT_EQ(event->topic, "topic");
+    ASSERT_EQ(event->frame.size(), ipcourier::_detail::k_frame_header_size + 7);
+
+    const auto header = ipcourier::_detail::decodeFrameHeader(event->frame.data());
+    ASSERT_EQ(header.payload_length, 7);
+    ASSERT_EQ(header.request_id, ipcourier::_detail::k_connection_request_id);
+    ASSERT_TRUE(ipcourier::_detail::hasFrameFlag(header, ipcourier::_detail::k_frame_flag_event));
+    ASSERT_EQ(event->frame.substr(ipcourier::_detail::k_frame_header_size), "payload");
+}
+
+TEST(UnixDomainServerBackend, makeErrorResponse_EncodesErrorTypeAndMessage) {
+    const auto payload =
+        ipcourier::_detail::makeErrorResponse(ipcourier::SyncServerError::HandlerNotRegistered, "No handler");
+
+    const auto error_response =
+        ipcourier::_detail::makeProtoFromPayload<ipcourier::internal_request_proto::IPCInternal_ErrorResponse>(payload);
+    ASSERT_TRUE(error_response.has_value());
+    ASSERT_EQ(error_response->error_type(),
+              static_cast<std::int32_t>(ipcourier::SyncServerError::HandlerNotRegistered));
+    ASSERT_EQ(error_response->message(), "No handler");
+}
+
+TEST(UnixDomainServerBackend, queueEventForSubscriber_AppendsBelowLimit) {
+    std::deque<PendingWrite> pending_writes;
+    pending_writes.push_back(makeResponse("response"));
+
+    const auto event = ipcourier::_detail::makePublishedEvent("a", "1");
+    ASSERT_TRUE(ipcourier::_detail::queueEventForSubscriber(pending_writes, event, SubscriptionOptions{}));
+
+    ASSERT_EQ(pending_writes.size(), 2);
+    ASSERT_EQ(pending_writes.back().event, event);
+}
+
+TEST(UnixDomainServerBackend, queueEventForSubscriber_SharesFrameBetweenSubscribers) {
+    std::deque<PendingWrite> first_subscriber;
+    std::deque<PendingWrite> second_subscriber;
+
+    const auto event = ipcourier::_detail::makePublishedEvent("a", "1");
+    ASSERT_TRUE(ipcourier::_detail::queueEventForSubscriber(first_subscriber, event, SubscriptionOptions{}));
+    ASSERT_TRUE(ipcourier::_detail::queueEventForSubscriber(second_subscriber, event, SubscriptionOptions{}));
+
+    ASSERT_EQ(&first_subscriber.front().event->frame, &second_subscriber.front().event->frame);
+    ASSERT_EQ(event.use_count(), 3);
+}
+
+TEST(UnixDomainServerBackend, queueEventForSubscriber_ConflatesOldestEventOfSameTopic) {
+    const SubscriptionOptions options{.max_queued_events = 2,
+                                      .slow_subscriber_policy = SlowSubscriberPolicy::ConflateEvents};
+    std::deque<PendingWrite> pending_writes;
+
+    const auto first_a = ipcourier::_detail::makePublishedEvent("a", "1");
+    const auto first_b = ipcourier::_detail::makePublishedEvent("b", "1");
+    const auto second_b = ipcourier::_detail::makePublishedEvent("b", "2");
+    ASSERT_TRUE(ipcourier::_detail::queueEventForSubscriber(pending_writes, first_a, options));
+    pending_writes.push_back(makeResponse("response"));
+    ASSERT_TRUE(ipcourier::_detail::queueEventForSubscriber(pending_writes, first_b, options));
+    ASSERT_TRUE(ipcourier::_detail::queueEventForSubscriber(pending_writes, second_b, options));
+
+    ASSERT_EQ(pending_writes.size(), 3);
+    ASSERT_EQ(pending_writes[0].event, first_a);
+    ASSERT_EQ(pending_writes[1].response, "response");
+    ASSERT_EQ(pending_writes[2].event, second_b);
+}
+
+TEST(UnixDomainServerBackend, queueEventForSubscriber_ConflatesOldestEventOfOtherTopic) {
+    const SubscriptionOptions options{.max_queued_events = 1,
+                                      .slow_subscriber_policy = SlowSubscriberPolicy::ConflateEvents};
+    std::deque<PendingWrite> pending_writes;
+
+    const auto event_a = ipcourier::_detail::makePublishedEvent("a", "1");
+    const auto event_b = ipcourier::_detail::makePublishedEvent("b", "1");
+    ASSERT_TRUE(ipcourier::_detail::queueEventForSubscriber(pending_writes, event_a, options));
+    ASSERT_TRUE(ipcourier::_detail::queueEventForSubscriber(pending_writes, event_b, options));
+
+    ASSERT_EQ(pending_writes.size(), 1);
+    ASSERT_EQ(pending_writes.front().event, event_b);
+}
+
+TEST(UnixDomainServerBackend, queueEventForSubscriber_DisconnectsSlowSubscriber) {
+    const SubscriptionOptions options{.max_queued_events = 1,
+                                      .slow_subscriber_policy = SlowSubscriberPolicy::Disconnect};
+    std::deque<PendingWrite> pending_writes;
+
+    ASSERT_TRUE(ipcourier::_detail::queueEventForSubscriber(
+        pending_writes, ipcourier::_detail::makePublishedEvent("a", "1"), options));
+    ASSERT_FALSE(ipcourier::_detail::queueEventForSubscriber(
+        pending_writes, ipcourier::_detail::makePublishedEvent("a", "2"), options));
+    ASSERT_EQ(pending_writes.size(), 1);
+}
+
+TEST(UnixDomainServerBackend, queueEventForSubscriber_ZeroLimitIsUnbounded) {
+    const SubscriptionOptions options{.max_queued_events = 0,
+                                      .slow_subscriber_policy = SlowSubscriberPolicy::Disconnect};
+    std::deque<PendingWrite> pending_writes;
+
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(ipcourier::_detail::queueEventForSubscriber(
+            pending_writes, ipcourier::_detail::makePublishedEvent("a", "1"), options));
+    }
+    ASSERT_EQ(pending_writes.size(), 1000);
+}
@@ -0,0 +1,116 @@
+/***************************************************************************
+ *  InterProcessCourier Copyright (C) 2025  Ziperix                        *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "WorkStealingExecutor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(WorkStealingExecutor, submit_RunsAllTasks) {
+    std::atomic<int> completed_tasks = 0;
+    {
+        ipcourier::_detail::WorkStealingExecutor executor(4);
+        ASSERT_EQ(executor.getWorkerCount(), 4);
+
+        for (int i = 0; i < 1000; ++i) {
+            executor.submit([&completed_tasks] { ++completed_tasks; });
+        }
+    }
+
+    ASSERT_EQ(completed_tasks, 1000);
+}
+
+TEST(WorkStealingExecutor, submit_RunsTasksSubmittedByTasks) {
+    std::atomic<int> completed_tasks = 0;
+    {
+        ipcourier::_detail::WorkStealingExecutor executor(2);
+        for (int i = 0; i < 10; ++i) {
+            executor.submit([&executor, &completed_tasks] {
+                for (int j = 0; j < 10; ++j) {
+                    executor.submit([&completed_tasks] { ++completed_tasks; });
+                }
+            });
+        }
+    }
+
+    ASSERT_EQ(completed_tasks, 100);
+}
+
+TEST(WorkStealingExecutor, submit_BlockedWorkerDoesNotHoldUpQueuedTasks) {
+    ipcourier::_detail::WorkStealingExecutor executor(2);
+
+    std::promise<void> release_blocker;
+    auto blocker_released = release_blocker.get_future().share();
+    std::atomic<int> completed_tasks = 0;
+
+    // Round-robin places every other task behind the blocker, the idle worker has to steal them
+    executor.submit([blocker_released] { blocker_released.wait(); });
+    for (int i = 0; i < 9; ++i) {
+        executor.submit([&completed_tasks] { ++completed_tasks; });
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (completed_tasks < 9 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    release_blocker.set_value();
+
+    ASSERT_EQ(completed_tasks, 9);
+}
+
+TEST(WorkStealingExecutor, submit_WakesParkedWorkers) {
+    ipcourier::_detail::WorkStealingExecutor executor(2);
+    std::atomic<int> completed_tasks = 0;
+
+    // Idle long enough for both workers to stop spinning and park
+    for (int i = 1; i <= 3; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        executor.submit([&completed_tasks] { ++completed_tasks; });
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (completed_tasks < i && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        ASSERT_EQ(completed_tasks, i);
+    }
+}
+
+TEST(WorkStealingExecutor, submit_RunsAllTasksSubmittedFromSeveralThreads) {
+    std::atomic<int> completed_tasks = 0;
+    {
+        ipcourier::_detail::WorkStealingExecutor executor(3);
+        std::vector<std::thread> submitters;
+        for (int i = 0; i < 4; ++i) {
+            submitters.emplace_back([&executor, &completed_tasks] {
+                for (int j = 0; j < 1000; ++j) {
+                    executor.submit([&completed_tasks] { ++completed_tasks; });
+                }
+            });
+        }
+        for (auto& submitter : submitters) {
+            submitter.join();
+        }
+    }
+
+    ASSERT_EQ(completed_tasks, 4000);
+}